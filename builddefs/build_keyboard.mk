@@ -567,6 +567,13 @@ top-symbols: build
 	echo "###########################################"
 endif
 
+ifeq ($(strip $(RGB_MATRIX_REPORT)),yes)
+all: rgb-matrix-report
+check-size: rgb-matrix-report
+rgb-matrix-report: build
+	$(QMK_BIN) rgb-matrix-report --nm $(NM) $(BUILD_DIR)/$(TARGET).elf
+endif
+
 include $(BUILDDEFS_PATH)/show_options.mk
 include $(BUILDDEFS_PATH)/common_rules.mk
 
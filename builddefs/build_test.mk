@@ -52,6 +52,9 @@ ifneq ($(strip $(DEBUG)), 0)
 CONSOLE_ENABLE = yes
 endif
 
+# A test.mk can clear this to bring its own main() instead of the googletest one
+TEST_MAIN ?= tests/test_common/main.cpp
+
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include tests/test_common/build.mk
 include $(TEST_PATH)/test.mk
@@ -61,25 +64,56 @@ include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
 include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
+include $(QUANTUM_PATH)/audio/tests/rules.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
+include $(QUANTUM_PATH)/dynamic_keymap_flash/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
 include $(QUANTUM_PATH)/os_detection/tests/rules.mk
+include $(QUANTUM_PATH)/painter/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
+include $(QUANTUM_PATH)/split_common/tests/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
 include $(QUANTUM_PATH)/logging/print.mk
 include $(PLATFORM_PATH)/test/rules.mk
+include $(TMK_PATH)/protocol/tests/rules.mk
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include $(BUILDDEFS_PATH)/build_full_test.mk
 endif
 
 $(TEST_OUTPUT)_SRC += \
-	tests/test_common/main.cpp \
+	$(TEST_MAIN) \
 	$(QUANTUM_PATH)/logging/print.c
 
 ifneq ($(strip $(INTROSPECTION_KEYMAP_C)),)
 $(TEST_OUTPUT)_DEFS += -DINTROSPECTION_KEYMAP_C=\"$(strip $(INTROSPECTION_KEYMAP_C))\"
 endif
 
+# With SHARED_TEST_CORE=yes, everything that isn't specific to the test folder is built once per set of
+# flags and sources, and shared by all tests that have the same ones. The test's config.h only counts
+# through the macros it defines, which the core gets as a generated config.h.
+SHARED_TEST_CORE ?= no
+ifeq ($(strip $(SHARED_TEST_CORE)), yes)
+ifneq ($(filter $(FULL_TESTS),$(TEST)),)
+TEST_LOCAL_SRC := $(filter $(TEST_PATH)/% $(QUANTUM_PATH)/keymap_introspection.c,$($(TEST_OUTPUT)_SRC))
+TEST_CORE_DEFS := $(filter-out -DINTROSPECTION_KEYMAP_C=%,$($(TEST_OUTPUT)_DEFS))
+TEST_CORE_CONFIG := $(TEST_OBJ)/$(TEST_OUTPUT)_config.h
+$(shell mkdir -p $(TEST_OBJ); { gcc -dM -E -x c - </dev/null; gcc -dM -E -x c $(TEST_CORE_DEFS) -I$(TEST_PATH) -Itests/test_common $(patsubst %,-include %,$($(TEST_OUTPUT)_CONFIG)) - </dev/null; } | sort | uniq -u > $(TEST_CORE_CONFIG))
+TEST_CORE_KEY := $(TEST_CORE_DEFS) $(CFLAGS) $(CXXFLAGS) $(filter-out $(TEST_PATH),$($(TEST_OUTPUT)_INC) $(VPATH)) $(filter-out $(TEST_LOCAL_SRC),$($(TEST_OUTPUT)_SRC))
+TEST_CORE := $(TEST_OBJ)/core_$(shell { printf '%s' '$(subst ','\'',$(TEST_CORE_KEY))'; cat $(TEST_CORE_CONFIG); } | cksum | tr ' ' '_')
+TEST_CORE_INCLUDE := $(TEST_CORE)/include
+
+# Only copied when it changed, so that tests sharing the core don't rebuild it
+$(shell mkdir -p $(TEST_CORE_INCLUDE); cmp -s $(TEST_CORE_CONFIG) $(TEST_CORE_INCLUDE)/config.h || cp $(TEST_CORE_CONFIG) $(TEST_CORE_INCLUDE)/config.h)
+
+OUTPUTS += $(TEST_CORE)
+$(TEST_CORE)_SRC := $(filter-out $(TEST_LOCAL_SRC),$($(TEST_OUTPUT)_SRC))
+$(TEST_CORE)_INC := $(patsubst $(TEST_PATH),$(TEST_CORE_INCLUDE),$($(TEST_OUTPUT)_INC) $(VPATH) $(GTEST_INC))
+$(TEST_CORE)_DEFS := $(TEST_CORE_DEFS)
+$(TEST_CORE)_CONFIG := $(TEST_CORE_INCLUDE)/config.h
+$(TEST_OUTPUT)_SRC := $(TEST_LOCAL_SRC)
+endif
+endif
+
 $(TEST_OBJ)/$(TEST_OUTPUT)_SRC := $($(TEST_OUTPUT)_SRC)
 $(TEST_OBJ)/$(TEST_OUTPUT)_INC := $($(TEST_OUTPUT)_INC) $(VPATH) $(GTEST_INC)
 $(TEST_OBJ)/$(TEST_OUTPUT)_DEFS := $($(TEST_OUTPUT)_DEFS)
@@ -26,6 +26,7 @@ QUANTUM_SRC += \
     $(QUANTUM_DIR)/keymap_common.c \
     $(QUANTUM_DIR)/keycode_config.c \
     $(QUANTUM_DIR)/sync_timer.c \
+    $(QUANTUM_DIR)/state_change.c \
     $(QUANTUM_DIR)/logging/debug.c \
     $(QUANTUM_DIR)/logging/sendchar.c \
     $(QUANTUM_DIR)/process_keycode/process_default_layer.c \
@@ -53,6 +54,11 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
         else ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
+            SRC += $(QUANTUM_DIR)/audio/synth.c
+            ifeq ($(strip $(AUDIO_CLIP_ENABLE)), yes)
+                OPT_DEFS += -DAUDIO_CLIP_ENABLE
+                SRC += $(QUANTUM_DIR)/audio/audio_clip.c
+            endif
         ## stm32f2 and above have a usable DAC unit, f1 do not, and need to use pwm instead
         else ifeq ($(strip $(AUDIO_DRIVER)), pwm_software)
             OPT_DEFS += -DAUDIO_DRIVER_PWM
@@ -162,6 +168,10 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
     endif
 endif
 
+ifneq ($(filter yes,$(strip $(MOUSEKEY_ENABLE)) $(strip $(POINTING_DEVICE_ENABLE))),)
+    SRC += $(QUANTUM_DIR)/mouse_motion.c
+endif
+
 QUANTUM_PAINTER_ENABLE ?= no
 ifeq ($(strip $(QUANTUM_PAINTER_ENABLE)), yes)
     include $(QUANTUM_DIR)/painter/rules.mk
@@ -628,6 +638,27 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     TRI_LAYER_ENABLE := yes
 endif
 
+VALID_DYNAMIC_KEYMAP_STORE_TYPES := eeprom custom embedded_flash rp2040_flash
+DYNAMIC_KEYMAP_STORE ?= eeprom
+ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
+  ifeq ($(filter $(DYNAMIC_KEYMAP_STORE),$(VALID_DYNAMIC_KEYMAP_STORE_TYPES)),)
+    $(call CATASTROPHIC_ERROR,Invalid DYNAMIC_KEYMAP_STORE,DYNAMIC_KEYMAP_STORE="$(DYNAMIC_KEYMAP_STORE)" is not a valid dynamic keymap store)
+  else ifneq ($(strip $(DYNAMIC_KEYMAP_STORE)), eeprom)
+    OPT_DEFS += -DDYNAMIC_KEYMAP_FLASH_STORE
+    COMMON_VPATH += $(QUANTUM_DIR)/dynamic_keymap_flash
+    COMMON_VPATH += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/dynamic_keymap_flash
+    SRC += dynamic_keymap_flash.c
+    ifeq ($(strip $(DYNAMIC_KEYMAP_STORE)), embedded_flash)
+      OPT_DEFS += -DHAL_USE_EFL
+      SRC += dynamic_keymap_flash_efl.c
+      POST_CONFIG_H += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/dynamic_keymap_flash/dynamic_keymap_flash_efl_config.h
+    else ifeq ($(strip $(DYNAMIC_KEYMAP_STORE)), rp2040_flash)
+      SRC += dynamic_keymap_flash_rp2040.c
+      POST_CONFIG_H += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/dynamic_keymap_flash/dynamic_keymap_flash_rp2040_config.h
+    endif
+  endif
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -652,6 +683,11 @@ ifneq ($(strip $(DEBOUNCE_TYPE)), custom)
     QUANTUM_SRC += $(QUANTUM_DIR)/debounce/$(strip $(DEBOUNCE_TYPE)).c
 endif
 
+ifeq ($(strip $(MATRIX_SCAN_ASYNC)), yes)
+    OPT_DEFS += -DMATRIX_SCAN_ASYNC
+    QUANTUM_SRC += $(QUANTUM_DIR)/key_event_queue.c
+endif
+
 
 VALID_SERIAL_DRIVER_TYPES := bitbang usart vendor
 
@@ -684,11 +720,24 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
             endif
         endif
 
+        # transport.c rejects them together with the bitbang driver, or with each other
+        ifeq ($(strip $(SERIAL_PROTOCOL_FRAMED)), yes)
+            OPT_DEFS += -DSERIAL_PROTOCOL_FRAMED
+        endif
+        ifeq ($(strip $(SERIAL_USART_STREAMING)), yes)
+            OPT_DEFS += -DSERIAL_USART_STREAMING
+        endif
         OPT_DEFS += -DSERIAL_DRIVER_$(strip $(shell echo $(SERIAL_DRIVER) | tr '[:lower:]' '[:upper:]'))
         ifeq ($(strip $(SERIAL_DRIVER)), bitbang)
             QUANTUM_LIB_SRC += serial.c
         else
             QUANTUM_LIB_SRC += serial_protocol.c
+            ifeq ($(strip $(SERIAL_PROTOCOL_FRAMED)), yes)
+                QUANTUM_LIB_SRC += serial_protocol_framed.c
+            endif
+            ifeq ($(strip $(SERIAL_USART_STREAMING)), yes)
+                QUANTUM_LIB_SRC += serial_stream.c
+            endif
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
         endif
     endif
@@ -896,7 +945,7 @@ endif
 
 ENCODER_ENABLE ?= no
 ENCODER_DRIVER ?= quadrature
-VALID_ENCODER_DRIVER_TYPES := quadrature custom
+VALID_ENCODER_DRIVER_TYPES := quadrature interrupt custom
 ifeq ($(strip $(ENCODER_ENABLE)), yes)
     ifeq ($(filter $(ENCODER_DRIVER),$(VALID_ENCODER_DRIVER_TYPES)),)
         $(call CATASTROPHIC_ERROR,Invalid ENCODER_DRIVER,ENCODER_DRIVER="$(ENCODER_DRIVER)" is not a valid encoder driver)
@@ -38,6 +38,7 @@ GENERIC_FEATURES = \
     KEY_OVERRIDE \
     LAYER_LOCK \
     LEADER \
+    LED_COMPOSITOR \
     MAGIC \
     MOUSEKEY \
     MUSIC \
@@ -7,7 +7,10 @@ BUILD_OPTION_NAMES = \
   NKRO_ENABLE \
   CUSTOM_MATRIX \
   DEBOUNCE_TYPE \
+  MATRIX_SCAN_ASYNC \
   SPLIT_KEYBOARD \
+  SERIAL_PROTOCOL_FRAMED \
+  SERIAL_USART_STREAMING \
   DYNAMIC_KEYMAP_ENABLE \
   USB_HID_ENABLE \
   VIA_ENABLE
@@ -70,6 +73,8 @@ OTHER_OPTION_NAMES = \
   WATCHDOG_ENABLE \
   ERGOINU \
   NO_USB_STARTUP_CHECK \
+  THREADED_TASKS \
+  USB_REPORT_COALESCING \
   DISABLE_PROMICRO_LEDs \
   MITOSIS_DATAGROK_BOTTOMSPACE \
   MITOSIS_DATAGROK_SLOWUART \
@@ -0,0 +1,240 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdint.h>
+#include "encoder.h"
+#include "gpio.h"
+#include "atomic_util.h"
+#include "wait.h"
+
+#ifdef SPLIT_KEYBOARD
+#    include "split_util.h"
+#endif
+
+/* Counts the encoder edges as they happen, instead of sampling the pins
+ * from the main loop. Either an interrupt fires on every edge of the A and
+ * B lines, or on STM32 a timer in encoder mode counts them in hardware.
+ * encoder_driver_task() only turns the pulses counted since the last call
+ * into events, and keeps whatever doesn't fit the event queue for the next
+ * one, so a busy main loop delays detents but never loses them. */
+
+#if !defined(ENCODER_RESOLUTIONS) && !defined(ENCODER_RESOLUTION)
+#    define ENCODER_RESOLUTION 4
+#endif
+
+#ifndef ENCODER_DIRECTION_FLIP
+#    define ENCODER_CLOCKWISE true
+#    define ENCODER_COUNTER_CLOCKWISE false
+#else
+#    define ENCODER_CLOCKWISE false
+#    define ENCODER_COUNTER_CLOCKWISE true
+#endif
+
+#ifdef ENCODER_DEFAULT_POS
+#    error "ENCODER_DEFAULT_POS is not supported by the interrupt encoder driver"
+#endif
+
+#if defined(ENCODER_QUADRATURE_TIMERS) && !defined(PROTOCOL_CHIBIOS)
+#    error "ENCODER_QUADRATURE_TIMERS needs the STM32 timers"
+#endif
+
+#if defined(PROTOCOL_CHIBIOS)
+#    if defined(ENCODER_QUADRATURE_TIMERS) && !HAL_USE_GPT
+#        error "You need to set HAL_USE_GPT to TRUE in your halconf.h, and enable the timers in your mcuconf.h, to use ENCODER_QUADRATURE_TIMERS."
+#    endif
+#    if !defined(ENCODER_QUADRATURE_TIMERS) && !PAL_USE_CALLBACKS
+#        error "You need to set PAL_USE_CALLBACKS to TRUE in your halconf.h to use the interrupt encoder driver."
+#    endif
+#endif
+
+// Alternate function of the pins that connects them to the timer channels
+#ifndef ENCODER_TIMER_PAL_MODE
+#    define ENCODER_TIMER_PAL_MODE 2
+#endif
+
+// Input filter of the timer, 0 to 15, see ICxF in the reference manual
+#ifndef ENCODER_TIMER_FILTER
+#    define ENCODER_TIMER_FILTER 4
+#endif
+
+extern volatile bool isLeftHand;
+
+static pin_t encoders_pad_a[NUM_ENCODERS_MAX_PER_SIDE] = ENCODER_A_PINS;
+static pin_t encoders_pad_b[NUM_ENCODERS_MAX_PER_SIDE] = ENCODER_B_PINS;
+
+#ifdef ENCODER_RESOLUTIONS
+static uint8_t encoder_resolutions[NUM_ENCODERS] = ENCODER_RESOLUTIONS;
+#endif
+
+#ifdef ENCODER_QUADRATURE_TIMERS
+static GPTDriver *const encoder_timers[NUM_ENCODERS_MAX_PER_SIDE] = ENCODER_QUADRATURE_TIMERS;
+static uint16_t         encoder_counts[NUM_ENCODERS_MAX_PER_SIDE];
+#else
+static const int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};
+static uint8_t      encoder_state[NUM_ENCODERS_MAX_PER_SIDE];
+#endif
+
+// Counted by the interrupt, taken by encoder_driver_task()
+static volatile int16_t encoder_pulses[NUM_ENCODERS_MAX_PER_SIDE];
+// Pulses taken that didn't make a whole detent, or didn't fit the queue, yet
+static int16_t encoder_pending[NUM_ENCODERS_MAX_PER_SIDE];
+
+static uint8_t thisCount;
+#ifdef SPLIT_KEYBOARD
+static uint8_t thisHand;
+#endif
+
+__attribute__((weak)) void encoder_wait_pullup_charge(void) {
+    wait_us(100);
+}
+
+void encoder_interrupt_add_pulses(uint8_t index, int16_t pulses) {
+    encoder_pulses[index] += pulses;
+}
+
+#ifndef ENCODER_QUADRATURE_TIMERS
+static uint8_t encoder_interrupt_read_state(uint8_t index) {
+    return (gpio_read_pin(encoders_pad_a[index]) ? 1 : 0) | (gpio_read_pin(encoders_pad_b[index]) ? 2 : 0);
+}
+
+/**
+ * Decodes the edge that just happened on either line of the encoder. The
+ * interrupt is set up here on ChibiOS; on other platforms, enable the pin
+ * change interrupts in `encoder_interrupt_init_kb()` and call this from them.
+ */
+void encoder_interrupt_handle_edge(uint8_t index) {
+    uint8_t state = encoder_interrupt_read_state(index);
+    if ((encoder_state[index] & 0x3) != state) {
+        encoder_state[index] = (encoder_state[index] << 2) | state;
+        encoder_interrupt_add_pulses(index, encoder_LUT[encoder_state[index] & 0xF]);
+    }
+}
+#endif
+
+#if defined(PROTOCOL_CHIBIOS)
+#    ifdef ENCODER_QUADRATURE_TIMERS
+static const GPTConfig encoder_timer_config = {.frequency = 1000000, .callback = NULL, .cr2 = 0, .dier = 0};
+
+static void encoder_interrupt_init_source(uint8_t index) {
+    palSetLineMode(encoders_pad_a[index], PAL_MODE_ALTERNATE(ENCODER_TIMER_PAL_MODE) | PAL_STM32_PUPDR_PULLUP);
+    palSetLineMode(encoders_pad_b[index], PAL_MODE_ALTERNATE(ENCODER_TIMER_PAL_MODE) | PAL_STM32_PUPDR_PULLUP);
+
+    // Enables the clock of the timer, then reconfigures it to count the edges on CH1 and CH2, both ways
+    gptStart(encoder_timers[index], &encoder_timer_config);
+    stm32_tim_t *tim = encoder_timers[index]->tim;
+    tim->CR1         = 0;
+    tim->PSC         = 0;
+    tim->ARR         = 0xFFFF;
+    tim->CCMR1       = STM32_TIM_CCMR1_CC1S(1) | STM32_TIM_CCMR1_IC1F(ENCODER_TIMER_FILTER) | STM32_TIM_CCMR1_CC2S(1) | STM32_TIM_CCMR1_IC2F(ENCODER_TIMER_FILTER);
+    tim->CCER        = 0;
+    tim->SMCR        = STM32_TIM_SMCR_SMS(3);
+    tim->CNT         = 0;
+    tim->CR1         = STM32_TIM_CR1_CEN;
+
+    encoder_counts[index] = 0;
+}
+
+static void encoder_interrupt_read_source(uint8_t index) {
+    uint16_t count = encoder_timers[index]->tim->CNT;
+    encoder_interrupt_add_pulses(index, (int16_t)(count - encoder_counts[index]));
+    encoder_counts[index] = count;
+}
+#    else
+static void encoder_interrupt_callback(void *arg) {
+    chSysLockFromISR();
+    encoder_interrupt_handle_edge((uint8_t)(uintptr_t)arg);
+    chSysUnlockFromISR();
+}
+
+static void encoder_interrupt_init_source(uint8_t index) {
+    gpio_set_pin_input_high(encoders_pad_a[index]);
+    gpio_set_pin_input_high(encoders_pad_b[index]);
+    encoder_wait_pullup_charge();
+    encoder_state[index] = encoder_interrupt_read_state(index);
+
+    palEnableLineEvent(encoders_pad_a[index], PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(encoders_pad_a[index], encoder_interrupt_callback, (void *)(uintptr_t)index);
+    palEnableLineEvent(encoders_pad_b[index], PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(encoders_pad_b[index], encoder_interrupt_callback, (void *)(uintptr_t)index);
+}
+
+static void encoder_interrupt_read_source(uint8_t index) {}
+#    endif
+#else
+static void encoder_interrupt_init_source(uint8_t index) {
+    gpio_set_pin_input_high(encoders_pad_a[index]);
+    gpio_set_pin_input_high(encoders_pad_b[index]);
+    encoder_wait_pullup_charge();
+    encoder_state[index] = encoder_interrupt_read_state(index);
+}
+
+static void encoder_interrupt_read_source(uint8_t index) {}
+#endif
+
+__attribute__((weak)) void encoder_interrupt_init_kb(void) {}
+
+void encoder_driver_init(void) {
+#ifdef SPLIT_KEYBOARD
+    thisHand  = isLeftHand ? 0 : NUM_ENCODERS_LEFT;
+    thisCount = isLeftHand ? NUM_ENCODERS_LEFT : NUM_ENCODERS_RIGHT;
+#else
+    thisCount = NUM_ENCODERS;
+#endif
+
+#if defined(SPLIT_KEYBOARD) && defined(ENCODER_A_PINS_RIGHT) && defined(ENCODER_B_PINS_RIGHT)
+    if (!isLeftHand) {
+        const pin_t encoders_pad_a_right[] = ENCODER_A_PINS_RIGHT;
+        const pin_t encoders_pad_b_right[] = ENCODER_B_PINS_RIGHT;
+        for (uint8_t i = 0; i < thisCount; i++) {
+            encoders_pad_a[i] = encoders_pad_a_right[i];
+            encoders_pad_b[i] = encoders_pad_b_right[i];
+        }
+    }
+#endif
+
+#if defined(SPLIT_KEYBOARD) && defined(ENCODER_RESOLUTIONS)
+#    if defined(ENCODER_RESOLUTIONS_RIGHT)
+    static const uint8_t encoder_resolutions_right[NUM_ENCODERS_RIGHT] = ENCODER_RESOLUTIONS_RIGHT;
+#    else
+    static const uint8_t encoder_resolutions_right[NUM_ENCODERS_RIGHT] = ENCODER_RESOLUTIONS;
+#    endif
+    for (uint8_t i = 0; i < NUM_ENCODERS_RIGHT; i++) {
+        encoder_resolutions[NUM_ENCODERS_LEFT + i] = encoder_resolutions_right[i];
+    }
+#endif
+
+    for (uint8_t i = 0; i < thisCount; i++) {
+        encoder_pulses[i]  = 0;
+        encoder_pending[i] = 0;
+        encoder_interrupt_init_source(i);
+    }
+
+    encoder_interrupt_init_kb();
+}
+
+void encoder_driver_task(void) {
+    for (uint8_t i = 0; i < thisCount; i++) {
+        uint8_t index = i;
+#ifdef SPLIT_KEYBOARD
+        index += thisHand;
+#endif
+#ifdef ENCODER_RESOLUTIONS
+        const int16_t resolution = encoder_resolutions[index];
+#else
+        const int16_t resolution = ENCODER_RESOLUTION;
+#endif
+
+        encoder_interrupt_read_source(i);
+        ATOMIC_BLOCK_FORCEON {
+            encoder_pending[i] += encoder_pulses[i];
+            encoder_pulses[i] = 0;
+        }
+
+        while (encoder_pending[i] >= resolution && encoder_queue_event(index, ENCODER_COUNTER_CLOCKWISE)) {
+            encoder_pending[i] -= resolution;
+        }
+        while (encoder_pending[i] <= -resolution && encoder_queue_event(index, ENCODER_CLOCKWISE)) {
+            encoder_pending[i] += resolution;
+        }
+    }
+}
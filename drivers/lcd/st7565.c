@@ -476,8 +476,10 @@ void st7565_task(void) {
     st7565_task_user();
 #endif
 
+#ifndef THREADED_TASKS
     // Smart render system, no need to check for dirty
     st7565_render();
+#endif
 
     // Display timeout check
 #if ST7565_TIMEOUT > 0
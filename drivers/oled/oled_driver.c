@@ -947,8 +947,10 @@ void oled_task(void) {
     }
 #endif
 
+#ifndef THREADED_TASKS
     // Smart render system, no need to check for dirty
     oled_render();
+#endif
 
     // Display timeout check
 #if OLED_TIMEOUT > 0
@@ -28,6 +28,36 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SERIAL_PROTOCOL_FRAMED
+// runs the transactions in order, in one frame where they fit
+bool soft_serial_transactions(const uint8_t *sstd_indices, uint8_t count);
+#endif
+
+#ifdef SERIAL_USART_STREAMING
+#    include <stddef.h>
+
+#    ifndef SERIAL_STREAM_BUFFER_SIZE
+#        define SERIAL_STREAM_BUFFER_SIZE 256
+#    endif
+
+#    ifndef SERIAL_STREAM_TIMEOUT
+#        define SERIAL_STREAM_TIMEOUT 20
+#    endif
+
+typedef struct {
+    uint32_t frames; // complete frames received
+    uint32_t errors; // frames dropped for a bad length or crc
+    uint32_t lost;   // gaps in the sequence numbers
+} serial_stream_stats_t;
+
+// takes a snapshot if the previous one is out and keeps sending, never blocks
+bool soft_serial_stream_send(const uint8_t *payload, size_t length);
+// takes in what arrived, returns the newest snapshot or NULL if none was completed since the last call
+const uint8_t *soft_serial_stream_receive(size_t *length);
+
+serial_stream_stats_t soft_serial_stream_stats(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
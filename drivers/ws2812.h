@@ -95,3 +95,14 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 void ws2812_flush(void);
 
 void ws2812_rgb_to_rgbw(ws2812_led_t *led);
+
+#ifdef WS2812_DOUBLE_BUFFER
+typedef struct ws2812_stats_t {
+    uint32_t frames;      // frames handed to the peripheral
+    uint32_t skipped;     // queued frames replaced by a newer flush before they went out
+    uint32_t transfer_us; // duration of the last completed transfer
+    uint32_t flush_us;    // time spent in the last ws2812_flush()
+} ws2812_stats_t;
+
+ws2812_stats_t ws2812_get_stats(void);
+#endif
@@ -0,0 +1,181 @@
+"""Functions that turn WAV files into precompressed PCM clips for the audio feature.
+
+The encoders match the decoders in quantum/audio/audio_clip.c.
+"""
+import datetime
+import re
+import wave
+from string import Template
+
+from qmk.painter import command_args_str, render_bytes
+
+ADPCM_STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385,
+    24623, 27086, 29794, 32767
+]
+ADPCM_INDEX_CHANGES = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+# The encodings quantum/audio/audio_clip.h can play
+valid_encodings = {
+    'ulaw': {
+        'encoding': 'AUDIO_CLIP_ULAW',
+        'bits': 8,
+    },
+    'adpcm': {
+        'encoding': 'AUDIO_CLIP_IMA_ADPCM',
+        'bits': 4,
+    },
+}
+
+
+def read_wav(path):
+    """Reads a WAV file, mixed down to mono 16 bit samples.
+
+    Returns the samples and their rate.
+    """
+    with wave.open(str(path), 'rb') as wav:
+        channels = wav.getnchannels()
+        width = wav.getsampwidth()
+        rate = wav.getframerate()
+        frames = wav.readframes(wav.getnframes())
+
+    if width == 1:
+        # 8 bit WAV samples are unsigned
+        values = [(b - 128) << 8 for b in frames]
+    elif width == 2:
+        values = [int.from_bytes(frames[i:i + 2], 'little', signed=True) for i in range(0, len(frames), 2)]
+    else:
+        raise ValueError(f'Only 8 and 16 bit WAV files are supported, got {width * 8} bit')
+
+    samples = [sum(values[i:i + channels]) // channels for i in range(0, len(values), channels)]
+    return samples, rate
+
+
+def resample(samples, rate, new_rate):
+    """Linear interpolation to another sample rate.
+    """
+    if rate == new_rate or not samples:
+        return list(samples)
+
+    count = max(1, len(samples) * new_rate // rate)
+    output = []
+    for i in range(count):
+        position = i * rate / new_rate
+        index = int(position)
+        fraction = position - index
+        following = samples[min(index + 1, len(samples) - 1)]
+        output.append(round(samples[index] + (following - samples[index]) * fraction))
+    return output
+
+
+def encode_ulaw(samples):
+    """G.711 u-law, one byte per sample.
+    """
+    data = bytearray()
+    for sample in samples:
+        sign = 0x80 if sample < 0 else 0
+        magnitude = min(abs(sample), 32635) + 0x84
+        exponent = 7
+        while exponent > 0 and not magnitude & (0x4000 >> (7 - exponent)):
+            exponent -= 1
+        mantissa = (magnitude >> (exponent + 3)) & 0x0F
+        data.append(~(sign | (exponent << 4) | mantissa) & 0xFF)
+    return bytes(data)
+
+
+def encode_adpcm(samples):
+    """IMA ADPCM, two samples per byte with the first one in the low nibble.
+
+    The decoder starts with a predictor and step index of 0.
+    """
+    data = bytearray((len(samples) + 1) // 2)
+    predictor = 0
+    index = 0
+    for n, sample in enumerate(samples):
+        step = ADPCM_STEPS[index]
+        delta = sample - predictor
+        nibble = 8 if delta < 0 else 0
+        difference = step >> 3
+        delta = abs(delta)
+        for bit in (4, 2, 1):
+            if delta >= step:
+                nibble |= bit
+                delta -= step
+                difference += step
+            step >>= 1
+
+        predictor += -difference if nibble & 8 else difference
+        predictor = max(-32768, min(predictor, 32767))
+        index = max(0, min(index + ADPCM_INDEX_CHANGES[nibble & 7], 88))
+        data[n // 2] |= nibble << ((n & 1) * 4)
+    return bytes(data)
+
+
+def encode(samples, encoding):
+    if encoding == 'ulaw':
+        return encode_ulaw(samples)
+    if encoding == 'adpcm':
+        return encode_adpcm(samples)
+    raise ValueError(f'Unknown encoding {encoding}')
+
+
+def generate_subs(cli, out_bytes, *, samples, rate, command_name):
+    return {
+        "year": datetime.date.today().strftime("%Y"),
+        "input_file": cli.args.input.name,
+        "sane_name": re.sub(r"[^a-zA-Z0-9]", "_", cli.args.input.stem),
+        "byte_count": len(out_bytes),
+        "bytes_lines": render_bytes(out_bytes),
+        "samples": samples,
+        "sample_rate": rate,
+        "duration": f"{samples / rate:.3f}",
+        "encoding": valid_encodings[cli.args.encoding]['encoding'],
+        "generator_command": command_name.replace("_", "-"),
+        "command_args": command_args_str(cli, command_name),
+    }
+
+
+license_template = """\
+// Copyright ${year} QMK -- generated source code only, clip retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was auto-generated by `${generator_command}` with arguments:
+${command_args}
+"""
+
+header_file_template = """\
+${license}
+#pragma once
+
+#include "audio.h"
+
+extern const audio_clip_t clip_${sane_name};
+"""
+
+source_file_template = """\
+${license}
+// ${input_file}: ${samples} samples at ${sample_rate}Hz, ${duration}s
+
+#include "audio.h"
+
+// clang-format off
+static const uint8_t clip_${sane_name}_data[${byte_count}] = {
+${bytes_lines}
+};
+// clang-format on
+
+const audio_clip_t clip_${sane_name} = {
+    .data        = clip_${sane_name}_data,
+    .samples     = ${samples},
+    .sample_rate = ${sample_rate},
+    .encoding    = ${encoding},
+};
+"""
+
+
+def render_header(subs):
+    return Template(header_file_template).substitute(subs, license=Template(license_template).substitute(subs))
+
+
+def render_source(subs):
+    return Template(source_file_template).substitute(subs, license=Template(license_template).substitute(subs))
@@ -0,0 +1 @@
+from . import convert_clip
@@ -0,0 +1,60 @@
+"""Converts WAV files into clips for the audio feature.
+"""
+from qmk.path import normpath
+from qmk.audio_clip import encode, generate_subs, read_wav, render_header, render_source, resample, valid_encodings
+from milc import cli
+
+
+@cli.argument('-i', '--input', required=True, help='Specify input WAV file.')
+@cli.argument('-o', '--output', default='', help='Specify output directory. Defaults to same directory as input.')
+@cli.argument('-e', '--encoding', default='adpcm', help=f'Output encoding, valid types: {", ".join(valid_encodings.keys())}')
+@cli.argument('-r', '--rate', type=int, default=0, help='Resample to this rate in Hz. Defaults to the rate of the input.')
+@cli.subcommand('Converts a WAV file to a clip the audio feature can stream')
+def audio_convert_clip(cli):
+    """Converts a WAV file to a precompressed PCM clip for `audio_play_clip()`.
+
+    The clip is mixed down to mono, resampled if asked to, and written as `INPUT.clip.c` and `INPUT.clip.h`.
+    """
+    cli.args.input = normpath(cli.args.input)
+    if not cli.args.input.exists():
+        cli.log.error('Input WAV file does not exist!')
+        cli.print_usage()
+        return False
+
+    # Work out the output directory
+    if len(cli.args.output) == 0:
+        cli.args.output = cli.args.input.parent
+    cli.args.output = normpath(cli.args.output)
+
+    if cli.args.encoding not in valid_encodings.keys():
+        cli.log.error('Output encoding %s is invalid. Allowed values: %s' % (cli.args.encoding, ', '.join(valid_encodings.keys())))
+        cli.print_usage()
+        return False
+
+    try:
+        samples, rate = read_wav(cli.args.input)
+    except Exception as e:
+        cli.log.error('Could not read %s: %s', cli.args.input, e)
+        return False
+
+    if cli.args.rate:
+        samples = resample(samples, rate, cli.args.rate)
+        rate = cli.args.rate
+    if not 0 < rate <= 0xFFFF:
+        cli.log.error('Sample rate %dHz does not fit a clip, pass --rate', rate)
+        return False
+
+    out_bytes = encode(samples, cli.args.encoding)
+    subs = generate_subs(cli, out_bytes, samples=len(samples), rate=rate, command_name="audio_convert_clip")
+
+    # Render and write the header file
+    header_file = cli.args.output / f"{cli.args.input.stem}.clip.h"
+    with open(header_file, 'w') as header:
+        print(f"Writing {header_file}...")
+        header.write(render_header(subs))
+
+    # Render and write the source file
+    source_file = cli.args.output / f"{cli.args.input.stem}.clip.c"
+    with open(source_file, 'w') as source:
+        print(f"Writing {source_file}...")
+        source.write(render_source(subs))
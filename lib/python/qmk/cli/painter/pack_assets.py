@@ -0,0 +1,80 @@
+"""Packs Quantum Painter images and fonts into an asset directory for external flash.
+"""
+import struct
+
+from qmk.path import normpath
+from milc import cli
+
+ASSETS_MAGIC = b'QPA'
+ASSETS_VERSION = 0x01
+ASSET_NAME_LENGTH = 24
+
+# Magic numbers of the QGF graphics descriptor and the QFF font descriptor, which share their layout up to the file size
+valid_asset_magics = {b'QGF': 'image', b'QFF': 'font'}
+
+
+def _read_asset(path):
+    """Reads a raw QGF or QFF file, returning its data and kind.
+    """
+    data = path.read_bytes()
+    if len(data) < 13 or data[0] != 0x00 or data[1] != 0xFF or data[5:8] not in valid_asset_magics:
+        raise ValueError('not a raw QGF or QFF file, convert it with --raw')
+
+    total_size, = struct.unpack_from('<I', data, 9)
+    if total_size != len(data):
+        raise ValueError(f'file is {len(data)} bytes but its descriptor says {total_size}')
+
+    return data, valid_asset_magics[data[5:8]]
+
+
+def _align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+
+@cli.argument('-o', '--output', required=True, help='Specify output binary file.')
+@cli.argument('-a', '--align', type=int, default=4, help='Align each asset to this many bytes. Default 4.')
+@cli.argument('inputs', nargs='+', arg_only=True, type=normpath, help='Raw QGF and QFF files, as written by --raw.')
+@cli.subcommand('Packs Quantum Painter images and fonts into a binary to write to external flash')
+def painter_pack_assets(cli):
+    """Packs raw QGF images and QFF fonts into one binary, for `qp_load_image_flash()` and `qp_load_font_flash()`.
+
+    Each asset is named after its file, without extensions. The binary starts with a directory of the assets, followed by their data, and is meant to be written to external flash at `QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS`.
+    """
+    if cli.args.align < 1:
+        cli.log.error('Alignment must be at least 1 byte.')
+        return False
+
+    assets = {}
+    for path in cli.args.inputs:
+        name = path.name.split('.')[0]
+        if len(name.encode('utf-8')) >= ASSET_NAME_LENGTH:
+            cli.log.error('Asset name "%s" is too long, the limit is %d bytes.', name, ASSET_NAME_LENGTH - 1)
+            return False
+        if name in assets:
+            cli.log.error('More than one asset is named "%s".', name)
+            return False
+
+        try:
+            data, kind = _read_asset(path)
+        except (OSError, ValueError) as e:
+            cli.log.error('Could not read %s: %s', path, e)
+            return False
+
+        cli.log.info('Packing %s "%s", %d bytes', kind, name, len(data))
+        assets[name] = data
+
+    # The directory header and its entries, see quantum/painter/qp_flash_assets.h
+    directory = bytearray(ASSETS_MAGIC + struct.pack('<BHH', ASSETS_VERSION, len(assets), 0))
+    offset = _align(len(directory) + len(assets) * (ASSET_NAME_LENGTH + 8), cli.args.align)
+    blobs = bytearray()
+    for name, data in assets.items():
+        directory += struct.pack(f'<{ASSET_NAME_LENGTH}sII', name.encode('utf-8'), offset + len(blobs), len(data))
+        blobs += data
+        blobs += bytes(_align(len(blobs), cli.args.align) - len(blobs))
+
+    out_bytes = directory + bytes(_align(len(directory), cli.args.align) - len(directory)) + blobs
+
+    output = normpath(cli.args.output)
+    with open(output, 'wb') as out:
+        print(f"Writing {output}...")
+        out.write(out_bytes)
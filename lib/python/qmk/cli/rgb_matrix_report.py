@@ -0,0 +1,116 @@
+"""Report the code size of the RGB Matrix effects linked into a firmware.
+"""
+import os
+import re
+
+from milc import cli
+
+from qmk.constants import QMK_FIRMWARE
+from qmk.path import normpath
+
+EFFECT_RE = re.compile(r'^\s*RGB_MATRIX_EFFECT\((\w+)\)', re.MULTILINE)
+ANIMATIONS_DIR = QMK_FIRMWARE / 'quantum' / 'rgb_matrix' / 'animations'
+
+# ELF e_machine values of the architectures QMK builds for
+EM_AVR = 83
+ELF_NM = {
+    40: 'arm-none-eabi-nm',
+    EM_AVR: 'avr-nm',
+    243: 'riscv32-unknown-elf-nm',
+}
+
+
+def _core_effects():
+    """Returns the names of all core effects.
+    """
+    effects = set()
+    for header in ANIMATIONS_DIR.glob('*.h'):
+        effects.update(EFFECT_RE.findall(header.read_text(encoding='utf-8')))
+    return effects
+
+
+def _elf_machine(elf):
+    """Returns the ELF machine type of the file, or None if it is not an ELF file.
+    """
+    with elf.open('rb') as fd:
+        header = fd.read(20)
+
+    if header[:4] != b'\x7fELF':
+        cli.log.error('%s is not an ELF file.', elf)
+        return None
+
+    return int.from_bytes(header[18:20], 'little')
+
+
+def _read_symbols(nm, elf):
+    """Returns a list of (name, size, address) for all code symbols.
+    """
+    result = cli.run([nm, '--size-sort', '-S', '-t', 'd', str(elf)])
+    if result.returncode != 0:
+        cli.log.error('%s failed: %s', nm, result.stderr.strip())
+        return None
+
+    symbols = []
+    for line in result.stdout.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in 'tTwW':
+            symbols.append((fields[3], int(fields[1]), int(fields[0])))
+    return symbols
+
+
+def _owner(symbol, effects):
+    """Maps a symbol to the effect it belongs to, including its `<EFFECT>_*` helpers.
+    """
+    if symbol in effects:
+        return symbol
+    if symbol.startswith('effect_runner_'):
+        return symbol
+
+    candidates = [effect for effect in effects if symbol.startswith(effect + '_')]
+    return max(candidates, key=len) if candidates else None
+
+
+@cli.argument('-n', '--nm', help='The nm binary to use. Default: $NM, else picked from the ELF machine type.')
+@cli.argument('-e', '--effect', arg_only=True, action='append', default=[], help='Additional (custom) effect function to report on. May be passed multiple times.')
+@cli.argument('elf', arg_only=True, type=normpath, help='The firmware ELF file, eg. .build/<keyboard>_<keymap>.elf')
+@cli.subcommand('Reports the code size of each RGB Matrix effect in a firmware.')
+def rgb_matrix_report(cli):
+    """Lists every RGB Matrix effect and generic runner found in the ELF, with its code size and location.
+
+    Render times are reported by the firmware itself when built with `RGB_MATRIX_EFFECT_PROFILE`.
+    """
+    if not cli.args.elf.exists():
+        cli.log.error('File not found: %s', cli.args.elf)
+        return False
+
+    machine = _elf_machine(cli.args.elf)
+    if machine is None:
+        return False
+
+    # `make RGB_MATRIX_REPORT=yes` passes the nm the firmware was built with
+    nm = cli.args.nm or os.environ.get('NM') or ELF_NM.get(machine, 'nm')
+
+    symbols = _read_symbols(nm, cli.args.elf)
+    if symbols is None:
+        return False
+
+    effects = _core_effects() | set(cli.args.effect)
+    sizes = {}
+    in_ram = set()
+    for name, size, address in symbols:
+        owner = _owner(name, effects)
+        if owner:
+            sizes[owner] = sizes.get(owner, 0) + size
+            # Cortex-M and RISC-V SRAM; AVR can't execute from RAM
+            if 0x20000000 <= address < 0x40000000 and machine != EM_AVR:
+                in_ram.add(owner)
+
+    if not sizes:
+        cli.log.warning('No RGB Matrix effects found in %s.', cli.args.elf)
+        return True
+
+    width = max(len(name) for name in sizes)
+    cli.echo(f'{"Effect".ljust(width)}  {"Bytes":>6}  Location')
+    for name, size in sorted(sizes.items(), key=lambda item: item[1], reverse=True):
+        cli.echo(f'{name.ljust(width)}  {size:>6}  {"ram" if name in in_ram else "flash"}')
+    cli.echo(f'{"Total".ljust(width)}  {sum(sizes.values()):>6}')
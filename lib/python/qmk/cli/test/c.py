@@ -8,6 +8,8 @@ from qmk.commands import find_make, get_make_parallel_args, build_environment
 
 
 @cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
+@cli.argument('-s', '--shared-core', action='store_true', help="Build the core once for all tests with the same flags.")
+@cli.argument('--test-jobs', type=int, default=1, help="Set the number of tests run at a time.")
 @cli.argument('-e', '--env', arg_only=True, action='append', default=[], help="Set a variable to be passed to make. May be passed multiple times.")
 @cli.argument('-c', '--clean', arg_only=True, action='store_true', help="Remove object files before compiling.")
 @cli.argument('-l', '--list', arg_only=True, action='store_true', help='List available tests.')
@@ -37,6 +39,12 @@ def test_c(cli):
     if cli.args.clean:
         targets.insert(0, 'clean')
 
+    if cli.config.test_c.shared_core:
+        targets.append('SHARED_TEST_CORE=yes')
+
+    if cli.config.test_c.test_jobs != 1:
+        targets.append(f'TEST_JOBS={cli.config.test_c.test_jobs}')
+
     # Add in the environment vars
     for key, value in build_environment(cli.args.env).items():
         targets.append(f'{key}={value}')
@@ -404,3 +404,65 @@ def test_find_multiple_conditions():
     assert len(ws2812_pin_values) > 0
     for s in ws2812_pin_values:
         assert '=D3' in s
+
+
+def test_audio_convert_clip(tmp_path):
+    import wave
+
+    wav_file = tmp_path / 'beep.wav'
+    with wave.open(str(wav_file), 'wb') as wav:
+        wav.setnchannels(1)
+        wav.setsampwidth(2)
+        wav.setframerate(16000)
+        wav.writeframes(b''.join(((i % 32) * 1000 - 16000).to_bytes(2, 'little', signed=True) for i in range(1600)))
+
+    result = check_subcommand('audio-convert-clip', '-i', str(wav_file), '-e', 'adpcm', '-r', '8000')
+    check_returncode(result)
+    source = (tmp_path / 'beep.clip.c').read_text()
+    assert 'const audio_clip_t clip_beep = {' in source
+    assert '.samples     = 800,' in source
+    assert 'static const uint8_t clip_beep_data[400]' in source
+
+
+def test_painter_pack_assets(tmp_path):
+    from PIL import Image
+
+    Image.new('RGB', (16, 8), (255, 0, 0)).save(tmp_path / 'red_box.png')
+    result = check_subcommand('painter-convert-graphics', '-i', str(tmp_path / 'red_box.png'), '-f', 'pal4', '-w')
+    check_returncode(result)
+    qgf = (tmp_path / 'red_box.qgf').read_bytes()
+
+    result = check_subcommand('painter-pack-assets', '-o', str(tmp_path / 'assets.bin'), str(tmp_path / 'red_box.qgf'))
+    check_returncode(result)
+    packed = (tmp_path / 'assets.bin').read_bytes()
+    assert packed[:8] == b'QPA\x01\x01\x00\x00\x00'
+    assert packed[8:32] == b'red_box'.ljust(24, b'\x00')
+    offset, length = int.from_bytes(packed[32:36], 'little'), int.from_bytes(packed[36:40], 'little')
+    assert length == len(qgf)
+    assert packed[offset:offset + length] == qgf
+
+
+def test_rgb_matrix_report_not_elf():
+    result = check_subcommand('rgb-matrix-report', 'lib/python/qmk/tests/kle.txt')
+    check_returncode(result, [1])
+    assert 'is not an ELF file' in result.stdout
+
+
+def test_rgb_matrix_report(tmp_path):
+    if is_windows:
+        return
+
+    # Stands in for the toolchain nm: address, size, type and name of each symbol
+    nm = tmp_path / 'nm'
+    nm.write_text('#!/bin/sh\necho "0000000100 0000000040 T CYCLE_ALL"\necho "0000000140 0000000008 t CYCLE_ALL_math"\necho "0536870912 0000000016 T effect_runner_i"\necho "0000000300 0000000100 T matrix_scan"\n')
+    nm.chmod(0o755)
+    elf = tmp_path / 'firmware.elf'
+    elf.write_bytes(b'\x7fELF')
+
+    result = check_subcommand('rgb-matrix-report', '-n', str(nm), str(elf))
+    check_returncode(result)
+    lines = [line.split() for line in result.stdout.splitlines()]
+    assert ['CYCLE_ALL', '48', 'flash'] in lines
+    assert ['effect_runner_i', '16', 'ram'] in lines
+    assert ['Total', '64'] in lines
+    assert 'matrix_scan' not in result.stdout
@@ -129,6 +129,24 @@
 #    define AUDIO_MAX_SIMULTANEOUS_TONES 2
 #endif
 
+/**
+ * Envelope the additive DAC driver applies to every tone: attack, decay and
+ * release in ms, and the level held in between in percent. The defaults play
+ * tones at full level from the first to the last sample.
+ */
+#ifndef AUDIO_DAC_ENVELOPE_ATTACK
+#    define AUDIO_DAC_ENVELOPE_ATTACK 0
+#endif
+#ifndef AUDIO_DAC_ENVELOPE_DECAY
+#    define AUDIO_DAC_ENVELOPE_DECAY 0
+#endif
+#ifndef AUDIO_DAC_ENVELOPE_SUSTAIN
+#    define AUDIO_DAC_ENVELOPE_SUSTAIN 100
+#endif
+#ifndef AUDIO_DAC_ENVELOPE_RELEASE
+#    define AUDIO_DAC_ENVELOPE_RELEASE 0
+#endif
+
 /**
  * The default value of the DAC when not playing anything. Certain hardware
  * setups may require a high (AUDIO_DAC_SAMPLE_MAX) or low (0) value here.
@@ -16,8 +16,8 @@
  */
 
 #include "audio.h"
+#include "synth.h"
 #include "gpio.h"
-#include <math.h>
 #include "util.h"
 
 // Need to disable GCC's "tautological-compare" warning for this file, as it causes issues when running `KEEP_INTERMEDIATES=yes`. Corresponding pop at the end of the file.
@@ -88,13 +88,22 @@ static const dacsample_t dac_buffer_trapezoid[] = {
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
 
-static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define DAC_WAVETABLE dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define DAC_WAVETABLE dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define DAC_WAVETABLE dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define DAC_WAVETABLE dac_buffer_square
+#endif
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+// the synth indexes the wavetable with the top bits of its phase
+_Static_assert((ARRAY_SIZE(DAC_WAVETABLE) & (ARRAY_SIZE(DAC_WAVETABLE) - 1)) == 0, "AUDIO_DAC: wavetable length has to be a power of two");
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
-static uint8_t active_tones_snapshot_length                        = 0;
+static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
+
+static uint8_t active_tones_snapshot_length = 0;
 
 typedef enum {
     OUTPUT_SHOULD_START,
@@ -117,71 +126,47 @@ output_states_t state = OUTPUT_OFF_2;
  * can override it with their own wave-forms/noises.
  */
 __attribute__((weak)) uint16_t dac_value_generate(void) {
-    // DAC is running/asking for values but snapshot length is zero -> must be playing a pause
-    if (active_tones_snapshot_length == 0) {
-        return AUDIO_DAC_OFF_VALUE;
-    }
-
     /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
-     */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_sine);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_triangle);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_trapezoid);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_square);
-#endif
-
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)wavetable_length / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
+     * wavetable samples for each frequency, scaled by the number of active tones.
+     * See synth.c, which does this with phase accumulators and integer math only.
+     *
+     * Note: a user implementation could directly query the active frequencies
+     * through audio_get_processed_frequency */
+    return synth_render();
+}
 
-        while (new_dac_if >= wavetable_length)
-            new_dac_if -= wavetable_length;
-        dac_if[i] = new_dac_if;
+/**
+ * Passes the currently active tones on to the synth, only called when they changed.
+ */
+static void update_tones_snapshot(void) {
+    uint32_t frequencies[AUDIO_MAX_SIMULTANEOUS_TONES];
+    uint8_t  active_tones = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
 
-        // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
+    active_tones_snapshot_length = 0;
+    for (uint8_t i = 0; i < active_tones; i++) {
+        float freq = audio_get_processed_frequency(i);
+        if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
+            frequencies[active_tones_snapshot_length++] = SYNTH_FREQUENCY(freq);
+        }
+    }
+    synth_set_tones(frequencies, active_tones_snapshot_length);
+}
 
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+#ifdef AUDIO_CLIP_ENABLE
+/**
+ * Adds the clip that is playing on top of the tones, full scale clips span the whole DAC range.
+ */
+static dacsample_t mix_clip(dacsample_t sample) {
+    if (!audio_clip_is_playing()) {
+        return sample;
     }
 
-    return value;
+    int32_t value = sample + ((audio_clip_render() * (int32_t)(AUDIO_DAC_SAMPLE_MAX + 1)) >> 16);
+    return value < 0 ? 0 : (value > AUDIO_DAC_SAMPLE_MAX ? AUDIO_DAC_SAMPLE_MAX : value);
 }
+#else
+#    define mix_clip(sample) (sample)
+#endif
 
 /**
  * DAC streaming callback. Does all of the main computing for playing songs.
@@ -198,7 +183,7 @@ static void dac_end(DACDriver *dacp) {
 
     for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
         if (OUTPUT_OFF <= state) {
-            sample_p[s] = AUDIO_DAC_OFF_VALUE;
+            sample_p[s] = mix_clip(AUDIO_DAC_OFF_VALUE);
             continue;
         } else {
             sample_p[s] = dac_value_generate();
@@ -236,16 +221,8 @@ static void dac_end(DACDriver *dacp) {
         }
 
         if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
-            uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
-            active_tones_snapshot_length = 0;
-            // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
-            for (uint8_t i = 0; i < active_tones; i++) {
-                float freq = audio_get_processed_frequency(i);
-                if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
-                }
-            }
+            // update the snapshot - once, and only on occasion that something changed
+            update_tones_snapshot();
 
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
@@ -254,6 +231,8 @@ static void dac_end(DACDriver *dacp) {
                 state = OUTPUT_RUN_NORMALLY;
             }
         }
+
+        sample_p[s] = mix_clip(sample_p[s]);
     }
 
     // update audio internal state (note position, current_note, ...)
@@ -265,6 +244,12 @@ static void dac_end(DACDriver *dacp) {
 
     if (OUTPUT_OFF <= state) {
         if (OUTPUT_OFF_2 == state) {
+#ifdef AUDIO_CLIP_ENABLE
+            // the clip streams on after the tones ended
+            if (audio_clip_is_playing()) {
+                return;
+            }
+#endif
             // stopping timer6 = stopping the DAC at whatever value it is currently pushing to the output = AUDIO_DAC_OFF_VALUE
             gptStopTimer(&GPTD6);
         } else {
@@ -304,6 +289,21 @@ static const DACConfig dac_conf = {.init = AUDIO_DAC_OFF_VALUE, .datamode = DAC_
 static const DACConversionGroup dac_conv_cfg = {.num_channels = 1U, .end_cb = dac_end, .error_cb = dac_error, .trigger = DAC_TRG(0b000)};
 
 void audio_driver_initialize_impl(void) {
+    /* Note: the 3/2 are necessary to get the correct frequencies on the DAC
+     *       output (as measured with an oscilloscope), since the gpt timer
+     *       runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback is called
+     *       twice per conversion. */
+    synth_init(DAC_WAVETABLE, __builtin_ctz(ARRAY_SIZE(DAC_WAVETABLE)), AUDIO_DAC_OFF_VALUE, AUDIO_DAC_SAMPLE_RATE * 3 / 2);
+    synth_set_envelope(&(synth_envelope_t){
+        .attack  = AUDIO_DAC_ENVELOPE_ATTACK,
+        .decay   = AUDIO_DAC_ENVELOPE_DECAY,
+        .sustain = (uint32_t)AUDIO_DAC_ENVELOPE_SUSTAIN * SYNTH_LEVEL_MAX / 100,
+        .release = AUDIO_DAC_ENVELOPE_RELEASE,
+    });
+#ifdef AUDIO_CLIP_ENABLE
+    audio_clip_init(AUDIO_DAC_SAMPLE_RATE * 3 / 2);
+#endif
+
     if ((AUDIO_PIN == A4) || (AUDIO_PIN_ALT == A4)) {
         palSetLineMode(A4, PAL_MODE_INPUT_ANALOG);
         dacStart(&DACD1, &dac_conf);
@@ -357,10 +357,7 @@ void audio_driver_stop_impl(void) {
 void audio_driver_start_impl(void) {
     gptStartContinuous(&GPTD6, 2U);
 
-    for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
-    }
+    synth_reset();
     active_tones_snapshot_length = 0;
     state                        = OUTPUT_SHOULD_START;
 }
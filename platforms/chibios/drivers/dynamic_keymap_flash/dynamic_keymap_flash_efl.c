@@ -0,0 +1,103 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <hal.h>
+#include "dynamic_keymap_flash.h"
+
+// Placed in the last sectors of flash, unless told otherwise. Emulated EEPROM
+// defaults to the same sectors, so one of them has to be moved out of the way.
+#if defined(WEAR_LEVELING_EMBEDDED_FLASH) && !defined(WEAR_LEVELING_EFL_OMIT_LAST_SECTOR_COUNT) && !defined(WEAR_LEVELING_EFL_FIRST_SECTOR) && !defined(DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR)
+#    error "Both the keymap and the emulated EEPROM use the last flash sectors, set WEAR_LEVELING_EFL_OMIT_LAST_SECTOR_COUNT to the sectors the keymap takes, or place either of them with WEAR_LEVELING_EFL_FIRST_SECTOR or DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR"
+#endif
+
+// Every page is erased on its own, so it can't share a sector with another one.
+// These series end their flash with 128kB sectors, more than can be held in RAM,
+// and only have 16kB sectors at the start of flash.
+#if defined(QMK_MCU_SERIES_STM32F2XX) || defined(QMK_MCU_SERIES_STM32F4XX) || defined(QMK_MCU_SERIES_STM32F7XX) || defined(QMK_MCU_SERIES_STM32H7XX)
+#    if !defined(DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR)
+#        error "The last flash sectors of this MCU are too large for the keymap store, place it on 16kB sectors with DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR and set DYNAMIC_KEYMAP_FLASH_PAGE_SIZE to 16384"
+#    elif (DYNAMIC_KEYMAP_FLASH_PAGE_SIZE) < 16384
+#        error "DYNAMIC_KEYMAP_FLASH_PAGE_SIZE has to be a multiple of the 16kB flash sectors of this MCU"
+#    endif
+#endif
+
+static BaseFlash     *flash;
+static flash_offset_t base_offset;
+static flash_sector_t first_sector;
+static flash_sector_t sector_count;
+
+bool dynamic_keymap_flash_driver_init(void) {
+    flash = (BaseFlash *)&EFLD1;
+
+    const flash_descriptor_t *desc = flashGetDescriptor(flash);
+    if (!(desc->attributes & FLASH_ATTR_ERASED_IS_ONE)) {
+        chSysHalt("The flash keymap store needs flash erasing to 0xFF");
+    }
+
+    // Sectors covering the store, working backwards from the end of flash by default
+#if defined(DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR)
+    first_sector = DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR;
+#else
+    uint32_t tail = 0;
+    first_sector  = desc->sectors_count;
+    while (tail < (DYNAMIC_KEYMAP_FLASH_SIZE) && first_sector > 0) {
+        tail += flashGetSectorSize(flash, --first_sector);
+    }
+#endif
+    uint32_t size = 0;
+    sector_count  = 0;
+    while (size < (DYNAMIC_KEYMAP_FLASH_SIZE) && first_sector + sector_count < desc->sectors_count) {
+        uint32_t sector_size = flashGetSectorSize(flash, first_sector + sector_count);
+        // Only reachable with a hand picked DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR,
+        // the default placement is checked above
+        if ((DYNAMIC_KEYMAP_FLASH_PAGE_SIZE) % sector_size != 0) {
+            chSysHalt("DYNAMIC_KEYMAP_FLASH_PAGE_SIZE is not a multiple of the flash sector size");
+        }
+        size += sector_size;
+        sector_count++;
+    }
+    if (size < (DYNAMIC_KEYMAP_FLASH_SIZE)) {
+        chSysHalt("Not enough flash for the keymap store");
+    }
+
+    base_offset = flashGetSectorOffset(flash, first_sector);
+    return true;
+}
+
+const void *dynamic_keymap_flash_driver_address(void) {
+    return flashGetOffsetAddress(flash, base_offset);
+}
+
+bool dynamic_keymap_flash_driver_erase(uint32_t offset) {
+    if (eflStart(&EFLD1, NULL) != HAL_RET_SUCCESS) {
+        return false;
+    }
+
+    bool ret = true;
+    for (flash_sector_t i = 0; i < sector_count; i++) {
+        flash_offset_t sector_offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        if (sector_offset < offset || sector_offset >= offset + (DYNAMIC_KEYMAP_FLASH_PAGE_SIZE)) {
+            continue;
+        }
+        flash_error_t status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+
+    eflStop(&EFLD1);
+    return ret;
+}
+
+bool dynamic_keymap_flash_driver_program(uint32_t offset, const void *data) {
+    if (eflStart(&EFLD1, NULL) != HAL_RET_SUCCESS) {
+        return false;
+    }
+    bool ret = flashProgram(flash, base_offset + offset, DYNAMIC_KEYMAP_FLASH_PAGE_SIZE, (const uint8_t *)data) == FLASH_NO_ERROR;
+    eflStop(&EFLD1);
+    return ret;
+}
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Bytes rewritten at once, and kept in RAM while changes are pending. Has to be
+// a multiple of the flash sector size, e.g. 16384 on STM32F4xx, where the store
+// also has to be placed with DYNAMIC_KEYMAP_FLASH_EFL_FIRST_SECTOR.
+#ifndef DYNAMIC_KEYMAP_FLASH_PAGE_SIZE
+#    define DYNAMIC_KEYMAP_FLASH_PAGE_SIZE 2048
+#endif
@@ -0,0 +1,35 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+#include "dynamic_keymap_flash.h"
+
+_Static_assert((DYNAMIC_KEYMAP_FLASH_RP2040_BASE) % (FLASH_SECTOR_SIZE) == 0, "DYNAMIC_KEYMAP_FLASH_RP2040_BASE must be aligned to FLASH_SECTOR_SIZE");
+_Static_assert((DYNAMIC_KEYMAP_FLASH_PAGE_SIZE) % (FLASH_SECTOR_SIZE) == 0, "DYNAMIC_KEYMAP_FLASH_PAGE_SIZE must be a multiple of FLASH_SECTOR_SIZE");
+
+bool dynamic_keymap_flash_driver_init(void) {
+    return true;
+}
+
+const void *dynamic_keymap_flash_driver_address(void) {
+    return (const void *)((XIP_BASE) + (DYNAMIC_KEYMAP_FLASH_RP2040_BASE));
+}
+
+// The flash can't be read while it's written to, so nothing may run from it
+// meanwhile; flash_range_erase() and flash_range_program() run from RAM and
+// flush the XIP cache once done.
+bool dynamic_keymap_flash_driver_erase(uint32_t offset) {
+    uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_erase((DYNAMIC_KEYMAP_FLASH_RP2040_BASE) + offset, DYNAMIC_KEYMAP_FLASH_PAGE_SIZE);
+    restore_interrupts(interrupts);
+    return true;
+}
+
+bool dynamic_keymap_flash_driver_program(uint32_t offset, const void *data) {
+    uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_program((DYNAMIC_KEYMAP_FLASH_RP2040_BASE) + offset, data, DYNAMIC_KEYMAP_FLASH_PAGE_SIZE);
+    restore_interrupts(interrupts);
+    return true;
+}
@@ -0,0 +1,21 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifndef __ASSEMBLER__
+#    include "hardware/flash.h"
+#endif
+
+// One flash sector rewritten at once
+#ifndef DYNAMIC_KEYMAP_FLASH_PAGE_SIZE
+#    define DYNAMIC_KEYMAP_FLASH_PAGE_SIZE (FLASH_SECTOR_SIZE)
+#endif
+
+// Right below the emulated EEPROM, if any, otherwise at the end of flash
+#ifndef DYNAMIC_KEYMAP_FLASH_RP2040_BASE
+#    if defined(WEAR_LEVELING_RP2040_FLASH)
+#        define DYNAMIC_KEYMAP_FLASH_RP2040_BASE ((WEAR_LEVELING_RP2040_FLASH_BASE) - (DYNAMIC_KEYMAP_FLASH_SIZE))
+#    else
+#        define DYNAMIC_KEYMAP_FLASH_RP2040_BASE ((PICO_FLASH_SIZE_BYTES) - (DYNAMIC_KEYMAP_FLASH_SIZE))
+#    endif
+#endif
@@ -10,6 +10,7 @@
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+#ifndef SERIAL_USART_STREAMING
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -20,13 +21,18 @@ static THD_FUNCTION(SlaveThread, arg) {
     chRegSetThreadName("split_protocol_tx_rx");
 
     while (true) {
+#    ifdef SERIAL_PROTOCOL_FRAMED
+        if (unlikely(!serial_protocol_framed_react())) {
+#    else
         if (unlikely(!react_to_transaction())) {
+#    endif
             /* Clear the receive queue, to start with a clean slate.
              * Parts of failed transactions or spurious bytes could still be in it. */
             serial_transport_driver_clear();
         }
     }
 }
+#endif
 
 /**
  * @brief Slave specific initializations.
@@ -34,8 +40,10 @@ static THD_FUNCTION(SlaveThread, arg) {
 void soft_serial_target_init(void) {
     serial_transport_driver_slave_init();
 
-    /* Start transport thread. */
+#ifndef SERIAL_USART_STREAMING
+    /* Start transport thread. When streaming the slave sends and receives from its main loop instead. */
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
+#endif
 }
 
 /**
@@ -104,9 +112,29 @@ bool soft_serial_transaction(int index) {
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
+#ifdef SERIAL_PROTOCOL_FRAMED
+    uint8_t transaction_id = (uint8_t)index;
+    return serial_protocol_framed_initiate(&transaction_id, 1);
+#else
     return initiate_transaction((uint8_t)index);
+#endif
 }
 
+#ifdef SERIAL_PROTOCOL_FRAMED
+/**
+ * @brief Run several transactions in one frame, with a single turnaround.
+ *
+ * @param indices Transaction Table indices of the transactions to run, in order.
+ * @param count Number of transactions.
+ * @return bool Indicates success of all transactions.
+ */
+bool soft_serial_transactions(const uint8_t* indices, uint8_t count) {
+    serial_transport_driver_clear();
+
+    return serial_protocol_framed_initiate(indices, count);
+}
+#endif
+
 /**
  * @brief Initiate transaction to slave half.
  */
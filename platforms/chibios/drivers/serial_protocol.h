@@ -47,3 +47,41 @@ bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* de
  * @return false Send failed, e.g. by timeout or bit errors.
  */
 bool __attribute__((nonnull, hot)) serial_transport_send(const uint8_t* source, const size_t size);
+
+#ifdef SERIAL_PROTOCOL_FRAMED
+#    ifndef SERIAL_PROTOCOL_FRAME_SIZE
+#        define SERIAL_PROTOCOL_FRAME_SIZE 320
+#    endif
+
+/**
+ * @brief Runs the given transactions on the slave, in as few frames as they fit in.
+ *
+ * @return true All transactions succeeded.
+ * @return false A frame failed, e.g. by timeout or checksum mismatch.
+ */
+bool serial_protocol_framed_initiate(const uint8_t* transaction_ids, uint8_t count);
+
+/**
+ * @brief Waits for a frame from the master, runs its transactions and sends the response.
+ *
+ * @return true Frame handled.
+ * @return false Frame failed, the receive queue should be cleared.
+ */
+bool serial_protocol_framed_react(void);
+#endif
+
+#ifdef SERIAL_USART_STREAMING
+/**
+ * @brief Non-blocking send, queues as much as there is room for.
+ *
+ * @return size_t Number of bytes queued.
+ */
+size_t __attribute__((nonnull)) serial_transport_send_nonblocking(const uint8_t* source, const size_t size);
+
+/**
+ * @brief Non-blocking receive of what already arrived, up to size bytes.
+ *
+ * @return size_t Number of bytes received.
+ */
+size_t __attribute__((nonnull)) serial_transport_receive_nonblocking(uint8_t* destination, const size_t size);
+#endif
@@ -0,0 +1,173 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_protocol.h"
+#include "synchronization_util.h"
+#include "crc.h"
+
+#ifdef SERIAL_PROTOCOL_FRAMED
+
+/* Framed protocol: the master sends all transactions of a batch in one frame
+ * and the slave answers with one frame, so a batch costs a single turnaround.
+ *
+ *   request:  length (2) | count (1) | ids (count) | initiator2target buffers | crc8
+ *   response: target2initiator buffers | crc8
+ *
+ * The length is little endian and counts the bytes between header and crc.
+ * The buffer sizes come from the transaction table on either side, so the
+ * master knows how long the response is. Its crc starts from the request crc,
+ * so that a stale response can't be mistaken for the current one. */
+
+#    define REQUEST_HEADER_SIZE 3
+// Only the request crc, which isn't sent again
+#    define RESPONSE_HEADER_SIZE 1
+
+_Static_assert(SERIAL_PROTOCOL_FRAME_SIZE >= REQUEST_HEADER_SIZE + 1 + UINT8_MAX + 1, "SERIAL_PROTOCOL_FRAME_SIZE too small for the largest transaction");
+
+static uint8_t request[SERIAL_PROTOCOL_FRAME_SIZE];
+static uint8_t response[SERIAL_PROTOCOL_FRAME_SIZE];
+
+static inline void put_length(uint8_t* destination, size_t length) {
+    destination[0] = length & 0xFF;
+    destination[1] = length >> 8;
+}
+
+static inline size_t get_length(const uint8_t* source) {
+    return source[0] | (source[1] << 8);
+}
+
+/**
+ * @brief Sends one frame with the transactions that fit and receives the response.
+ *
+ * @return uint8_t Number of transactions done, 0 on failure.
+ */
+static uint8_t initiate_frame(const uint8_t* transaction_ids, uint8_t count) {
+    size_t  request_length  = REQUEST_HEADER_SIZE;
+    size_t  response_length = RESPONSE_HEADER_SIZE;
+    uint8_t framed          = 0;
+
+    for (size_t payload = 0; framed < count; framed++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[framed]];
+        payload += transaction->initiator2target_buffer_size;
+        // Leave the rest for the next frame
+        if (REQUEST_HEADER_SIZE + framed + 1 + payload + 1 > sizeof(request) || response_length + transaction->target2initiator_buffer_size + 1 > sizeof(response)) {
+            break;
+        }
+        response_length += transaction->target2initiator_buffer_size;
+        request[request_length++] = transaction_ids[framed];
+    }
+
+    for (uint8_t i = 0; i < framed; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+        memcpy(&request[request_length], split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size);
+        request_length += transaction->initiator2target_buffer_size;
+    }
+
+    put_length(request, request_length - REQUEST_HEADER_SIZE);
+    request[2]              = framed;
+    request[request_length] = crc8(request, request_length);
+
+    if (!serial_transport_send(request, request_length + 1)) {
+        serial_dprintf("SPLIT: sending frame failed\n");
+        return 0;
+    }
+
+    /* Always read back the response, even for write only transactions, so that a slave which isn't ready is noticed. */
+    response[0] = request[request_length];
+    if (!serial_transport_receive(&response[RESPONSE_HEADER_SIZE], response_length - RESPONSE_HEADER_SIZE + 1) || response[response_length] != crc8(response, response_length)) {
+        serial_dprintf("SPLIT: receiving response failed\n");
+        return 0;
+    }
+
+    const uint8_t* buffer = &response[RESPONSE_HEADER_SIZE];
+    for (uint8_t i = 0; i < framed; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+        memcpy(split_trans_target2initiator_buffer(transaction), buffer, transaction->target2initiator_buffer_size);
+        buffer += transaction->target2initiator_buffer_size;
+    }
+
+    return framed;
+}
+
+bool serial_protocol_framed_initiate(const uint8_t* transaction_ids, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (transaction_ids[i] >= NUM_TOTAL_TRANSACTIONS) {
+            serial_dprintf("SPLIT: illegal transaction id\n");
+            return false;
+        }
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    while (count > 0) {
+        uint8_t done = initiate_frame(transaction_ids, count);
+        if (done == 0) {
+            return false;
+        }
+        transaction_ids += done;
+        count -= done;
+    }
+    return true;
+}
+
+bool serial_protocol_framed_react(void) {
+    /* Wait until there is a frame for us. */
+    if (!serial_transport_receive_blocking(request, REQUEST_HEADER_SIZE)) {
+        return false;
+    }
+
+    const size_t  length = get_length(request);
+    const uint8_t count  = request[2];
+    if (count == 0 || count > length || REQUEST_HEADER_SIZE + length + 1 > sizeof(request)) {
+        return false;
+    }
+
+    if (!serial_transport_receive(&request[REQUEST_HEADER_SIZE], length + 1) || request[REQUEST_HEADER_SIZE + length] != crc8(request, REQUEST_HEADER_SIZE + length)) {
+        return false;
+    }
+
+    const uint8_t* transaction_ids = &request[REQUEST_HEADER_SIZE];
+    for (uint8_t i = 0; i < count; i++) {
+        if (transaction_ids[i] >= NUM_TOTAL_TRANSACTIONS) {
+            return false;
+        }
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    /* Transactions are processed in order, and the sizes are looked up as they
+     * come, as a callback may resize the buffers of the following ones. */
+    const uint8_t* buffer          = &transaction_ids[count];
+    const uint8_t* end             = &request[REQUEST_HEADER_SIZE + length];
+    size_t         response_length = RESPONSE_HEADER_SIZE;
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+
+        if (buffer + transaction->initiator2target_buffer_size > end || response_length + transaction->target2initiator_buffer_size + 1 > sizeof(response)) {
+            return false;
+        }
+        memcpy(split_trans_initiator2target_buffer(transaction), buffer, transaction->initiator2target_buffer_size);
+        buffer += transaction->initiator2target_buffer_size;
+
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+
+        memcpy(&response[response_length], split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+        response_length += transaction->target2initiator_buffer_size;
+    }
+
+    if (buffer != end) {
+        return false;
+    }
+
+    response[0]               = request[REQUEST_HEADER_SIZE + length];
+    response[response_length] = crc8(response, response_length);
+
+    return serial_transport_send(&response[RESPONSE_HEADER_SIZE], response_length - RESPONSE_HEADER_SIZE + 1);
+}
+
+#endif // SERIAL_PROTOCOL_FRAMED
@@ -0,0 +1,134 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_protocol.h"
+#include "crc.h"
+
+#ifdef SERIAL_USART_STREAMING
+
+/* Streaming mode: both halves keep sending frames with their latest snapshot
+ * and take the newest complete frame from what arrived, neither waits for
+ * the other.
+ *
+ *   frame: magic (1) | sequence (1) | length (2) | payload (length) | crc8
+ *
+ * The length is little endian and the crc covers everything after the magic
+ * byte. After a bad frame the receiver hunts for the next magic byte. */
+
+#    define FRAME_MAGIC 0xA5
+#    define FRAME_HEADER_SIZE 4
+#    define FRAME_SIZE(length) (FRAME_HEADER_SIZE + (length) + 1)
+
+static uint8_t tx_frame[FRAME_SIZE(SERIAL_STREAM_BUFFER_SIZE)];
+static size_t  tx_length   = 0;
+static size_t  tx_sent     = 0;
+static uint8_t tx_sequence = 0;
+
+/* Frames are received into one buffer while the other holds the newest
+ * complete one, which is what soft_serial_stream_receive() hands out. */
+static uint8_t rx_frames[2][FRAME_SIZE(SERIAL_STREAM_BUFFER_SIZE)];
+static size_t  rx_lengths[2];
+static uint8_t rx_back     = 0;
+static size_t  rx_received = 0;
+static bool    rx_synced   = false;
+static uint8_t rx_sequence = 0;
+
+static serial_stream_stats_t stats;
+
+static inline size_t get_length(const uint8_t* frame) {
+    return frame[2] | (frame[3] << 8);
+}
+
+bool soft_serial_stream_send(const uint8_t* payload, size_t length) {
+    bool taken = false;
+
+    if (tx_sent == tx_length && length <= SERIAL_STREAM_BUFFER_SIZE) {
+        tx_frame[0] = FRAME_MAGIC;
+        tx_frame[1] = tx_sequence++;
+        tx_frame[2] = length & 0xFF;
+        tx_frame[3] = length >> 8;
+        memcpy(&tx_frame[FRAME_HEADER_SIZE], payload, length);
+        tx_frame[FRAME_HEADER_SIZE + length] = crc8(&tx_frame[1], FRAME_HEADER_SIZE - 1 + length);
+
+        tx_length = FRAME_SIZE(length);
+        tx_sent   = 0;
+        taken     = true;
+    }
+
+    if (tx_sent < tx_length) {
+        tx_sent += serial_transport_send_nonblocking(&tx_frame[tx_sent], tx_length - tx_sent);
+    }
+    return taken;
+}
+
+/**
+ * @brief Adds one byte to the frame being received.
+ *
+ * @return true The byte completed a valid frame.
+ */
+static bool receive_byte(uint8_t byte) {
+    uint8_t* frame = rx_frames[rx_back];
+
+    if (rx_received == 0 && byte != FRAME_MAGIC) {
+        return false;
+    }
+    frame[rx_received++] = byte;
+
+    if (rx_received < FRAME_HEADER_SIZE) {
+        return false;
+    }
+    const size_t length = get_length(frame);
+    if (length > SERIAL_STREAM_BUFFER_SIZE) {
+        stats.errors++;
+        rx_received = 0;
+        return false;
+    }
+    if (rx_received < FRAME_SIZE(length)) {
+        return false;
+    }
+
+    rx_received = 0;
+    if (frame[FRAME_HEADER_SIZE + length] != crc8(&frame[1], FRAME_HEADER_SIZE - 1 + length)) {
+        stats.errors++;
+        return false;
+    }
+
+    if (rx_synced && frame[1] != (uint8_t)(rx_sequence + 1)) {
+        stats.lost += (uint8_t)(frame[1] - rx_sequence - 1);
+    }
+    rx_sequence = frame[1];
+    rx_synced   = true;
+    stats.frames++;
+
+    rx_lengths[rx_back] = length;
+    rx_back ^= 1;
+    return true;
+}
+
+const uint8_t* soft_serial_stream_receive(size_t* length) {
+    uint8_t chunk[32];
+    size_t  count;
+    bool    fresh = false;
+
+    while ((count = serial_transport_receive_nonblocking(chunk, sizeof(chunk))) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            fresh |= receive_byte(chunk[i]);
+        }
+    }
+
+    if (!fresh) {
+        return NULL;
+    }
+    // The newest complete frame is in the buffer that isn't being received into
+    *length = rx_lengths[rx_back ^ 1];
+    return &rx_frames[rx_back ^ 1][FRAME_HEADER_SIZE];
+}
+
+serial_stream_stats_t soft_serial_stream_stats(void) {
+    return stats;
+}
+
+#endif // SERIAL_USART_STREAMING
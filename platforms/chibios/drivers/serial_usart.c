@@ -165,6 +165,20 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+#if defined(SERIAL_USART_STREAMING)
+#    if !defined(SERIAL_USART_FULL_DUPLEX)
+#        error "SERIAL_USART_STREAMING needs SERIAL_USART_FULL_DUPLEX, both halves send all the time"
+#    endif
+
+size_t serial_transport_send_nonblocking(const uint8_t* source, const size_t size) {
+    return chnWriteTimeout(serial_driver, source, size, TIME_IMMEDIATE);
+}
+
+size_t serial_transport_receive_nonblocking(uint8_t* destination, const size_t size) {
+    return chnReadTimeout(serial_driver, destination, size, TIME_IMMEDIATE);
+}
+#endif
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
@@ -83,6 +83,10 @@ __attribute__((weak)) void spi_init(void) {
     }
 }
 
+#if defined(THREADED_TASKS) && (SPI_USE_MUTUAL_EXCLUSION != TRUE)
+#    error "THREADED_TASKS needs SPI_USE_MUTUAL_EXCLUSION, the input and lighting threads share the bus"
+#endif
+
 bool spi_start_extended(spi_start_config_t *start_config) {
 #if (SPI_USE_MUTUAL_EXCLUSION == TRUE)
     spiAcquireBus(&SPI_DRIVER);
@@ -290,22 +290,110 @@ typedef uint8_t ws2812_buffer_t;
 typedef uint8_t ws2812_buffer_t;
 #endif
 
-static ws2812_buffer_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
+#ifdef WS2812_DOUBLE_BUFFER
+#    if defined(WB32F3G71xx) || defined(WB32FQ95xx) || defined(AT32F415)
+#        error "WS2812_DOUBLE_BUFFER is only supported by the PWM driver on STM32"
+#    endif
+#    define WS2812_FRAME_BUFFER_COUNT 2
+#else
+#    define WS2812_FRAME_BUFFER_COUNT 1
+#endif
+
+static ws2812_buffer_t ws2812_frame_buffer[WS2812_FRAME_BUFFER_COUNT][WS2812_BIT_N + 1]; /**< Buffers for a frame */
 
-/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 /*
- * Gedanke: Double-buffer type transactions: double buffer transfers using two memory pointers for
- * the memory (while the DMA is reading/writing from/to a buffer, the application can
- * write/read to/from the other buffer).
+ * Double-buffer type transactions: the DMA stream runs in double buffer mode, moving between its two memory registers
+ * at the end of every frame. While both of them point at the front buffer it is clocked out endlessly, and the
+ * application writes into the back buffer. A flush points the idle register at the back buffer, so the stream moves
+ * to it at the next frame boundary and a frame is never sent half updated. The hardware ignores writes to the
+ * register in use, so a write racing with the end of a frame is made again to the register that became idle.
  */
+#ifdef WS2812_DOUBLE_BUFFER
+#    if !defined(STM32_DMA_CR_DBM)
+#        error "WS2812_DOUBLE_BUFFER needs a DMA with double buffer mode, as found on STM32F2xx, STM32F4xx and STM32F7xx"
+#    endif
+#    define WS2812_PWM_DMA_MODE (STM32_DMA_CR_CHSEL(WS2812_PWM_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_PWM_DMA_PERIPHERAL_WIDTH | WS2812_PWM_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_DBM | STM32_DMA_CR_CIRC | STM32_DMA_CR_TCIE | STM32_DMA_CR_PL(3))
+
+static uint8_t        back_buffer   = 1;
+static volatile bool  frame_pending = false;
+static systime_t      frame_start   = 0;
+static ws2812_stats_t ws2812_stats  = {0};
+static uint8_t        stale_leds[WS2812_FRAME_BUFFER_COUNT][(WS2812_LED_COUNT + 7) / 8];
+
+static inline bool ws2812_dma_target(void) {
+    return (WS2812_PWM_DMA_STREAM->stream->CR & STM32_DMA_CR_CT) != 0;
+}
+
+// The frame buffer the stream is clocking out
+static ws2812_buffer_t *ws2812_dma_current(void) {
+    bool      target;
+    uintptr_t address;
+    do {
+        target  = ws2812_dma_target();
+        address = target ? WS2812_PWM_DMA_STREAM->stream->M1AR : WS2812_PWM_DMA_STREAM->stream->M0AR;
+    } while (ws2812_dma_target() != target);
+    return (ws2812_buffer_t *)address;
+}
+
+// Points the idle memory register at a frame buffer, to be clocked out from the next frame boundary
+static void ws2812_dma_set_next(uint8_t buffer) {
+    bool target;
+    do {
+        target = ws2812_dma_target();
+        if (target) {
+            dmaStreamSetMemory0(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer[buffer]);
+        } else {
+            dmaStreamSetMemory1(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer[buffer]);
+        }
+    } while (ws2812_dma_target() != target);
+}
+
+// Catches the stream moving on to the pending frame, called with the system lock held
+static void ws2812_dma_sync(void) {
+    if (frame_pending && ws2812_dma_current() == ws2812_frame_buffer[back_buffer]) {
+        back_buffer ^= 1;
+        frame_pending = false;
+        ws2812_stats.frames++;
+        // Keep sending the new front buffer, the previous one is written to from now on
+        ws2812_dma_set_next(back_buffer ^ 1);
+    }
+}
+
+static void ws2812_dma_callback(void *param, uint32_t flags) {
+    (void)param;
+
+    if (!(flags & STM32_DMA_ISR_TCIF)) {
+        return;
+    }
+
+    osalSysLockFromISR();
+    ws2812_stats.transfer_us = TIME_I2US(chVTTimeElapsedSinceX(frame_start));
+    frame_start              = chVTGetSystemTimeX();
+    ws2812_dma_sync();
+    osalSysUnlockFromISR();
+}
+
+ws2812_stats_t ws2812_get_stats(void) {
+    osalSysLock();
+    ws2812_stats_t stats = ws2812_stats;
+    osalSysUnlock();
+    return stats;
+}
+#else
+#    define WS2812_PWM_DMA_MODE (STM32_DMA_CR_CHSEL(WS2812_PWM_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_PWM_DMA_PERIPHERAL_WIDTH | WS2812_PWM_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3))
+#endif
+
+/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 
 void ws2812_init(void) {
-    // Initialize led frame buffer
+    // Initialize led frame buffers
     uint32_t i;
-    for (i = 0; i < WS2812_COLOR_BIT_N; i++)
-        ws2812_frame_buffer[i] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
-    for (i = 0; i < WS2812_RESET_BIT_N; i++)
-        ws2812_frame_buffer[i + WS2812_COLOR_BIT_N] = 0; // All reset bits are zero
+    for (uint8_t f = 0; f < WS2812_FRAME_BUFFER_COUNT; f++) {
+        for (i = 0; i < WS2812_COLOR_BIT_N; i++)
+            ws2812_frame_buffer[f][i] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
+        for (i = 0; i < WS2812_RESET_BIT_N; i++)
+            ws2812_frame_buffer[f][i + WS2812_COLOR_BIT_N] = 0; // All reset bits are zero
+    }
 
     palSetLineMode(WS2812_DI_PIN, WS2812_OUTPUT_MODE);
 
@@ -334,19 +422,27 @@ void ws2812_init(void) {
     // dmaInit(); // Joe added this
 #if defined(WB32F3G71xx) || defined(WB32FQ95xx)
     dmaStreamAlloc(WS2812_PWM_DMA_STREAM - WB32_DMA_STREAM(0), 10, NULL, NULL);
-    dmaStreamSetSource(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer);
+    dmaStreamSetSource(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer[0]);
     dmaStreamSetDestination(WS2812_PWM_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
     dmaStreamSetMode(WS2812_PWM_DMA_STREAM, WB32_DMA_CHCFG_HWHIF(WS2812_PWM_DMA_CHANNEL) | WB32_DMA_CHCFG_DIR_M2P | WB32_DMA_CHCFG_PSIZE_WORD | WB32_DMA_CHCFG_MSIZE_WORD | WB32_DMA_CHCFG_MINC | WB32_DMA_CHCFG_CIRC | WB32_DMA_CHCFG_TCIE | WB32_DMA_CHCFG_PL(3));
 #elif defined(AT32F415)
     dmaStreamAlloc(WS2812_PWM_DMA_STREAM - AT32_DMA_STREAM(0), 10, NULL, NULL);
     dmaStreamSetPeripheral(WS2812_PWM_DMA_STREAM, &(WS2812_PWM_DRIVER.tmr->CDT[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
-    dmaStreamSetMemory0(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer);
+    dmaStreamSetMemory0(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer[0]);
     dmaStreamSetMode(WS2812_PWM_DMA_STREAM, AT32_DMA_CCTRL_DTD_M2P | WS2812_PWM_DMA_PERIPHERAL_WIDTH | WS2812_PWM_DMA_MEMORY_WIDTH | AT32_DMA_CCTRL_MINCM | AT32_DMA_CCTRL_LM | AT32_DMA_CCTRL_CHPL(3));
+#elif defined(WS2812_DOUBLE_BUFFER)
+    back_buffer   = 1;
+    frame_pending = false;
+    dmaStreamAlloc(WS2812_PWM_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_callback, NULL);
+    dmaStreamSetPeripheral(WS2812_PWM_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
+    dmaStreamSetMemory0(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer[0]);
+    dmaStreamSetMemory1(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer[0]);
+    dmaStreamSetMode(WS2812_PWM_DMA_STREAM, WS2812_PWM_DMA_MODE);
 #else
     dmaStreamAlloc(WS2812_PWM_DMA_STREAM - STM32_DMA_STREAM(0), 10, NULL, NULL);
     dmaStreamSetPeripheral(WS2812_PWM_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
-    dmaStreamSetMemory0(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer);
-    dmaStreamSetMode(WS2812_PWM_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_PWM_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_PWM_DMA_PERIPHERAL_WIDTH | WS2812_PWM_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3));
+    dmaStreamSetMemory0(WS2812_PWM_DMA_STREAM, ws2812_frame_buffer[0]);
+    dmaStreamSetMode(WS2812_PWM_DMA_STREAM, WS2812_PWM_DMA_MODE);
 #endif
     dmaStreamSetTransactionSize(WS2812_PWM_DMA_STREAM, WS2812_BIT_N);
     // M2P: Memory 2 Periph; PL: Priority Level
@@ -373,27 +469,62 @@ void ws2812_init(void) {
 }
 
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
+#ifdef WS2812_DOUBLE_BUFFER
+    ws2812_buffer_t *frame = ws2812_frame_buffer[back_buffer];
+#else
+    ws2812_buffer_t *frame = ws2812_frame_buffer[0];
+#endif
     // Write color to frame buffer
     for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        frame[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        frame[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        frame[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
     }
 }
 void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+#ifdef WS2812_DOUBLE_BUFFER
+    ws2812_buffer_t *frame = ws2812_frame_buffer[back_buffer];
+#else
+    ws2812_buffer_t *frame = ws2812_frame_buffer[0];
+#endif
     // Write color to frame buffer
     for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        frame[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        frame[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        frame[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
 #ifdef WS2812_RGBW
-        ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        frame[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
 #endif
     }
 }
 
 ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
+static inline void ws2812_write_led_index(int index) {
+#if defined(WS2812_RGBW)
+    ws2812_write_led_rgbw(index, ws2812_leds[index].r, ws2812_leds[index].g, ws2812_leds[index].b, ws2812_leds[index].w);
+#else
+    ws2812_write_led(index, ws2812_leds[index].r, ws2812_leds[index].g, ws2812_leds[index].b);
+#endif
+}
+
+#ifdef WS2812_DOUBLE_BUFFER
+static void ws2812_update_back_buffer(int index) {
+    // The interrupt may swap buffers at any time, keep it out while this LED is written
+    osalSysLock();
+    if (frame_pending) {
+        // The back buffer is queued as is, pick this LED up on the next flush
+        stale_leds[0][index / 8] |= (1 << (index % 8));
+        stale_leds[1][index / 8] |= (1 << (index % 8));
+    } else {
+        ws2812_write_led_index(index);
+        stale_leds[back_buffer][index / 8] &= ~(1 << (index % 8));
+        stale_leds[back_buffer ^ 1][index / 8] |= (1 << (index % 8));
+    }
+    osalSysUnlock();
+}
+#endif
+
 void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     ws2812_leds[index].r = red;
     ws2812_leds[index].g = green;
@@ -401,6 +532,9 @@ void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
 #if defined(WS2812_RGBW)
     ws2812_rgb_to_rgbw(&ws2812_leds[index]);
 #endif
+#ifdef WS2812_DOUBLE_BUFFER
+    ws2812_update_back_buffer(index);
+#endif
 }
 
 void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -409,12 +543,42 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+#ifdef WS2812_DOUBLE_BUFFER
 void ws2812_flush(void) {
+    systime_t start = chVTGetSystemTimeX();
+
+    // Only one frame can be queued behind the one being clocked out. Take back one that is still waiting, this
+    // newer frame goes out at the same frame boundary in its place.
+    osalSysLock();
+    if (frame_pending) {
+        ws2812_dma_set_next(back_buffer ^ 1);
+        // Unless the stream already moved on to it
+        ws2812_dma_sync();
+        if (frame_pending) {
+            frame_pending = false;
+            ws2812_stats.skipped++;
+        }
+    }
+    osalSysUnlock();
+
+    // LEDs set since this buffer was last sent are already encoded, only bring the untouched ones up to date
     for (int i = 0; i < WS2812_LED_COUNT; i++) {
-#if defined(WS2812_RGBW)
-        ws2812_write_led_rgbw(i, ws2812_leds[i].r, ws2812_leds[i].g, ws2812_leds[i].b, ws2812_leds[i].w);
+        if (stale_leds[back_buffer][i / 8] & (1 << (i % 8))) {
+            ws2812_update_back_buffer(i);
+        }
+    }
+
+    osalSysLock();
+    ws2812_dma_set_next(back_buffer);
+    frame_pending = true;
+    osalSysUnlock();
+
+    ws2812_stats.flush_us = TIME_I2US(chVTTimeElapsedSinceX(start));
+}
 #else
-        ws2812_write_led(i, ws2812_leds[i].r, ws2812_leds[i].g, ws2812_leds[i].b);
-#endif
+void ws2812_flush(void) {
+    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+        ws2812_write_led_index(i);
     }
 }
+#endif
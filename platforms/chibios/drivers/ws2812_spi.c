@@ -1,3 +1,4 @@
+#include <string.h>
 #include "ws2812.h"
 #include "gpio.h"
 #include "util.h"
@@ -96,6 +97,10 @@
 #    define WS2812_SPI_BUFFER_MODE 0 // normal buffer
 #endif
 
+#if defined(WS2812_DOUBLE_BUFFER) && (defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC))
+#    error "WS2812_DOUBLE_BUFFER cannot be combined with WS2812_SPI_USE_CIRCULAR_BUFFER or WS2812_SPI_SYNC"
+#endif
+
 #if defined(USE_GPIOV1)
 #    define WS2812_SCK_OUTPUT_MODE PAL_MODE_ALTERNATE_PUSHPULL
 #else
@@ -113,7 +118,30 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+#ifdef WS2812_DOUBLE_BUFFER
+#    define WS2812_TXBUF_COUNT 2
+#else
+#    define WS2812_TXBUF_COUNT 1
+#endif
+
+static uint8_t txbuf[WS2812_TXBUF_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+
+#ifdef WS2812_DOUBLE_BUFFER
+/*
+ * The main loop encodes LEDs into the back buffer as they are set, while the
+ * front buffer is being clocked out by the DMA. A flush hands the back buffer
+ * to the DMA, or, if a transfer is still running, leaves it pending for the
+ * transfer complete callback to start.
+ */
+static uint8_t        back_buffer      = 0;
+static volatile bool  transfer_active  = false;
+static volatile bool  transfer_pending = false;
+static systime_t      transfer_start   = 0;
+static ws2812_stats_t ws2812_stats     = {0};
+static uint8_t        stale_leds[WS2812_TXBUF_COUNT][(WS2812_LED_COUNT + 7) / 8];
+#endif
+
+ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
@@ -133,38 +161,90 @@ static uint8_t get_protocol_eq(uint8_t data, int pos) {
     return eq;
 }
 
-static void set_led_color_rgb(ws2812_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
-
+static void encode_led_color(uint8_t* led_start, ws2812_led_t color) {
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
+        led_start[j] = get_protocol_eq(color.g, j);
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
+        led_start[BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+        led_start[BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
+        led_start[j] = get_protocol_eq(color.r, j);
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
+        led_start[BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+        led_start[BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
+        led_start[j] = get_protocol_eq(color.b, j);
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
+        led_start[BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+        led_start[BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
 #endif
 #ifdef WS2812_RGBW
     for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
+        led_start[BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
 #endif
 }
 
-ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
+#ifdef WS2812_DOUBLE_BUFFER
+static void update_back_buffer(int index) {
+    // Encode outside of the lock, the transfer complete callback may swap buffers at any time
+    uint8_t encoded[BYTES_FOR_LED];
+    encode_led_color(encoded, ws2812_leds[index]);
+
+    osalSysLock();
+    if (transfer_pending) {
+        // The back buffer is queued as is, pick this LED up on the next flush
+        stale_leds[0][index / 8] |= (1 << (index % 8));
+        stale_leds[1][index / 8] |= (1 << (index % 8));
+    } else {
+        memcpy(&txbuf[back_buffer][PREAMBLE_SIZE + BYTES_FOR_LED * index], encoded, BYTES_FOR_LED);
+        stale_leds[back_buffer][index / 8] &= ~(1 << (index % 8));
+        stale_leds[back_buffer ^ 1][index / 8] |= (1 << (index % 8));
+    }
+    osalSysUnlock();
+}
+
+/*
+ * Must be called from a locked state. Hands the back buffer over to the DMA.
+ */
+static void start_transfer_i(void) {
+    uint8_t front = back_buffer;
+
+    back_buffer      = front ^ 1;
+    transfer_active  = true;
+    transfer_pending = false;
+    transfer_start   = chVTGetSystemTimeX();
+    ws2812_stats.frames++;
+
+    spiStartSendI(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[front]), txbuf[front]);
+}
+
+static void transfer_complete_cb(SPIDriver* spip) {
+    (void)spip;
+
+    osalSysLockFromISR();
+    ws2812_stats.transfer_us = TIME_I2US(chVTTimeElapsedSinceX(transfer_start));
+    transfer_active          = false;
+    if (transfer_pending) {
+        start_transfer_i();
+    }
+    osalSysUnlockFromISR();
+}
+
+ws2812_stats_t ws2812_get_stats(void) {
+    osalSysLock();
+    ws2812_stats_t stats = ws2812_stats;
+    osalSysUnlock();
+    return stats;
+}
+#else
+#    define transfer_complete_cb NULL
+#endif
 
 void ws2812_init(void) {
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
@@ -180,7 +260,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        transfer_complete_cb, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -199,8 +279,8 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
-        NULL, // error_cb
+        transfer_complete_cb, // data_cb
+        NULL,                 // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(AT32F415)
@@ -220,37 +300,86 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
 #endif
+
+    // Start from a valid "all off" encoding in every buffer
+    for (int b = 0; b < WS2812_TXBUF_COUNT; b++) {
+        for (int i = 0; i < WS2812_LED_COUNT; i++) {
+            encode_led_color(&txbuf[b][PREAMBLE_SIZE + BYTES_FOR_LED * i], ws2812_leds[i]);
+        }
+    }
+}
+
+void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+        ws2812_set_color(i, red, green, blue);
+    }
 }
 
+#ifdef WS2812_DOUBLE_BUFFER
 void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     ws2812_leds[index].r = red;
     ws2812_leds[index].g = green;
     ws2812_leds[index].b = blue;
-#if defined(WS2812_RGBW)
+#    if defined(WS2812_RGBW)
     ws2812_rgb_to_rgbw(&ws2812_leds[index]);
-#endif
+#    endif
+    update_back_buffer(index);
 }
 
-void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+void ws2812_flush(void) {
+    systime_t start = chVTGetSystemTimeX();
+
+    // Only one frame can be queued behind the one on the wire. Take back one that is still waiting, this newer
+    // frame is started by the transfer complete callback in its place.
+    osalSysLock();
+    if (transfer_pending) {
+        transfer_pending = false;
+        ws2812_stats.skipped++;
+    }
+    osalSysUnlock();
+
+    // LEDs set since this buffer was last sent are already encoded, only bring the untouched ones up to date
     for (int i = 0; i < WS2812_LED_COUNT; i++) {
-        ws2812_set_color(i, red, green, blue);
+        if (stale_leds[back_buffer][i / 8] & (1 << (i % 8))) {
+            update_back_buffer(i);
+        }
     }
+
+    osalSysLock();
+    if (transfer_active) {
+        transfer_pending = true;
+    } else {
+        start_transfer_i();
+    }
+    osalSysUnlock();
+
+    ws2812_stats.flush_us = TIME_I2US(chVTTimeElapsedSinceX(start));
+}
+#else
+void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    ws2812_leds[index].r = red;
+    ws2812_leds[index].g = green;
+    ws2812_leds[index].b = blue;
+#    if defined(WS2812_RGBW)
+    ws2812_rgb_to_rgbw(&ws2812_leds[index]);
+#    endif
 }
 
 void ws2812_flush(void) {
     for (int i = 0; i < WS2812_LED_COUNT; i++) {
-        set_led_color_rgb(ws2812_leds[i], i);
+        encode_led_color(&txbuf[0][PREAMBLE_SIZE + BYTES_FOR_LED * i], ws2812_leds[i]);
     }
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
-#ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
-#    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
-#    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+#    ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
+#        ifdef WS2812_SPI_SYNC
+    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
+#        else
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
+#        endif
 #    endif
-#endif
 }
+#endif
@@ -0,0 +1,40 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include "matrix.h"
+
+#ifdef MATRIX_SCAN_ASYNC
+
+#    ifndef MATRIX_SCAN_ASYNC_INTERVAL_US
+#        define MATRIX_SCAN_ASYNC_INTERVAL_US 500
+#    endif
+
+#    ifndef MATRIX_SCAN_ASYNC_PRIORITY
+#        define MATRIX_SCAN_ASYNC_PRIORITY (NORMALPRIO + 3)
+#    endif
+
+#    ifndef MATRIX_SCAN_ASYNC_STACK_SIZE
+#        define MATRIX_SCAN_ASYNC_STACK_SIZE 512
+#    endif
+
+static THD_WORKING_AREA(matrix_scan_thread_wa, MATRIX_SCAN_ASYNC_STACK_SIZE);
+
+static THD_FUNCTION(matrix_scan_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("matrix_scan");
+
+    systime_t next = chVTGetSystemTime();
+    while (true) {
+        matrix_scan_async_task();
+        // Keep a fixed scan rate, however long the scan itself took
+        next = chThdSleepUntilWindowed(next, chTimeAddX(next, TIME_US2I(MATRIX_SCAN_ASYNC_INTERVAL_US)));
+    }
+}
+
+bool matrix_scan_async_start(void) {
+    chThdCreateStatic(matrix_scan_thread_wa, sizeof(matrix_scan_thread_wa), MATRIX_SCAN_ASYNC_PRIORITY, matrix_scan_thread, NULL);
+    return true;
+}
+
+#endif
@@ -285,6 +285,10 @@ PLATFORM_SRC = \
         $(PLATFORM_COMMON_DIR)/synchronization_util.c \
         $(PLATFORM_COMMON_DIR)/interrupt_handlers.c
 
+ifeq ($(strip $(MATRIX_SCAN_ASYNC)), yes)
+    PLATFORM_SRC += $(PLATFORM_COMMON_DIR)/matrix_scan_async.c
+endif
+
 # Ensure the ASM files are not subjected to LTO -- it'll strip out interrupt handlers otherwise.
 QUANTUM_LIB_SRC += $(STARTUPASM) $(PORTASM) $(OSALASM) $(PLATFORMASM)
 
@@ -24,3 +24,23 @@ void split_shared_memory_unlock(void) {
     chMtxUnlock(&SPLIT_SHARED_MEMORY_MUTEX);
 }
 #endif
+
+#if defined(THREADED_TASKS)
+static MUTEX_DECL(KEYBOARD_STATE_MUTEX);
+
+/**
+ * @brief Acquire exclusive access to the keyboard state shared between the
+ * input and lighting threads. The lighting thread only holds it while it
+ * draws a frame into RAM, never during a bus transfer.
+ */
+void keyboard_state_lock(void) {
+    chMtxLock(&KEYBOARD_STATE_MUTEX);
+}
+
+/**
+ * @brief Release the keyboard state mutex that has been acquired before.
+ */
+void keyboard_state_unlock(void) {
+    chMtxUnlock(&KEYBOARD_STATE_MUTEX);
+}
+#endif
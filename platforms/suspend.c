@@ -41,9 +41,18 @@ __attribute__((weak)) void suspend_wakeup_init_kb(void) {
  * FIXME: needs doc
  */
 bool suspend_wakeup_condition(void) {
+#ifdef MATRIX_SCAN_ASYNC
+    // The background scanner keeps the matrix up to date, scanning here would race it
+    if (!matrix_scan_async_is_running()) {
+        matrix_power_up();
+        matrix_scan();
+        matrix_power_down();
+    }
+#else
     matrix_power_up();
     matrix_scan();
     matrix_power_down();
+#endif
     for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
         if (matrix_get_row(r)) return true;
     }
@@ -15,3 +15,7 @@ extern inline void split_shared_memory_unlock(void);
 #if defined(SPLIT_KEYBOARD)
 QMK_IMPLEMENT_AUTOUNLOCK_HELPERS(split_shared_memory)
 #endif
+
+#if defined(THREADED_TASKS)
+QMK_IMPLEMENT_AUTOUNLOCK_HELPERS(keyboard_state)
+#endif
@@ -8,11 +8,18 @@
 void split_shared_memory_lock(void);
 void split_shared_memory_unlock(void);
 #    endif
+#    if defined(THREADED_TASKS)
+void keyboard_state_lock(void);
+void keyboard_state_unlock(void);
+#    endif
 #else
 #    if defined(SPLIT_KEYBOARD)
 inline void split_shared_memory_lock(void){};
 inline void split_shared_memory_unlock(void){};
 #    endif
+#    if defined(THREADED_TASKS)
+#        error "THREADED_TASKS is only supported on platforms with synchronization primitives"
+#    endif
 #endif
 
 /* GCCs cleanup attribute expects a function with one parameter, which is a
@@ -52,3 +59,14 @@ QMK_DECLARE_AUTOUNLOCK_HELPERS(split_shared_memory)
  */
 #    define split_shared_memory_lock_autounlock QMK_DECLARE_AUTOUNLOCK_CALL(split_shared_memory)
 #endif
+
+#if defined(THREADED_TASKS)
+QMK_DECLARE_AUTOUNLOCK_HELPERS(keyboard_state)
+
+/**
+ * @brief Acquire exclusive access to the keyboard state shared between the
+ * input and lighting threads. The lock is automatically released when the
+ * enclosing block goes out of scope.
+ */
+#    define keyboard_state_lock_autounlock QMK_DECLARE_AUTOUNLOCK_CALL(keyboard_state)
+#endif
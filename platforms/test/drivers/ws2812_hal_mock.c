@@ -0,0 +1,167 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ws2812_hal_mock.h"
+
+static systime_t now        = 0;
+static int       lock_depth = 0;
+
+// Interrupt raised while the system lock was held
+static void (*pending_isr)(void) = NULL;
+
+systime_t chVTGetSystemTimeX(void) {
+    return now++;
+}
+
+void osalSysLock(void) {
+    lock_depth++;
+}
+
+void osalSysUnlock(void) {
+    lock_depth--;
+    if (lock_depth == 0 && pending_isr) {
+        void (*isr)(void) = pending_isr;
+        pending_isr       = NULL;
+        isr();
+    }
+}
+
+void osalSysLockFromISR(void) {
+    lock_depth++;
+}
+
+void osalSysUnlockFromISR(void) {
+    lock_depth--;
+}
+
+int mock_ws2812_lock_depth(void) {
+    return lock_depth;
+}
+
+#if defined(WS2812_SPI)
+SPIDriver SPID1;
+
+static const uint8_t *spi_frame      = NULL;
+static size_t         spi_frame_size = 0;
+static bool           spi_busy       = false;
+
+void spiAcquireBus(SPIDriver *spip) {}
+
+void spiStart(SPIDriver *spip, const SPIConfig *config) {
+    spip->config = config;
+}
+
+void spiSelect(SPIDriver *spip) {}
+
+void spiStartSendI(SPIDriver *spip, size_t n, const void *txbuf) {
+    spi_frame      = txbuf;
+    spi_frame_size = n;
+    spi_busy       = true;
+}
+
+void spiStartSend(SPIDriver *spip, size_t n, const void *txbuf) {
+    spiStartSendI(spip, n, txbuf);
+}
+
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf) {
+    spiStartSendI(spip, n, txbuf);
+    spi_busy = false;
+}
+
+const uint8_t *mock_ws2812_frame(void) {
+    return spi_frame;
+}
+
+size_t mock_ws2812_frame_size(void) {
+    return spi_frame_size;
+}
+
+void mock_ws2812_transfer_complete(void) {
+    if (!spi_busy) {
+        return;
+    }
+    spi_busy = false;
+    if (SPID1.config->end_cb) {
+        SPID1.config->end_cb(&SPID1);
+    }
+}
+#elif defined(WS2812_PWM)
+static stm32_tim_t tim2;
+PWMDriver          PWMD2 = {.tim = &tim2};
+
+stm32_dma_stream_t        mock_dma_streams[8];
+static DMA_Stream_TypeDef dma_registers[8];
+
+static stm32_dma_stream_t *pwm_stream          = NULL;
+static bool                complete_next_write = false;
+
+const stm32_dma_stream_t *dmaStreamAlloc(uint32_t id, uint32_t priority, stm32_dmaisr_t func, void *param) {
+    pwm_stream             = &mock_dma_streams[id];
+    pwm_stream->stream     = &dma_registers[id];
+    pwm_stream->stream->CR = 0;
+    pwm_stream->enabled    = false;
+    pwm_stream->func       = func;
+    pwm_stream->param      = param;
+    return pwm_stream;
+}
+
+void pwmStart(PWMDriver *pwmp, const PWMConfig *config) {}
+
+void pwmEnableChannel(PWMDriver *pwmp, uint32_t channel, uint32_t width) {}
+
+static int current_target(void) {
+    return (pwm_stream->stream->CR & STM32_DMA_CR_DBM) && (pwm_stream->stream->CR & STM32_DMA_CR_CT) ? 1 : 0;
+}
+
+// End of a frame: in double buffer mode the stream moves to the other memory register
+static void end_frame(void) {
+    if (pwm_stream->stream->CR & STM32_DMA_CR_DBM) {
+        pwm_stream->stream->CR ^= STM32_DMA_CR_CT;
+    }
+}
+
+static void dma_isr(void) {
+    if (pwm_stream->func) {
+        pwm_stream->func(pwm_stream->param, STM32_DMA_ISR_TCIF);
+    }
+}
+
+void mock_dma_set_memory(stm32_dma_stream_t *stream, int target, const void *address) {
+    if (complete_next_write && stream->enabled) {
+        complete_next_write = false;
+        end_frame();
+        pending_isr = dma_isr;
+    }
+    if (stream->enabled && current_target() == target) {
+        return;
+    }
+    if (target) {
+        stream->stream->M1AR = (uintptr_t)address;
+    } else {
+        stream->stream->M0AR = (uintptr_t)address;
+    }
+}
+
+const uint8_t *mock_ws2812_frame(void) {
+    if (!pwm_stream || !pwm_stream->enabled) {
+        return NULL;
+    }
+    return (const uint8_t *)(current_target() ? pwm_stream->stream->M1AR : pwm_stream->stream->M0AR);
+}
+
+size_t mock_ws2812_frame_size(void) {
+    return pwm_stream ? pwm_stream->size : 0;
+}
+
+void mock_ws2812_transfer_complete(void) {
+    // The stream is circular, it runs until the driver stops it
+    if (pwm_stream && pwm_stream->enabled) {
+        end_frame();
+        dma_isr();
+    }
+}
+
+void mock_ws2812_transfer_complete_on_next_write(void) {
+    complete_next_write = true;
+}
+#endif
@@ -0,0 +1,186 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/*
+ * Just enough of ChibiOS for the SPI and PWM WS2812 drivers to run on the host.
+ * Transfers never finish on their own, the test ends them with mock_ws2812_transfer_complete().
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRUE 1
+#define FALSE 0
+
+#define CPU_CLOCK 72000000
+
+/* --- OS ------------------------------------------------------------------- */
+
+typedef uint32_t systime_t;
+
+systime_t chVTGetSystemTimeX(void);
+#define chVTTimeElapsedSinceX(start) ((systime_t)(chVTGetSystemTimeX() - (start)))
+#define TIME_I2US(interval) ((uint32_t)(interval))
+
+void osalSysLock(void);
+void osalSysUnlock(void);
+void osalSysLockFromISR(void);
+void osalSysUnlockFromISR(void);
+
+/* --- PAL ------------------------------------------------------------------ */
+
+typedef uint32_t ioline_t;
+
+#define PAL_MODE_ALTERNATE(n) (n)
+#define PAL_OUTPUT_TYPE_PUSHPULL 0
+#define PAL_OUTPUT_TYPE_OPENDRAIN 0
+#define PAL_OUTPUT_SPEED_HIGHEST 0
+#define PAL_PUPDR_FLOATING 0
+#define PAL_PORT(line) NULL
+#define PAL_PAD(line) 0
+#define palSetLineMode(line, mode) ((void)(line), (void)(mode))
+
+/* --- SPI ------------------------------------------------------------------ */
+
+typedef struct SPIDriver SPIDriver;
+typedef void (*spicallback_t)(SPIDriver *spip);
+
+typedef struct {
+    spicallback_t end_cb;
+    void         *ssport;
+    uint32_t      sspad;
+    uint16_t      cr1;
+    uint16_t      cr2;
+} SPIConfig;
+
+struct SPIDriver {
+    const SPIConfig *config;
+};
+
+extern SPIDriver SPID1;
+
+#define SPI_SUPPORTS_CIRCULAR FALSE
+#define SPI_CR1_BR_0 (1 << 3)
+#define SPI_CR1_BR_1 (1 << 4)
+#define SPI_CR1_BR_2 (1 << 5)
+
+void spiAcquireBus(SPIDriver *spip);
+void spiStart(SPIDriver *spip, const SPIConfig *config);
+void spiSelect(SPIDriver *spip);
+void spiStartSend(SPIDriver *spip, size_t n, const void *txbuf);
+void spiStartSendI(SPIDriver *spip, size_t n, const void *txbuf);
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf);
+
+/* --- DMA ------------------------------------------------------------------ */
+
+typedef void (*stm32_dmaisr_t)(void *param, uint32_t flags);
+
+typedef struct {
+    volatile uint32_t  CR;
+    volatile uintptr_t M0AR;
+    volatile uintptr_t M1AR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    DMA_Stream_TypeDef *stream;
+    size_t              size;
+    bool                enabled;
+    stm32_dmaisr_t      func;
+    void               *param;
+} stm32_dma_stream_t;
+
+extern stm32_dma_stream_t mock_dma_streams[8];
+
+#define STM32_DMA_STREAM(n) (&mock_dma_streams[(n)])
+#define STM32_DMA1_STREAM2 STM32_DMA_STREAM(2)
+#define STM32_DMA_SUPPORTS_DMAMUX FALSE
+#define AT32_DMA_SUPPORTS_DMAMUX FALSE
+
+#define STM32_DMA_CR_CHSEL(n) ((uint32_t)(n) << 25)
+#define STM32_DMA_CR_PL(n) ((uint32_t)(n) << 16)
+#define STM32_DMA_CR_DIR_M2P (1 << 6)
+#define STM32_DMA_CR_CIRC (1 << 8)
+#define STM32_DMA_CR_MINC (1 << 10)
+#define STM32_DMA_CR_PSIZE_HWORD (1 << 11)
+#define STM32_DMA_CR_PSIZE_WORD (2 << 11)
+#define STM32_DMA_CR_MSIZE_BYTE (0 << 13)
+#define STM32_DMA_CR_DBM (1 << 18)
+#define STM32_DMA_CR_CT (1 << 19)
+#define STM32_DMA_CR_TCIE (1 << 4)
+#define STM32_DMA_ISR_TCIF (1 << 5)
+
+const stm32_dma_stream_t *dmaStreamAlloc(uint32_t id, uint32_t priority, stm32_dmaisr_t func, void *param);
+/* Like the hardware, ignores writes to the memory register in use while the stream runs */
+void mock_dma_set_memory(stm32_dma_stream_t *stream, int target, const void *address);
+#define dmaStreamSetPeripheral(stream, address) ((void)(stream), (void)(address))
+#define dmaStreamSetMemory0(stream, address) mock_dma_set_memory((stream), 0, (address))
+#define dmaStreamSetMemory1(stream, address) mock_dma_set_memory((stream), 1, (address))
+#define dmaStreamSetTransactionSize(stream, n) ((stream)->size = (n))
+#define dmaStreamSetMode(dmastp, m) ((dmastp)->stream->CR = (m))
+#define dmaStreamEnable(stream) ((stream)->enabled = true)
+
+/* --- PWM ------------------------------------------------------------------ */
+
+typedef struct {
+    volatile uint32_t CCR[4];
+} stm32_tim_t;
+
+typedef struct PWMDriver PWMDriver;
+typedef void (*pwmcallback_t)(PWMDriver *pwmp);
+
+typedef struct {
+    uint32_t      mode;
+    pwmcallback_t callback;
+} PWMChannelConfig;
+
+typedef struct {
+    uint32_t         frequency;
+    uint32_t         period;
+    pwmcallback_t    callback;
+    PWMChannelConfig channels[4];
+    uint32_t         cr2;
+    uint32_t         dier;
+} PWMConfig;
+
+struct PWMDriver {
+    stm32_tim_t *tim;
+};
+
+extern PWMDriver PWMD2;
+
+#define PWM_OUTPUT_DISABLED 0
+#define PWM_OUTPUT_ACTIVE_HIGH 1
+#define PWM_COMPLEMENTARY_OUTPUT_ACTIVE_HIGH 2
+#define TIM_DIER_UDE (1 << 8)
+
+void pwmStart(PWMDriver *pwmp, const PWMConfig *config);
+void pwmEnableChannel(PWMDriver *pwmp, uint32_t channel, uint32_t width);
+
+/* --- Test helpers --------------------------------------------------------- */
+
+/* The frame the peripheral is clocking out right now, or NULL */
+const uint8_t *mock_ws2812_frame(void);
+
+/* Size of that frame in bytes */
+size_t mock_ws2812_frame_size(void);
+
+/* Runs the transfer complete interrupt, as at the end of the frame on the wire */
+void mock_ws2812_transfer_complete(void);
+
+/* Ends the frame on the wire right before the next write to a memory register, the interrupt runs once the
+   system lock is released */
+void mock_ws2812_transfer_complete_on_next_write(void);
+
+/* How deep the system lock is held, 0 outside of it */
+int mock_ws2812_lock_depth(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -23,3 +23,22 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+ws2812_DEFS := -DWS2812_DOUBLE_BUFFER -DWS2812_LED_COUNT=4 -DWS2812_DI_PIN=0
+ws2812_spi_DEFS := $(ws2812_DEFS) -DWS2812_SPI
+ws2812_pwm_DEFS := $(ws2812_DEFS) -DWS2812_PWM
+
+ws2812_spi_INC := $(PLATFORM_PATH)/chibios
+ws2812_pwm_INC := $(ws2812_spi_INC)
+
+ws2812_spi_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/ws2812_hal_mock.h
+ws2812_pwm_CONFIG := $(ws2812_spi_CONFIG)
+
+ws2812_spi_SRC := \
+	$(PLATFORM_PATH)/chibios/drivers/ws2812_spi.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/ws2812_hal_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_double_buffer_tests.cpp
+ws2812_pwm_SRC := \
+	$(PLATFORM_PATH)/chibios/drivers/ws2812_pwm.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/ws2812_hal_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_double_buffer_tests.cpp
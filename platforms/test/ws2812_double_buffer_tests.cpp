@@ -0,0 +1,225 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "ws2812.h"
+}
+
+struct color_t {
+    uint8_t r, g, b;
+
+    bool operator==(const color_t &other) const {
+        return r == other.r && g == other.g && b == other.b;
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const color_t &color) {
+    return os << "{" << (int)color.r << ", " << (int)color.g << ", " << (int)color.b << "}";
+}
+
+namespace {
+
+const color_t black  = {0, 0, 0};
+const color_t red    = {255, 0, 0};
+const color_t green  = {0, 255, 0};
+const color_t blue   = {0, 0, 255};
+const color_t purple = {0x80, 0x11, 0xC3};
+
+#if defined(WS2812_SPI)
+// Each byte carries two bits, after a 4 byte preamble
+uint8_t decode_byte(const uint8_t *encoded) {
+    uint8_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value = (value << 2) | (((encoded[i] >> 4) == 0b1110) << 1) | ((encoded[i] & 0xF) == 0b1110);
+    }
+    return value;
+}
+
+color_t decode_led(const uint8_t *frame, int index) {
+    const uint8_t *led = &frame[4 + 12 * index];
+    return {decode_byte(&led[4]), decode_byte(&led[0]), decode_byte(&led[8])};
+}
+#elif defined(WS2812_PWM)
+// One duty cycle per bit, MSB first
+uint8_t decode_byte(const uint8_t *duty_cycles) {
+    const uint32_t duty_0 = (CPU_CLOCK / 2) / (1000000000 / WS2812_T0H);
+    const uint32_t duty_1 = (CPU_CLOCK / 2) / (1000000000 / WS2812_T1H);
+    uint8_t        value  = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 1) | (duty_cycles[i] > (duty_0 + duty_1) / 2);
+    }
+    return value;
+}
+
+color_t decode_led(const uint8_t *frame, int index) {
+    const uint8_t *led = &frame[24 * index];
+    return {decode_byte(&led[8]), decode_byte(&led[0]), decode_byte(&led[16])};
+}
+#endif
+
+void set_color(int index, color_t color) {
+    ws2812_set_color(index, color.r, color.g, color.b);
+}
+
+void set_color_all(color_t color) {
+    ws2812_set_color_all(color.r, color.g, color.b);
+}
+
+} // namespace
+
+class Ws2812DoubleBuffer : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Let whatever the last test queued go out, then start from an all off chain on the wire
+        finish_transfers();
+        ws2812_init();
+        set_color_all(black);
+        ws2812_flush();
+        finish_transfers();
+        stats = ws2812_get_stats();
+    }
+
+    void TearDown() override {
+        EXPECT_EQ(mock_ws2812_lock_depth(), 0);
+    }
+
+    void finish_transfers() {
+        for (int i = 0; i < 3; i++) {
+            mock_ws2812_transfer_complete();
+        }
+    }
+
+    color_t sent(int index) {
+        const uint8_t *frame = mock_ws2812_frame();
+        EXPECT_NE(frame, nullptr);
+        return frame ? decode_led(frame, index) : black;
+    }
+
+    ws2812_stats_t stats;
+};
+
+TEST_F(Ws2812DoubleBuffer, FlushedFrameIsSent) {
+    set_color(0, red);
+    set_color(2, purple);
+    ws2812_flush();
+    mock_ws2812_transfer_complete();
+
+    EXPECT_EQ(sent(0), red);
+    EXPECT_EQ(sent(1), black);
+    EXPECT_EQ(sent(2), purple);
+    EXPECT_EQ(sent(3), black);
+}
+
+TEST_F(Ws2812DoubleBuffer, FrameOnTheWireIsNeverModified) {
+    set_color_all(red);
+    ws2812_flush();
+
+    const uint8_t       *frame = mock_ws2812_frame();
+    std::vector<uint8_t> before(frame, frame + mock_ws2812_frame_size());
+
+    // Queued behind the frame on the wire, replaced, and then LEDs set while it waits
+    set_color_all(green);
+    ws2812_flush();
+    set_color_all(blue);
+    ws2812_flush();
+    set_color(0, purple);
+
+    const uint8_t *still_sending = mock_ws2812_frame();
+    EXPECT_EQ(std::vector<uint8_t>(still_sending, still_sending + mock_ws2812_frame_size()), before);
+}
+
+TEST_F(Ws2812DoubleBuffer, FlushReplacesQueuedFrameWithoutWaiting) {
+    // Would never return if a flush waited for the transfer, nothing completes it until the end of the test
+    set_color_all(red);
+    ws2812_flush();
+    set_color_all(green);
+    ws2812_flush();
+    set_color_all(purple);
+    ws2812_flush();
+    set_color(1, blue);
+    ws2812_flush();
+
+    finish_transfers();
+    EXPECT_EQ(sent(0), purple);
+    EXPECT_EQ(sent(1), blue);
+    EXPECT_EQ(sent(2), purple);
+    EXPECT_EQ(sent(3), purple);
+
+    // Every flush was either sent or replaced by a newer one
+    ws2812_stats_t now = ws2812_get_stats();
+    EXPECT_GE(now.skipped - stats.skipped, 1u);
+    EXPECT_EQ((now.frames - stats.frames) + (now.skipped - stats.skipped), 4u);
+}
+
+TEST_F(Ws2812DoubleBuffer, LedsSetWhileQueuedAreSentWithNextFlush) {
+    set_color(0, red);
+    ws2812_flush();
+    mock_ws2812_transfer_complete();
+
+    set_color(1, green);
+    ws2812_flush();
+    // Set after the flush, so it only goes out with the next one
+    set_color(2, blue);
+    finish_transfers();
+    EXPECT_EQ(sent(0), red);
+    EXPECT_EQ(sent(1), green);
+    EXPECT_EQ(sent(2), black);
+
+    ws2812_flush();
+    finish_transfers();
+    EXPECT_EQ(sent(0), red);
+    EXPECT_EQ(sent(1), green);
+    EXPECT_EQ(sent(2), blue);
+    EXPECT_EQ(sent(3), black);
+}
+
+TEST_F(Ws2812DoubleBuffer, BothBuffersCatchUp) {
+    // Each frame only touches one LED, the other buffer still has to see every change
+    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+        set_color(i, purple);
+        ws2812_flush();
+        mock_ws2812_transfer_complete();
+        for (int j = 0; j < WS2812_LED_COUNT; j++) {
+            EXPECT_EQ(sent(j), j <= i ? purple : black) << "frame " << i << ", LED " << j;
+        }
+    }
+}
+
+#if defined(WS2812_PWM)
+TEST_F(Ws2812DoubleBuffer, FrameEndingDuringHandoverIsCaught) {
+    // The stream moves on between reading which memory register is idle and writing it
+    mock_ws2812_transfer_complete_on_next_write();
+    set_color_all(red);
+    ws2812_flush();
+    EXPECT_EQ(sent(0), black);
+
+    mock_ws2812_transfer_complete();
+    EXPECT_EQ(sent(0), red);
+    mock_ws2812_transfer_complete();
+    EXPECT_EQ(sent(0), red);
+}
+
+TEST_F(Ws2812DoubleBuffer, FrameEndingDuringTakeBackIsSent) {
+    set_color_all(red);
+    ws2812_flush();
+
+    // The queued frame starts before the next flush can take it back
+    mock_ws2812_transfer_complete_on_next_write();
+    set_color_all(green);
+    ws2812_flush();
+    EXPECT_EQ(sent(0), red);
+
+    mock_ws2812_transfer_complete();
+    EXPECT_EQ(sent(0), green);
+    mock_ws2812_transfer_complete();
+    EXPECT_EQ(sent(0), green);
+
+    ws2812_stats_t now = ws2812_get_stats();
+    EXPECT_EQ(now.skipped, stats.skipped);
+    EXPECT_EQ(now.frames - stats.frames, 2u);
+}
+#endif
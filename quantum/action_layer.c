@@ -6,6 +6,7 @@
 #include "encoder.h"
 #include "util.h"
 #include "action_layer.h"
+#include "state_change.h"
 
 /** \brief Default Layer State
  */
@@ -36,7 +37,10 @@ static void default_layer_state_set(layer_state_t state) {
     ac_dprintf("default_layer_state: ");
     default_layer_debug();
     ac_dprintf(" to ");
-    default_layer_state = state;
+    if (default_layer_state != state) {
+        default_layer_state = state;
+        state_publish(STATE_DEFAULT_LAYER);
+    }
     default_layer_debug();
     ac_dprintf("\n");
 #if defined(STRICT_LAYER_RELEASE)
@@ -116,7 +120,10 @@ void layer_state_set(layer_state_t state) {
     ac_dprintf("layer_state: ");
     layer_debug();
     ac_dprintf(" to ");
-    layer_state = state;
+    if (layer_state != state) {
+        layer_state = state;
+        state_publish(STATE_LAYER);
+    }
     layer_debug();
     ac_dprintf("\n");
 #    if defined(STRICT_LAYER_RELEASE)
@@ -454,6 +454,19 @@ bool waiting_buffer_enq(keyrecord_t record) {
     return true;
 }
 
+/** \brief Time left before a pressed tapping key turns into a hold
+ *
+ * \return milliseconds until the tapping term of the current tapping key ends, UINT32_MAX if there is none
+ */
+uint32_t action_tapping_next_timeout(void) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return UINT32_MAX;
+    }
+    uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+    return elapsed < term ? term - elapsed : UINT32_MAX;
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
@@ -22,6 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "timer.h"
 #include "keycode_config.h"
 #include "usb_device_state.h"
+#include "state_change.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -33,6 +34,13 @@ static uint8_t weak_override_mods = 0;
 static uint8_t suppressed_mods    = 0;
 #endif
 
+static void update_mods(uint8_t *target, uint8_t mods) {
+    if (*target != mods) {
+        *target = mods;
+        state_publish(STATE_MODS);
+    }
+}
+
 // TODO: pointer variable is not needed
 // report_keyboard_t keyboard_report = {};
 report_keyboard_t *keyboard_report = &(report_keyboard_t){};
@@ -53,24 +61,28 @@ uint8_t        get_oneshot_locked_mods(void) {
 void add_oneshot_locked_mods(uint8_t mods) {
     if ((oneshot_locked_mods & mods) != mods) {
         oneshot_locked_mods |= mods;
+        state_publish(STATE_MODS);
         oneshot_locked_mods_changed_kb(oneshot_locked_mods);
     }
 }
 void set_oneshot_locked_mods(uint8_t mods) {
     if (mods != oneshot_locked_mods) {
         oneshot_locked_mods = mods;
+        state_publish(STATE_MODS);
         oneshot_locked_mods_changed_kb(oneshot_locked_mods);
     }
 }
 void clear_oneshot_locked_mods(void) {
     if (oneshot_locked_mods) {
         oneshot_locked_mods = 0;
+        state_publish(STATE_MODS);
         oneshot_locked_mods_changed_kb(oneshot_locked_mods);
     }
 }
 void del_oneshot_locked_mods(uint8_t mods) {
     if (oneshot_locked_mods & mods) {
         oneshot_locked_mods &= ~mods;
+        state_publish(STATE_MODS);
         oneshot_locked_mods_changed_kb(oneshot_locked_mods);
     }
 }
@@ -341,28 +353,28 @@ uint8_t get_mods(void) {
  * FIXME: needs doc
  */
 void add_mods(uint8_t mods) {
-    real_mods |= mods;
+    update_mods(&real_mods, real_mods | mods);
 }
 /** \brief del mods
  *
  * FIXME: needs doc
  */
 void del_mods(uint8_t mods) {
-    real_mods &= ~mods;
+    update_mods(&real_mods, real_mods & ~mods);
 }
 /** \brief set mods
  *
  * FIXME: needs doc
  */
 void set_mods(uint8_t mods) {
-    real_mods = mods;
+    update_mods(&real_mods, mods);
 }
 /** \brief clear mods
  *
  * FIXME: needs doc
  */
 void clear_mods(void) {
-    real_mods = 0;
+    update_mods(&real_mods, 0);
 }
 
 /** \brief get weak mods
@@ -377,28 +389,28 @@ uint8_t get_weak_mods(void) {
  * FIXME: needs doc
  */
 void add_weak_mods(uint8_t mods) {
-    weak_mods |= mods;
+    update_mods(&weak_mods, weak_mods | mods);
 }
 /** \brief del weak mods
  *
  * FIXME: needs doc
  */
 void del_weak_mods(uint8_t mods) {
-    weak_mods &= ~mods;
+    update_mods(&weak_mods, weak_mods & ~mods);
 }
 /** \brief set weak mods
  *
  * FIXME: needs doc
  */
 void set_weak_mods(uint8_t mods) {
-    weak_mods = mods;
+    update_mods(&weak_mods, mods);
 }
 /** \brief clear weak mods
  *
  * FIXME: needs doc
  */
 void clear_weak_mods(void) {
-    weak_mods = 0;
+    update_mods(&weak_mods, 0);
 }
 
 #ifdef KEY_OVERRIDE_ENABLE
@@ -440,6 +452,7 @@ void add_oneshot_mods(uint8_t mods) {
         oneshot_time = timer_read();
 #    endif
         oneshot_mods |= mods;
+        state_publish(STATE_MODS);
         oneshot_mods_changed_kb(mods);
     }
 }
@@ -450,6 +463,7 @@ void del_oneshot_mods(uint8_t mods) {
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
         oneshot_time = oneshot_mods ? timer_read() : 0;
 #    endif
+        state_publish(STATE_MODS);
         oneshot_mods_changed_kb(oneshot_mods);
     }
 }
@@ -465,6 +479,7 @@ void set_oneshot_mods(uint8_t mods) {
             oneshot_time = timer_read();
 #    endif
             oneshot_mods = mods;
+            state_publish(STATE_MODS);
             oneshot_mods_changed_kb(mods);
         }
     }
@@ -480,6 +495,7 @@ void clear_oneshot_mods(void) {
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
         oneshot_time = 0;
 #    endif
+        state_publish(STATE_MODS);
         oneshot_mods_changed_kb(oneshot_mods);
     }
 }
@@ -80,6 +80,9 @@ musical_tone_t tones[AUDIO_TONE_STACKSIZE]; // stack of currently active tones
 bool playing_melody = false; // playing a SONG?
 bool playing_note   = false; // or (possibly multiple simultaneous) tones
 bool state_changed  = false; // global flag, which is set if anything changes with the active_tones
+#ifdef AUDIO_CLIP_ENABLE
+bool playing_clip = false; // streaming a PCM clip, mixed with the tones
+#endif
 
 // melody/SONG related state variables
 float (*notes_pointer)[][2];                           // SONG, an array of MUSICAL_NOTEs
@@ -235,6 +238,10 @@ void audio_stop_all(void) {
 
     playing_melody = false;
     playing_note   = false;
+#ifdef AUDIO_CLIP_ENABLE
+    audio_clip_stop();
+    playing_clip = false;
+#endif
 
     melody_current_note_duration = 0;
 
@@ -279,9 +286,15 @@ void audio_stop_tone(float pitch) {
         }
 #endif
         if (active_tones == 0) {
+            playing_note = false;
             audio_driver_stop();
+#ifdef AUDIO_CLIP_ENABLE
+            // only the tones fade out, the clip keeps the driver running until audio_update_state sees it's over
+            if (playing_clip) {
+                return;
+            }
+#endif
             audio_driver_stopped = true;
-            playing_note         = false;
         }
     }
 }
@@ -402,6 +415,30 @@ bool audio_is_playing_melody(void) {
     return playing_melody;
 }
 
+#ifdef AUDIO_CLIP_ENABLE
+void audio_play_clip(const audio_clip_t *clip) {
+    if (!audio_config.enable) {
+        return;
+    }
+
+    if (!audio_initialized) {
+        audio_init();
+    }
+
+    audio_clip_start(clip);
+    playing_clip = true;
+
+    if (audio_driver_stopped) {
+        audio_driver_start();
+        audio_driver_stopped = false;
+    }
+}
+
+bool audio_is_playing_clip(void) {
+    return playing_clip;
+}
+#endif
+
 uint8_t audio_get_number_of_active_tones(void) {
     return active_tones;
 }
@@ -435,6 +472,16 @@ float audio_get_processed_frequency(uint8_t tone_index) {
 }
 
 bool audio_update_state(void) {
+#ifdef AUDIO_CLIP_ENABLE
+    if (playing_clip && !audio_clip_is_playing()) {
+        playing_clip = false;
+        if (!playing_note && !playing_melody) {
+            audio_driver_stop();
+            audio_driver_stopped = true;
+        }
+    }
+#endif
+
     if (!playing_note && !playing_melody) {
         return false;
     }
@@ -170,6 +170,27 @@ bool audio_is_playing_note(void);
  */
 bool audio_is_playing_melody(void);
 
+#ifdef AUDIO_CLIP_ENABLE
+#    include "audio_clip.h"
+
+/**
+ * @brief play a precompressed PCM clip from flash
+ *
+ * @details the clip is mixed with the tones and melodies that play at the
+ *          same time, starting another clip replaces the current one. Only
+ *          drivers that compute their samples can stream clips, currently
+ *          AUDIO_DRIVER = dac_additive
+ *
+ * @param[in] clip: generated with `qmk audio-convert-clip`
+ */
+void audio_play_clip(const audio_clip_t *clip);
+
+/**
+ * @brief query if a clip is playing
+ */
+bool audio_is_playing_clip(void);
+#endif
+
 // These macros are used to allow audio_play_melody to play an array of indeterminate
 // length. This works around the limitation of C's sizeof operation on pointers.
 // The global float array for the song must be used here.
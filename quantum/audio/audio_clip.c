@@ -0,0 +1,108 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+
+#include "audio_clip.h"
+#include "atomic_util.h"
+
+// clang-format off
+static const int16_t adpcm_steps[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,    31,
+    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,   130,   143,
+    157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,   544,   598,   658,
+    724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,
+    3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+// clang-format on
+
+static const int8_t adpcm_index_changes[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+// Cleared by the driver's interrupt once the clip is over
+static const audio_clip_t *volatile clip = NULL;
+static uint32_t            output_rate;
+
+static uint32_t position;  // samples decoded so far
+static uint32_t phase;     // position at the output rate, Q16.16
+static uint32_t step;      // clip samples per output sample, Q16.16
+static int16_t  current;   // last decoded sample
+static int32_t  predictor; // ADPCM state
+static uint8_t  step_index;
+
+static int16_t decode_ulaw(uint8_t value) {
+    value             = ~value;
+    uint8_t exponent  = (value >> 4) & 0x07;
+    int16_t magnitude = ((((value & 0x0F) << 3) + 0x84) << exponent) - 0x84;
+    return (value & 0x80) ? -magnitude : magnitude;
+}
+
+static int16_t decode_adpcm(uint8_t nibble) {
+    int32_t adpcm_step = adpcm_steps[step_index];
+    int32_t difference = adpcm_step >> 3;
+
+    if (nibble & 4) difference += adpcm_step;
+    if (nibble & 2) difference += adpcm_step >> 1;
+    if (nibble & 1) difference += adpcm_step >> 2;
+    predictor += (nibble & 8) ? -difference : difference;
+    predictor = predictor < INT16_MIN ? INT16_MIN : (predictor > INT16_MAX ? INT16_MAX : predictor);
+
+    int8_t index = step_index + adpcm_index_changes[nibble & 7];
+    step_index   = index < 0 ? 0 : (index > 88 ? 88 : index);
+    return predictor;
+}
+
+static int16_t decode_next(void) {
+    uint32_t index = position++;
+
+    switch (clip->encoding) {
+        case AUDIO_CLIP_ULAW:
+            return decode_ulaw(clip->data[index]);
+        case AUDIO_CLIP_IMA_ADPCM:
+            return decode_adpcm((clip->data[index / 2] >> ((index & 1) * 4)) & 0x0F);
+    }
+    return 0;
+}
+
+void audio_clip_init(uint32_t rate) {
+    output_rate = rate;
+}
+
+void audio_clip_start(const audio_clip_t *new_clip) {
+    // The driver may be rendering from an interrupt, which mustn't see a partially reset decoder
+    ATOMIC_BLOCK_FORCEON {
+        position   = 0;
+        phase      = 0;
+        step       = ((uint32_t)new_clip->sample_rate << 16) / output_rate;
+        current    = 0;
+        predictor  = 0;
+        step_index = 0;
+        clip       = new_clip;
+    }
+}
+
+void audio_clip_stop(void) {
+    clip = NULL;
+}
+
+bool audio_clip_is_playing(void) {
+    return clip != NULL;
+}
+
+int16_t audio_clip_render(void) {
+    if (!clip) {
+        return 0;
+    }
+
+    uint32_t target = phase >> 16;
+    if (target >= clip->samples) {
+        clip = NULL;
+        return 0;
+    }
+    // Sequential decoding, every sample of the clip goes through the decoder even when it's skipped
+    while (position <= target) {
+        current = decode_next();
+    }
+    phase += step;
+    return current;
+}
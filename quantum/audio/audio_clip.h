@@ -0,0 +1,38 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Precompressed PCM clips, streamed from flash by the drivers that compute
+ * their samples. `qmk audio-convert-clip` turns a WAV file into a clip. */
+
+typedef enum {
+    AUDIO_CLIP_ULAW,      // 8 bits per sample, G.711 u-law
+    AUDIO_CLIP_IMA_ADPCM, // 4 bits per sample, IMA ADPCM, low nibble first
+} audio_clip_encoding_t;
+
+typedef struct {
+    const uint8_t        *data;
+    uint32_t              samples;
+    uint16_t              sample_rate;
+    audio_clip_encoding_t encoding;
+} audio_clip_t;
+
+/**
+ * @brief Sets the rate the driver asks for samples at, clips are resampled to it.
+ */
+void audio_clip_init(uint32_t output_rate);
+
+void audio_clip_start(const audio_clip_t *clip);
+void audio_clip_stop(void);
+bool audio_clip_is_playing(void);
+
+/**
+ * @brief Decodes the next sample at the output rate.
+ *
+ * @return int16_t The sample, 0 once the clip is over.
+ */
+int16_t audio_clip_render(void);
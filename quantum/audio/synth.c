@@ -0,0 +1,219 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+
+#include "synth.h"
+
+// Levels are kept with 8 more bits than SYNTH_LEVEL_MAX, so that slow envelopes still move every sample
+#define LEVEL_SHIFT 8
+#define LEVEL_FULL ((uint32_t)SYNTH_LEVEL_MAX << LEVEL_SHIFT)
+
+typedef enum {
+    VOICE_OFF,
+    VOICE_ATTACK,
+    VOICE_DECAY,
+    VOICE_SUSTAIN,
+    VOICE_RELEASE,
+} voice_stage_t;
+
+typedef struct {
+    uint32_t      phase;
+    uint32_t      increment;
+    uint32_t      level;
+    voice_stage_t stage;
+} synth_voice_t;
+
+static const uint16_t *wavetable;
+static uint8_t         phase_shift;
+static uint16_t        center;
+static uint32_t        sample_rate;
+static uint32_t        start_phase;
+
+static uint32_t attack_step;
+static uint32_t decay_step;
+static uint32_t sustain_level;
+static uint32_t release_step;
+
+static synth_voice_t voices[SYNTH_VOICES];
+// Q15 reciprocal of the number of sounding voices, so mixing needs no division
+static int32_t gain = 0;
+
+static void update_gain(void) {
+    uint8_t sounding = synth_active_voices();
+    gain             = sounding ? SYNTH_LEVEL_MAX / sounding : 0;
+}
+
+static uint32_t step_for(uint16_t ms, uint32_t span) {
+    uint32_t samples = (uint64_t)ms * sample_rate / 1000;
+    if (samples == 0) {
+        return LEVEL_FULL;
+    }
+    uint32_t step = span / samples;
+    return step ? step : 1;
+}
+
+void synth_init(const uint16_t *table, uint8_t wavetable_bits, uint16_t silence, uint32_t rate) {
+    wavetable   = table;
+    phase_shift = 32 - wavetable_bits;
+    center      = silence;
+    sample_rate = rate;
+
+    // New voices start where the waveform is closest to silence, so they don't click in
+    uint16_t closest = 0xFFFF;
+    for (uint32_t i = 0; i < (1UL << wavetable_bits); i++) {
+        uint16_t distance = table[i] > silence ? table[i] - silence : silence - table[i];
+        if (distance < closest) {
+            closest     = distance;
+            start_phase = i << phase_shift;
+        }
+    }
+
+    synth_envelope_t instant = {.attack = 0, .decay = 0, .sustain = SYNTH_LEVEL_MAX, .release = 0};
+    synth_set_envelope(&instant);
+    synth_reset();
+}
+
+void synth_set_envelope(const synth_envelope_t *envelope) {
+    uint16_t sustain = envelope->sustain < SYNTH_LEVEL_MAX ? envelope->sustain : SYNTH_LEVEL_MAX;
+
+    sustain_level = (uint32_t)sustain << LEVEL_SHIFT;
+    attack_step   = step_for(envelope->attack, LEVEL_FULL);
+    decay_step    = step_for(envelope->decay, LEVEL_FULL - sustain_level);
+    release_step  = step_for(envelope->release, sustain_level);
+}
+
+void synth_reset(void) {
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+        voices[i] = (synth_voice_t){0};
+    }
+    update_gain();
+}
+
+static synth_voice_t *free_voice(void) {
+    synth_voice_t *quietest = NULL;
+
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+        if (voices[i].stage == VOICE_OFF) {
+            return &voices[i];
+        }
+        // Otherwise cut the quietest release short
+        if (voices[i].stage == VOICE_RELEASE && (!quietest || voices[i].level < quietest->level)) {
+            quietest = &voices[i];
+        }
+    }
+    return quietest;
+}
+
+void synth_set_tones(const uint32_t *frequencies, uint8_t count) {
+    uint32_t increments[SYNTH_VOICES];
+    bool     placed[SYNTH_VOICES] = {false};
+
+    count = count < SYNTH_VOICES ? count : SYNTH_VOICES;
+    for (uint8_t i = 0; i < count; i++) {
+        increments[i] = (((uint64_t)frequencies[i] << 16) + sample_rate / 2) / sample_rate;
+    }
+
+    // Tones that carry on keep their voice, the other voices stop
+    for (uint8_t v = 0; v < SYNTH_VOICES; v++) {
+        synth_voice_t *voice = &voices[v];
+        if (voice->stage == VOICE_OFF) {
+            continue;
+        }
+
+        uint8_t i = 0;
+        while (i < count && (placed[i] || increments[i] != voice->increment)) {
+            i++;
+        }
+        if (i < count) {
+            placed[i] = true;
+            if (voice->stage == VOICE_RELEASE) {
+                voice->stage = VOICE_ATTACK;
+            }
+        } else if (voice->stage != VOICE_RELEASE) {
+            // Without a release there is nothing left to play
+            voice->stage = voice->level > release_step ? VOICE_RELEASE : VOICE_OFF;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (placed[i] || increments[i] == 0) {
+            continue;
+        }
+        synth_voice_t *voice = free_voice();
+        if (!voice) {
+            break;
+        }
+        *voice = (synth_voice_t){.phase = start_phase, .increment = increments[i], .level = 0, .stage = VOICE_ATTACK};
+    }
+    update_gain();
+}
+
+uint16_t synth_render(void) {
+    int32_t sum       = 0;
+    bool    finishing = false;
+
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+        synth_voice_t *voice = &voices[i];
+
+        switch (voice->stage) {
+            case VOICE_OFF:
+                continue;
+            case VOICE_ATTACK:
+                if (voice->level + attack_step < LEVEL_FULL) {
+                    voice->level += attack_step;
+                    break;
+                }
+                voice->level = LEVEL_FULL;
+                voice->stage = VOICE_DECAY;
+                // fall through
+            case VOICE_DECAY:
+                if (voice->level > sustain_level + decay_step) {
+                    voice->level -= decay_step;
+                } else {
+                    voice->level = sustain_level;
+                    voice->stage = VOICE_SUSTAIN;
+                }
+                break;
+            case VOICE_SUSTAIN:
+                break;
+            case VOICE_RELEASE:
+                if (voice->level > release_step) {
+                    voice->level -= release_step;
+                    break;
+                }
+                voice->stage = VOICE_OFF;
+                finishing    = true;
+                continue;
+        }
+
+        voice->phase += voice->increment;
+        int32_t sample = (int32_t)wavetable[voice->phase >> phase_shift] - center;
+        if (voice->level != LEVEL_FULL) {
+            sample = (sample * (int32_t)(voice->level >> LEVEL_SHIFT)) >> 15;
+        }
+        sum += sample;
+    }
+
+    int32_t value = center + ((sum * gain) >> 15);
+    if (finishing) {
+        update_gain();
+    }
+    return value < 0 ? 0 : (value > 0xFFFF ? 0xFFFF : value);
+}
+
+void synth_render_buffer(uint16_t *buffer, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = synth_render();
+    }
+}
+
+uint8_t synth_active_voices(void) {
+    uint8_t sounding = 0;
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+        if (voices[i].stage != VOICE_OFF) {
+            sounding++;
+        }
+    }
+    return sounding;
+}
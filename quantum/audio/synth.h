@@ -0,0 +1,67 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Fixed point wavetable synthesis, for drivers that compute their samples.
+ *
+ * Every voice steps through the wavetable with a 32 bit phase accumulator
+ * and is scaled by an integer ADSR envelope, so rendering a sample takes
+ * no floating point math and no division. */
+
+#ifndef SYNTH_VOICES
+#    ifdef AUDIO_MAX_SIMULTANEOUS_TONES
+#        define SYNTH_VOICES AUDIO_MAX_SIMULTANEOUS_TONES
+#    else
+#        define SYNTH_VOICES 8
+#    endif
+#endif
+
+// Envelope levels are Q15, full level leaves the wavetable values as they are
+#define SYNTH_LEVEL_MAX 0x8000
+
+// Frequencies are passed in 1/65536 Hz
+#define SYNTH_FREQUENCY(hz) ((uint32_t)((hz)*65536.0 + 0.5))
+
+typedef struct {
+    uint16_t attack;  // ms from silence to full level
+    uint16_t decay;   // ms from full level down to the sustain level
+    uint16_t sustain; // level held while the tone plays, up to SYNTH_LEVEL_MAX
+    uint16_t release; // ms from the sustain level to silence once the tone stopped
+} synth_envelope_t;
+
+/**
+ * @brief Sets up the synth and silences all voices.
+ *
+ * @param wavetable One period of the waveform, its length a power of two.
+ * @param wavetable_bits log2 of the wavetable length.
+ * @param center Value of silence, the envelope scales the wavetable around it.
+ * @param sample_rate Samples per second that get rendered.
+ */
+void synth_init(const uint16_t *wavetable, uint8_t wavetable_bits, uint16_t center, uint32_t sample_rate);
+
+void synth_set_envelope(const synth_envelope_t *envelope);
+
+/**
+ * @brief Sets the tones that play from now on.
+ *
+ * Voices that keep playing the same frequency keep their phase and envelope,
+ * new ones start their attack, the others release.
+ *
+ * @param frequencies In 1/65536 Hz, see SYNTH_FREQUENCY().
+ */
+void synth_set_tones(const uint32_t *frequencies, uint8_t count);
+
+// Silences all voices immediately and restarts their phase
+void synth_reset(void);
+
+// Renders the next sample, the average of all voices that are sounding
+uint16_t synth_render(void);
+
+void synth_render_buffer(uint16_t *buffer, size_t length);
+
+// Number of voices still sounding, releasing ones included
+uint8_t synth_active_voices(void);
@@ -0,0 +1,182 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "audio_clip.h"
+}
+
+namespace {
+
+// The additive DAC driver with AUDIO_DAC_QUALITY_SANE_MINIMUM
+const uint32_t output_rate = 16384 * 3 / 2;
+
+std::vector<int16_t> sine(uint32_t rate, float frequency, size_t samples) {
+    std::vector<int16_t> pcm(samples);
+    for (size_t i = 0; i < samples; i++) {
+        pcm[i] = std::lround(24000 * std::sin(2 * M_PI * frequency * i / rate));
+    }
+    return pcm;
+}
+
+// G.711, as lib/python/qmk/audio_clip.py encodes it
+std::vector<uint8_t> encode_ulaw(const std::vector<int16_t> &pcm) {
+    std::vector<uint8_t> data;
+    for (int32_t sample : pcm) {
+        uint8_t sign      = sample < 0 ? 0x80 : 0;
+        int32_t magnitude = std::min<int32_t>(std::abs(sample), 32635) + 0x84;
+        uint8_t exponent  = 7;
+        while (exponent > 0 && !(magnitude & (0x4000 >> (7 - exponent)))) {
+            exponent--;
+        }
+        uint8_t mantissa = (magnitude >> (exponent + 3)) & 0x0F;
+        data.push_back(~(sign | (exponent << 4) | mantissa));
+    }
+    return data;
+}
+
+// IMA ADPCM, as lib/python/qmk/audio_clip.py encodes it
+std::vector<uint8_t> encode_adpcm(const std::vector<int16_t> &pcm) {
+    static const int16_t steps[89] = {7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+    static const int8_t  index_changes[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+    std::vector<uint8_t> data((pcm.size() + 1) / 2);
+    int32_t              predictor = 0;
+    int32_t              index     = 0;
+    for (size_t i = 0; i < pcm.size(); i++) {
+        int32_t step       = steps[index];
+        int32_t delta      = pcm[i] - predictor;
+        uint8_t nibble     = delta < 0 ? 8 : 0;
+        int32_t difference = step >> 3;
+        delta              = std::abs(delta);
+        for (uint8_t bit = 4; bit; bit >>= 1) {
+            if (delta >= step) {
+                nibble |= bit;
+                delta -= step;
+                difference += step;
+            }
+            step >>= 1;
+        }
+        predictor += (nibble & 8) ? -difference : difference;
+        predictor = std::max<int32_t>(INT16_MIN, std::min<int32_t>(predictor, INT16_MAX));
+        index     = std::max<int32_t>(0, std::min<int32_t>(index + index_changes[nibble & 7], 88));
+        data[i / 2] |= nibble << ((i & 1) * 4);
+    }
+    return data;
+}
+
+std::vector<int16_t> play(const audio_clip_t &clip) {
+    std::vector<int16_t> output;
+    audio_clip_start(&clip);
+    while (true) {
+        int16_t sample = audio_clip_render();
+        if (!audio_clip_is_playing()) {
+            break;
+        }
+        output.push_back(sample);
+    }
+    return output;
+}
+
+double snr(const std::vector<int16_t> &reference, const std::vector<int16_t> &decoded) {
+    double signal = 0, noise = 0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        signal += double(reference[i]) * reference[i];
+        noise += double(reference[i] - decoded[i]) * (reference[i] - decoded[i]);
+    }
+    return 10 * std::log10(signal / noise);
+}
+
+} // namespace
+
+class AudioClip : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        audio_clip_stop();
+        audio_clip_init(output_rate);
+    }
+};
+
+TEST_F(AudioClip, DecodesUlaw) {
+    const uint8_t data[] = {0xFF, 0x7F, 0x80, 0x00, 0xFE, 0x7E};
+    audio_clip_t  clip   = {.data = data, .samples = sizeof(data), .sample_rate = output_rate, .encoding = AUDIO_CLIP_ULAW};
+
+    std::vector<int16_t> expected = {0, 0, 32124, -32124, 8, -8};
+    EXPECT_EQ(play(clip), expected);
+}
+
+TEST_F(AudioClip, UlawKeepsTheSignal) {
+    std::vector<int16_t> pcm  = sine(output_rate, 440, output_rate / 10);
+    std::vector<uint8_t> data = encode_ulaw(pcm);
+    audio_clip_t         clip = {.data = data.data(), .samples = (uint32_t)pcm.size(), .sample_rate = output_rate, .encoding = AUDIO_CLIP_ULAW};
+
+    std::vector<int16_t> decoded = play(clip);
+    ASSERT_EQ(decoded.size(), pcm.size());
+    EXPECT_GT(snr(pcm, decoded), 35.0);
+}
+
+TEST_F(AudioClip, AdpcmKeepsTheSignal) {
+    std::vector<int16_t> pcm  = sine(output_rate, 440, output_rate / 10 + 1);
+    std::vector<uint8_t> data = encode_adpcm(pcm);
+    audio_clip_t         clip = {.data = data.data(), .samples = (uint32_t)pcm.size(), .sample_rate = output_rate, .encoding = AUDIO_CLIP_IMA_ADPCM};
+
+    auto                 start   = std::chrono::steady_clock::now();
+    std::vector<int16_t> decoded = play(clip);
+    auto                 elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(decoded.size(), pcm.size());
+    // Skip the first few ms while the step size adapts to the signal
+    std::vector<int16_t> settled_pcm(pcm.begin() + 100, pcm.end());
+    std::vector<int16_t> settled(decoded.begin() + 100, decoded.end());
+    EXPECT_GT(snr(settled_pcm, settled), 25.0);
+    RecordProperty("ns_per_sample", std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / pcm.size());
+}
+
+TEST_F(AudioClip, RestartResetsTheDecoder) {
+    std::vector<int16_t> pcm  = sine(8000, 1000, 400);
+    std::vector<uint8_t> data = encode_adpcm(pcm);
+    audio_clip_t         clip = {.data = data.data(), .samples = (uint32_t)pcm.size(), .sample_rate = 8000, .encoding = AUDIO_CLIP_IMA_ADPCM};
+
+    audio_clip_start(&clip);
+    for (int i = 0; i < 100; i++) {
+        audio_clip_render();
+    }
+    std::vector<int16_t> restarted = play(clip);
+    EXPECT_EQ(restarted, play(clip));
+}
+
+TEST_F(AudioClip, ResamplesToTheOutputRate) {
+    std::vector<int16_t> pcm  = sine(8000, 500, 800);
+    std::vector<uint8_t> data = encode_ulaw(pcm);
+    audio_clip_t         clip = {.data = data.data(), .samples = (uint32_t)pcm.size(), .sample_rate = 8000, .encoding = AUDIO_CLIP_ULAW};
+
+    std::vector<int16_t> decoded = play(clip);
+    // 100ms of audio at the output rate
+    EXPECT_NEAR(decoded.size(), output_rate / 10, 2);
+
+    // Every clip sample is held for about three output samples
+    std::vector<int16_t> reference;
+    for (size_t i = 0; i < decoded.size(); i++) {
+        reference.push_back(pcm[std::min<size_t>(i * 8000 / output_rate, pcm.size() - 1)]);
+    }
+    EXPECT_GT(snr(reference, decoded), 20.0);
+}
+
+TEST_F(AudioClip, SilentOnceOver) {
+    const uint8_t data[] = {0x80, 0x80};
+    audio_clip_t  clip   = {.data = data, .samples = sizeof(data), .sample_rate = output_rate, .encoding = AUDIO_CLIP_ULAW};
+
+    EXPECT_EQ(play(clip).size(), 2u);
+    EXPECT_FALSE(audio_clip_is_playing());
+    EXPECT_EQ(audio_clip_render(), 0);
+
+    audio_clip_start(&clip);
+    audio_clip_stop();
+    EXPECT_FALSE(audio_clip_is_playing());
+    EXPECT_EQ(audio_clip_render(), 0);
+}
@@ -0,0 +1,13 @@
+synth_DEFS := -DSYNTH_VOICES=4
+synth_INC := $(QUANTUM_PATH)/audio
+
+synth_SRC := \
+	$(QUANTUM_PATH)/audio/synth.c \
+	$(QUANTUM_PATH)/audio/tests/synth_tests.cpp
+
+audio_clip_DEFS := -DIGNORE_ATOMIC_BLOCK
+audio_clip_INC := $(QUANTUM_PATH)/audio
+
+audio_clip_SRC := \
+	$(QUANTUM_PATH)/audio/audio_clip.c \
+	$(QUANTUM_PATH)/audio/tests/audio_clip_tests.cpp
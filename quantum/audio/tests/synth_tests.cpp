@@ -0,0 +1,241 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "synth.h"
+#include "musical_notes.h"
+}
+
+namespace {
+
+// The additive DAC driver with AUDIO_DAC_QUALITY_SANE_MINIMUM, 16384Hz on a timer that runs 3/2 as fast
+const uint32_t sample_rate = 16384 * 3 / 2;
+const uint16_t center      = 2048;
+
+struct Note {
+    std::vector<float> tones;
+    uint32_t           samples;
+};
+
+std::vector<uint16_t> sine_table() {
+    std::vector<uint16_t> table(256);
+    // Starts at 0 like dac_buffer_sine, index 64 is silence
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = std::lround(2048 - 2047 * std::cos(2 * M_PI * i / table.size()));
+    }
+    return table;
+}
+
+const std::vector<uint16_t> wavetable = sine_table();
+
+uint32_t ms(uint32_t milliseconds) {
+    return milliseconds * sample_rate / 1000;
+}
+
+std::vector<uint16_t> render(const std::vector<Note> &melody) {
+    std::vector<uint16_t> output;
+    for (const Note &note : melody) {
+        std::vector<uint32_t> frequencies;
+        for (float tone : note.tones) {
+            frequencies.push_back(SYNTH_FREQUENCY(tone));
+        }
+        synth_set_tones(frequencies.data(), frequencies.size());
+
+        size_t start = output.size();
+        output.resize(start + note.samples);
+        synth_render_buffer(&output[start], note.samples);
+    }
+    return output;
+}
+
+/* What the float code of the additive DAC driver did, in double precision:
+ * every tone keeps a fractional wavetable index, tones that continue from
+ * one note to the next keep it, new ones start at silence.
+ *
+ * Many notes land exactly on a table entry every few samples, where either
+ * neighbour is right depending on rounding, those samples are marked. */
+std::vector<uint16_t> render_reference(const std::vector<Note> &melody, std::vector<bool> *ambiguous) {
+    std::vector<uint16_t>                 output;
+    std::vector<std::pair<float, double>> playing;
+
+    for (const Note &note : melody) {
+        std::vector<std::pair<float, double>> next;
+        for (float tone : note.tones) {
+            auto found = std::find_if(playing.begin(), playing.end(), [tone](const std::pair<float, double> &p) { return p.first == tone; });
+            next.emplace_back(tone, found != playing.end() ? found->second : 64.0);
+        }
+        playing = next;
+
+        for (uint32_t s = 0; s < note.samples; s++) {
+            int32_t sum  = 0;
+            bool    tied = false;
+            for (auto &voice : playing) {
+                voice.second = std::fmod(voice.second + static_cast<double>(voice.first) * wavetable.size() / sample_rate, wavetable.size());
+                sum += wavetable[static_cast<size_t>(voice.second)] - center;
+                tied |= std::abs(voice.second - std::round(voice.second)) < 1e-6;
+            }
+            output.push_back(playing.empty() ? center : center + sum / static_cast<int32_t>(playing.size()));
+            ambiguous->push_back(tied);
+        }
+    }
+    return output;
+}
+
+// Largest step between neighbouring wavetable entries, the most one index off can change a sample by
+int32_t max_table_step() {
+    int32_t step = 0;
+    for (size_t i = 0; i < wavetable.size(); i++) {
+        step = std::max(step, std::abs(wavetable[(i + 1) % wavetable.size()] - wavetable[i]));
+    }
+    return step;
+}
+
+void expect_matches_reference(const std::vector<Note> &melody) {
+    std::vector<bool>     ambiguous;
+    std::vector<uint16_t> output    = render(melody);
+    std::vector<uint16_t> reference = render_reference(melody, &ambiguous);
+    ASSERT_EQ(output.size(), reference.size());
+
+    size_t  differing = 0;
+    int32_t worst     = 0;
+    for (size_t i = 0; i < output.size(); i++) {
+        int32_t difference = std::abs(output[i] - reference[i]);
+        // Mixing rounds by one at most
+        differing += difference > 1 && !ambiguous[i];
+        worst = std::max(worst, difference);
+    }
+    // Only where the phase is a hair away from the next index
+    EXPECT_LE(differing, output.size() / 1000);
+    EXPECT_LE(worst, max_table_step());
+}
+
+uint16_t peak(const std::vector<uint16_t> &output, size_t from, size_t to) {
+    uint16_t highest = 0;
+    for (size_t i = from; i < to; i++) {
+        highest = std::max(highest, output[i]);
+    }
+    return highest - center;
+}
+
+} // namespace
+
+class Synth : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        synth_init(wavetable.data(), 8, center, sample_rate);
+    }
+};
+
+TEST_F(Synth, SilentWithoutTones) {
+    std::vector<uint16_t> output = render({{{}, 100}});
+    EXPECT_TRUE(std::all_of(output.begin(), output.end(), [](uint16_t sample) { return sample == center; }));
+    EXPECT_EQ(synth_active_voices(), 0);
+}
+
+TEST_F(Synth, MelodyMatchesReference) {
+    expect_matches_reference({
+        {{NOTE_C4}, ms(250)},
+        {{NOTE_E4}, ms(250)},
+        {{NOTE_G4}, ms(250)},
+        {{}, ms(100)},
+        {{NOTE_C5}, ms(500)},
+        {{NOTE_B8}, ms(50)},
+        {{NOTE_A4}, ms(250)},
+    });
+}
+
+TEST_F(Synth, ChordsMatchReference) {
+    // C4 carries on from chord to chord, so its phase has to as well
+    expect_matches_reference({
+        {{NOTE_C4, NOTE_E4, NOTE_G4}, ms(300)},
+        {{NOTE_C4, NOTE_F4, NOTE_A4}, ms(300)},
+        {{NOTE_C4, NOTE_E4, NOTE_G4, NOTE_C5}, ms(300)},
+        {{NOTE_C4}, ms(300)},
+    });
+}
+
+TEST_F(Synth, FrequencyIsAccurate) {
+    std::vector<uint16_t> output = render({{{NOTE_A4}, sample_rate}});
+
+    uint32_t crossings = 0;
+    for (size_t i = 1; i < output.size(); i++) {
+        crossings += output[i - 1] < center && output[i] >= center;
+    }
+    EXPECT_NEAR(crossings, 440, 1);
+}
+
+TEST_F(Synth, EnvelopeShapesTheTone) {
+    synth_envelope_t envelope = {.attack = 20, .decay = 20, .sustain = SYNTH_LEVEL_MAX / 2, .release = 40};
+    synth_set_envelope(&envelope);
+
+    std::vector<uint16_t> output = render({{{NOTE_A4}, ms(100)}, {{}, ms(50)}});
+
+    // Rising through the attack, full at its end, half once the decay is done
+    EXPECT_LT(peak(output, 0, ms(5)), 2047 / 3);
+    EXPECT_NEAR(peak(output, ms(15), ms(25)), 2047, 2047 / 10);
+    EXPECT_NEAR(peak(output, ms(50), ms(100)), 2047 / 2, 2047 / 20);
+
+    // Fading out over the release, and done after it
+    EXPECT_LT(peak(output, ms(130), ms(140)), 2047 / 4);
+    EXPECT_EQ(peak(output, ms(141), output.size()), 0);
+    EXPECT_EQ(synth_active_voices(), 0);
+}
+
+TEST_F(Synth, ReleasingVoicesMakeRoom) {
+    synth_envelope_t envelope = {.attack = 0, .decay = 0, .sustain = SYNTH_LEVEL_MAX, .release = 1000};
+    synth_set_envelope(&envelope);
+
+    render({{{NOTE_C4, NOTE_E4, NOTE_G4, NOTE_B4}, ms(10)}});
+    EXPECT_EQ(synth_active_voices(), 4);
+
+    // All four are still releasing, the new tones take over their voices
+    render({{{NOTE_D4, NOTE_F4, NOTE_A4}, ms(10)}});
+    EXPECT_EQ(synth_active_voices(), SYNTH_VOICES);
+
+    // A tone that comes back while it releases starts its attack from where it is
+    render({{{NOTE_D4, NOTE_F4, NOTE_A4, NOTE_B4}, ms(10)}});
+    EXPECT_EQ(synth_active_voices(), SYNTH_VOICES);
+}
+
+TEST_F(Synth, CyclesPerSample) {
+    const std::vector<float> chord   = {NOTE_C4, NOTE_E4, NOTE_G4, NOTE_C5};
+    const size_t             samples = sample_rate;
+
+    std::vector<uint32_t> frequencies;
+    for (float tone : chord) {
+        frequencies.push_back(SYNTH_FREQUENCY(tone));
+    }
+    synth_set_tones(frequencies.data(), frequencies.size());
+
+    std::vector<uint16_t> output(samples);
+    auto                  start = std::chrono::steady_clock::now();
+    synth_render_buffer(output.data(), samples);
+    auto fixed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // The per sample float math the driver used to do
+    float index[4] = {0};
+    start          = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < samples; s++) {
+        uint_fast16_t value = 0;
+        for (size_t i = 0; i < chord.size(); i++) {
+            index[i] += chord[i] * ((float)wavetable.size() / sample_rate);
+            while (index[i] >= wavetable.size()) {
+                index[i] -= wavetable.size();
+            }
+            value += wavetable[(size_t)index[i]] / chord.size();
+        }
+        output[s] = value;
+    }
+    auto float_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // Host timings, the difference is larger on an MCU without an FPU
+    RecordProperty("fixed_point_ps_per_sample", static_cast<int>(fixed_ns * 1000 / samples));
+    RecordProperty("float_ps_per_sample", static_cast<int>(float_ns * 1000 / samples));
+}
+
@@ -0,0 +1 @@
+TEST_LIST += synth audio_clip
@@ -17,6 +17,7 @@
 #include "timer.h"
 #include "action.h"
 #include "action_util.h"
+#include "state_change.h"
 
 /** @brief True when Caps Word is active. */
 static bool caps_word_active = false;
@@ -58,6 +59,7 @@ void caps_word_on(void) {
 #endif // CAPS_WORD_IDLE_TIMEOUT > 0
 
     caps_word_active = true;
+    state_publish(STATE_CAPS_WORD);
     caps_word_set_user(true);
 }
 
@@ -68,6 +70,7 @@ void caps_word_off(void) {
 
     unregister_weak_mods(MOD_MASK_SHIFT); // Make sure weak shift is off.
     caps_word_active = false;
+    state_publish(STATE_CAPS_WORD);
     caps_word_set_user(false);
 }
 
@@ -12,24 +12,100 @@
 //------------------------------------
 // Helpers
 //
+// Each table is kept as a binary min-heap ordered by trigger time: live entries
+// fill the start of the table, followed by free ones. That keeps a zeroed table
+// valid and empty, and lets the task look at the first entry only.
+//
 
 static deferred_token current_token = 0;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
+// Bumped by every change to any table, so the task can tell whether a callback touched the heap
+static uint8_t table_generation = 0;
+
+static inline bool triggers_before(const deferred_executor_t *a, const deferred_executor_t *b) {
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static inline void swap_entries(deferred_executor_t *table, size_t a, size_t b) {
+    deferred_executor_t tmp = table[a];
+    table[a]                = table[b];
+    table[b]                = tmp;
+}
+
+static size_t sift_up(deferred_executor_t *table, size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!triggers_before(&table[index], &table[parent])) {
+            break;
+        }
+        swap_entries(table, index, parent);
+        index = parent;
+    }
+    return index;
+}
+
+static void sift_down(deferred_executor_t *table, size_t count, size_t index) {
+    for (;;) {
+        size_t first = index;
+        size_t left  = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < count && triggers_before(&table[left], &table[first])) {
+            first = left;
+        }
+        if (right < count && triggers_before(&table[right], &table[first])) {
+            first = right;
+        }
+        if (first == index) {
+            return;
+        }
+        swap_entries(table, index, first);
+        index = first;
     }
-    for (int i = 0; i < table_count; ++i) {
+}
+
+static inline void reschedule(deferred_executor_t *table, size_t count, size_t index) {
+    if (sift_up(table, index) == index) {
+        sift_down(table, count, index);
+    }
+}
+
+// Live entries are a prefix of the table, binary search for its end
+static size_t live_count(deferred_executor_t *table, size_t table_count) {
+    size_t lo = 0, hi = table_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (table[mid].token != INVALID_DEFERRED_TOKEN) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static size_t find_token(deferred_executor_t *table, size_t count, deferred_token token) {
+    for (size_t i = 0; i < count; ++i) {
         if (table[i].token == token) {
-            return false;
+            return i;
         }
     }
-    return true;
+    return count;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
+static void remove_entry(deferred_executor_t *table, size_t count, size_t index) {
+    size_t last = count - 1;
+    if (index != last) {
+        table[index] = table[last];
+    }
+    table[last] = (deferred_executor_t){0};
+    if (index != last) {
+        reschedule(table, last, index);
+    }
+}
+
+static inline deferred_token allocate_token(deferred_executor_t *table, size_t count) {
     deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
+    while (current_token == INVALID_DEFERRED_TOKEN || find_token(table, count, current_token) != count) {
         ++current_token;
         if (current_token == first) {
             // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
@@ -49,27 +125,28 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    // Claim the first free slot, none available if the table is full
+    size_t count = live_count(table, table_count);
+    if (count == table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Work out the new token value, dropping out if none were available
+    deferred_token token = allocate_token(table, count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry
+    table[count] = (deferred_executor_t){
+        .token        = token,
+        .trigger_time = timer_read32() + delay_ms,
+        .callback     = callback,
+        .cb_arg       = cb_arg,
+    };
+    sift_up(table, count);
+    ++table_generation;
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +156,18 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    size_t count = live_count(table, table_count);
+    size_t index = find_token(table, count, token);
+    if (index == count) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    table[index].trigger_time = timer_read32() + delay_ms;
+    reschedule(table, count, index);
+    ++table_generation;
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,60 +177,101 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    size_t count = live_count(table, table_count);
+    size_t index = find_token(table, count, token);
+    if (index == count) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    remove_entry(table, count, index);
+    ++table_generation;
+    return true;
+}
+
+static void heapify(deferred_executor_t *table, size_t count) {
+    for (size_t i = count / 2; i-- > 0;) {
+        sift_down(table, count, i);
+    }
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
     uint32_t now = timer_read32();
 
     // Throttle only once per millisecond
-    if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
-        *last_execution_time = now;
-
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
-            deferred_token       curr_token = entry->token;
-
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+    if (!table || table_count == 0 || ((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) <= 0) {
+        return;
+    }
+    *last_execution_time = now;
+
+    // The earliest trigger is always first, nothing else can be due if it isn't
+    if (table[0].token == INVALID_DEFERRED_TOKEN || ((int32_t)TIMER_DIFF_32(table[0].trigger_time, now)) > 0) {
+        return;
+    }
+
+    // Each executor runs at most once per pass. One that is still due after repeating is parked
+    // at the end of the live entries, outside of the heap, until the pass is over.
+    uint8_t executed[(1 << (8 * sizeof(deferred_token))) / 8] = {0};
+
+    size_t count  = live_count(table, table_count);
+    size_t parked = 0;
+
+    while (count > parked && ((int32_t)TIMER_DIFF_32(table[0].trigger_time, now)) <= 0) {
+        size_t         heap_count = count - parked;
+        deferred_token curr_token = table[0].token;
+        if (executed[curr_token / 8] & (1 << (curr_token % 8))) {
+            swap_entries(table, 0, heap_count - 1);
+            sift_down(table, heap_count - 1, 0);
+            ++parked;
+            continue;
+        }
+        executed[curr_token / 8] |= 1 << (curr_token % 8);
+
+        // Invoke the callback and work work out if we should be requeued
+        uint8_t  generation = table_generation;
+        uint32_t delay_ms   = table[0].callback(table[0].trigger_time, table[0].cb_arg);
+
+        if (generation != table_generation) {
+            // The callback added, extended or cancelled executors, possibly including itself. Start over
+            // from a plain heap, anything already executed and still due gets parked again.
+            count  = live_count(table, table_count);
+            parked = 0;
+            heapify(table, count);
+
+            // If the token is gone, then the callback has canceled and re-queued. Skip further processing.
+            size_t index = find_token(table, count, curr_token);
+            if (index == count) {
+                continue;
             }
+            if (delay_ms > 0) {
+                table[index].trigger_time += delay_ms;
+                reschedule(table, count, index);
+            } else {
+                remove_entry(table, count--, index);
+            }
+        } else if (delay_ms > 0) {
+            // Intentionally add just the delay to the existing trigger time -- this ensures the next
+            // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+            // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+            // considerable length of time, then this ensures best-effort timing between invocations.
+            table[0].trigger_time += delay_ms;
+            sift_down(table, heap_count, 0);
+        } else {
+            // If it was zero, then the callback is cancelling repeated execution. Free up the slot, keeping
+            // the parked entries right after the heap.
+            table[0]              = table[heap_count - 1];
+            table[heap_count - 1] = table[count - 1];
+            table[count - 1]      = (deferred_executor_t){0};
+            --count;
+            sift_down(table, heap_count - 1, 0);
         }
+        ++table_generation;
+    }
+
+    // Put the parked entries back into the heap
+    for (size_t i = count - parked; i < count; ++i) {
+        sift_up(table, i);
     }
 }
 
@@ -172,6 +291,13 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+uint32_t deferred_exec_next_timeout(void) {
+    if (basic_executors[0].token == INVALID_DEFERRED_TOKEN) {
+        return UINT32_MAX;
+    }
+    int32_t remaining = (int32_t)TIMER_DIFF_32(basic_executors[0].trigger_time, timer_read32());
+    return remaining > 0 ? remaining : 0;
+}
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
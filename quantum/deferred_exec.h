@@ -65,6 +65,11 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Number of milliseconds until the next deferred execution is due, or UINT32_MAX if none is pending.
+ */
+uint32_t deferred_exec_next_timeout(void);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
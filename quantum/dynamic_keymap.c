@@ -36,6 +36,10 @@
 #    define NUM_ENCODERS 0
 #endif
 
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+#    include "dynamic_keymap_flash.h"
+#endif
+
 #ifndef DYNAMIC_KEYMAP_LAYER_COUNT
 #    define DYNAMIC_KEYMAP_LAYER_COUNT 4
 #endif
@@ -68,9 +72,13 @@
 #    define DYNAMIC_KEYMAP_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
 #endif
 
-// Dynamic encoders starts after dynamic keymaps
+// Dynamic encoders starts after dynamic keymaps, which take no EEPROM when kept in flash
 #ifndef DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR
-#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2))
+#    ifdef DYNAMIC_KEYMAP_FLASH_STORE
+#        define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR)
+#    else
+#        define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2))
+#    endif
 #endif
 
 // Dynamic macro starts after dynamic encoders, but only when using ENCODER_MAP
@@ -105,6 +113,21 @@ uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+static inline uint16_t dynamic_keymap_key_to_index(uint8_t layer, uint8_t row, uint8_t column) {
+    return (layer * MATRIX_ROWS * MATRIX_COLS) + (row * MATRIX_COLS) + column;
+}
+
+uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+    return dynamic_keymap_flash_read(dynamic_keymap_key_to_index(layer, row, column));
+}
+
+void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+    dynamic_keymap_flash_write(dynamic_keymap_key_to_index(layer, row, column), keycode);
+}
+#else  // DYNAMIC_KEYMAP_FLASH_STORE
 void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
     // TODO: optimize this with some left shifts
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
@@ -126,6 +149,7 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
 }
+#endif // DYNAMIC_KEYMAP_FLASH_STORE
 
 #ifdef ENCODER_MAP_ENABLE
 void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id) {
@@ -150,6 +174,15 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
 }
 #endif // ENCODER_MAP_ENABLE
 
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+    // Fill the store from the firmware keymap if it doesn't hold one yet
+    if (!dynamic_keymap_flash_init(DYNAMIC_KEYMAP_FLASH_KEYCODE_COUNT)) {
+        dynamic_keymap_reset();
+    }
+#endif
+}
+
 void dynamic_keymap_reset(void) {
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
@@ -165,8 +198,38 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+    dynamic_keymap_flash_commit();
+#endif
+}
+
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t dynamic_keymap_size = DYNAMIC_KEYMAP_FLASH_KEYCODE_COUNT * 2;
+    for (uint16_t i = 0; i < size; i++) {
+        uint16_t position = offset + i;
+        if (position < dynamic_keymap_size) {
+            // Big endian, as with the EEPROM store
+            uint16_t keycode = dynamic_keymap_flash_read(position / 2);
+            data[i]          = (position & 1) ? (uint8_t)(keycode & 0xFF) : (uint8_t)(keycode >> 8);
+        } else {
+            data[i] = 0x00;
+        }
+    }
 }
 
+void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t dynamic_keymap_size = DYNAMIC_KEYMAP_FLASH_KEYCODE_COUNT * 2;
+    for (uint16_t i = 0; i < size; i++) {
+        uint16_t position = offset + i;
+        if (position < dynamic_keymap_size) {
+            uint16_t keycode = dynamic_keymap_flash_read(position / 2);
+            keycode          = (position & 1) ? ((keycode & 0xFF00) | data[i]) : ((keycode & 0x00FF) | (data[i] << 8));
+            dynamic_keymap_flash_write(position / 2, keycode);
+        }
+    }
+}
+#else  // DYNAMIC_KEYMAP_FLASH_STORE
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
     void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
@@ -194,6 +257,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         target++;
     }
 }
+#endif // DYNAMIC_KEYMAP_FLASH_STORE
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
     if (layer_num < DYNAMIC_KEYMAP_LAYER_COUNT && row < MATRIX_ROWS && column < MATRIX_COLS) {
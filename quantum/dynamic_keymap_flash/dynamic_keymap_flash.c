@@ -0,0 +1,180 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "dynamic_keymap_flash.h"
+#include "keycodes.h"
+#include "timer.h"
+#include "debug.h"
+#include "util.h"
+
+#define DYNAMIC_KEYMAP_FLASH_MAGIC 0x514B4D32 // "QKM2"
+#define ERASED_KEYCODE 0xFFFF
+#define NO_PAGE UINT16_MAX
+
+#define WORDS_PER_PAGE (DYNAMIC_KEYMAP_FLASH_PAGE_SIZE / sizeof(uint16_t))
+#define HEADER_WORDS (DYNAMIC_KEYMAP_FLASH_HEADER_SIZE / sizeof(uint16_t))
+#define KEYCODES_PER_PAGE (DYNAMIC_KEYMAP_FLASH_KEYCODES_PER_PAGE)
+#define MAX_PAGES ((DYNAMIC_KEYMAP_FLASH_SIZE) / (2 * DYNAMIC_KEYMAP_FLASH_PAGE_SIZE))
+
+typedef struct {
+    uint32_t magic;
+    uint16_t count;
+    uint16_t sequence;
+} dynamic_keymap_flash_header_t;
+
+_Static_assert(DYNAMIC_KEYMAP_FLASH_PAGE_SIZE >= 256 && (DYNAMIC_KEYMAP_FLASH_PAGE_SIZE & (DYNAMIC_KEYMAP_FLASH_PAGE_SIZE - 1)) == 0, "DYNAMIC_KEYMAP_FLASH_PAGE_SIZE must be a power of two of at least 256");
+_Static_assert(sizeof(dynamic_keymap_flash_header_t) == DYNAMIC_KEYMAP_FLASH_HEADER_SIZE, "Unexpected flash keymap header size");
+_Static_assert(MAX_PAGES >= DYNAMIC_KEYMAP_FLASH_PAGE_COUNT, "DYNAMIC_KEYMAP_FLASH_SIZE is too small for two copies of the keymap");
+
+// The region as mapped in memory, page 0 in slots 0 and 1, page 1 in slots 2 and 3...
+static const uint16_t *flash_words;
+static uint16_t        flash_pages;
+static uint16_t        keycode_count;
+
+// Slot holding the current copy of each page, and its sequence number
+static uint8_t  page_slot[MAX_PAGES];
+static uint16_t page_sequence[MAX_PAGES];
+
+// RAM copy of the page with changes not yet written, header included
+static uint16_t pending_page = NO_PAGE;
+static uint16_t page_buffer[WORDS_PER_PAGE] __attribute__((aligned(8)));
+static uint32_t last_change;
+
+static inline uint32_t slot_offset(uint16_t page, uint8_t slot) {
+    return ((uint32_t)page * 2 + slot) * DYNAMIC_KEYMAP_FLASH_PAGE_SIZE;
+}
+
+static inline const uint16_t *slot_words(uint16_t page, uint8_t slot) {
+    return &flash_words[slot_offset(page, slot) / sizeof(uint16_t)];
+}
+
+static bool dynamic_keymap_flash_slot_is_valid(uint16_t page, uint8_t slot) {
+    const uint16_t                      *words  = slot_words(page, slot);
+    const dynamic_keymap_flash_header_t *header = (const dynamic_keymap_flash_header_t *)words;
+    if (header->magic != DYNAMIC_KEYMAP_FLASH_MAGIC || header->count != keycode_count) {
+        return false;
+    }
+    // Erased words are left behind by a write that didn't complete
+    uint16_t count = MIN(KEYCODES_PER_PAGE, keycode_count - page * KEYCODES_PER_PAGE);
+    for (uint16_t i = 0; i < count; i++) {
+        if (words[HEADER_WORDS + i] == ERASED_KEYCODE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Picks the newest complete copy of every page
+static bool dynamic_keymap_flash_find_pages(void) {
+    bool valid = true;
+    for (uint16_t page = 0; page < flash_pages; page++) {
+        bool     valid_0    = dynamic_keymap_flash_slot_is_valid(page, 0);
+        bool     valid_1    = dynamic_keymap_flash_slot_is_valid(page, 1);
+        uint16_t sequence_0 = ((const dynamic_keymap_flash_header_t *)slot_words(page, 0))->sequence;
+        uint16_t sequence_1 = ((const dynamic_keymap_flash_header_t *)slot_words(page, 1))->sequence;
+
+        page_slot[page] = valid_1 && (!valid_0 || (int16_t)(sequence_1 - sequence_0) > 0);
+        if (!valid_0 && !valid_1) {
+            valid = false;
+        }
+        page_sequence[page] = page_slot[page] ? sequence_1 : sequence_0;
+    }
+    return valid;
+}
+
+bool dynamic_keymap_flash_init(uint16_t count) {
+    pending_page  = NO_PAGE;
+    keycode_count = count;
+    flash_pages   = (count + KEYCODES_PER_PAGE - 1) / KEYCODES_PER_PAGE;
+    if (flash_pages > MAX_PAGES) {
+        dprintf("dynamic_keymap_flash: %u keycodes don't fit\n", count);
+        flash_pages   = MAX_PAGES;
+        keycode_count = MAX_PAGES * KEYCODES_PER_PAGE;
+    }
+    if (!dynamic_keymap_flash_driver_init()) {
+        dprintf("dynamic_keymap_flash: init failed\n");
+    }
+    flash_words = (const uint16_t *)dynamic_keymap_flash_driver_address();
+
+    if (dynamic_keymap_flash_find_pages()) {
+        return true;
+    }
+
+    // Start over from a blank region, so that a rewrite cut short is caught on
+    // the next boot rather than mixing pages of two keymaps
+    dprintf("dynamic_keymap_flash: no keymap of %u keycodes, erasing\n", count);
+    for (uint16_t page = 0; page < flash_pages; page++) {
+        dynamic_keymap_flash_driver_erase(slot_offset(page, 0));
+        dynamic_keymap_flash_driver_erase(slot_offset(page, 1));
+        page_slot[page]     = 1;
+        page_sequence[page] = 0;
+    }
+    return false;
+}
+
+uint16_t dynamic_keymap_flash_read(uint16_t index) {
+    uint16_t page = index / KEYCODES_PER_PAGE;
+    uint16_t word = HEADER_WORDS + index % KEYCODES_PER_PAGE;
+    if (page == pending_page) {
+        return page_buffer[word];
+    }
+    if (page >= flash_pages) {
+        return KC_NO;
+    }
+    return slot_words(page, page_slot[page])[word];
+}
+
+void dynamic_keymap_flash_write(uint16_t index, uint16_t keycode) {
+    if (keycode == ERASED_KEYCODE) {
+        keycode = KC_NO;
+    }
+    if (index >= keycode_count) {
+        return;
+    }
+
+    uint16_t page = index / KEYCODES_PER_PAGE;
+    uint16_t word = HEADER_WORDS + index % KEYCODES_PER_PAGE;
+    if (page != pending_page) {
+        const uint16_t *words = slot_words(page, page_slot[page]);
+        if (words[word] == keycode) {
+            return;
+        }
+        dynamic_keymap_flash_commit();
+        memcpy(page_buffer, words, sizeof(page_buffer));
+        pending_page = page;
+    }
+    page_buffer[word] = keycode;
+    last_change       = timer_read32();
+}
+
+void dynamic_keymap_flash_commit(void) {
+    if (pending_page == NO_PAGE) {
+        return;
+    }
+
+    uint16_t page = pending_page;
+    pending_page  = NO_PAGE;
+    // Changes that were undone before the write leave nothing to do
+    if (memcmp(&page_buffer[HEADER_WORDS], &slot_words(page, page_slot[page])[HEADER_WORDS], sizeof(page_buffer) - DYNAMIC_KEYMAP_FLASH_HEADER_SIZE) == 0) {
+        return;
+    }
+
+    // Into the other slot, the current one stays as it is until this one is complete
+    uint8_t                       slot   = page_slot[page] ^ 1;
+    uint32_t                      offset = slot_offset(page, slot);
+    dynamic_keymap_flash_header_t header = {.magic = DYNAMIC_KEYMAP_FLASH_MAGIC, .count = keycode_count, .sequence = page_sequence[page] + 1};
+    memcpy(page_buffer, &header, sizeof(header));
+    if (!dynamic_keymap_flash_driver_erase(offset) || !dynamic_keymap_flash_driver_program(offset, page_buffer)) {
+        dprintf("dynamic_keymap_flash: failed to write page at %lu\n", (unsigned long)offset);
+        return;
+    }
+    page_slot[page]     = slot;
+    page_sequence[page] = header.sequence;
+}
+
+void dynamic_keymap_flash_task(void) {
+    if (pending_page != NO_PAGE && timer_elapsed32(last_change) >= DYNAMIC_KEYMAP_FLASH_WRITE_DELAY) {
+        dynamic_keymap_flash_commit();
+    }
+}
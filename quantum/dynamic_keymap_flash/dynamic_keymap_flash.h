@@ -0,0 +1,109 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "action_layer.h"
+
+/**
+ * \file
+ *
+ * \defgroup dynamic_keymap_flash Flash keymap store
+ *
+ * Keeps the dynamic keymap in its own region of memory mapped flash rather
+ * than in EEPROM. The keycodes are stored as native arrays, so reading one
+ * is a load from flash instead of a walk through the emulated EEPROM,
+ * and the number of layers is only bounded by the size of the region.
+ *
+ * Flash can only be rewritten a page at a time, so changes go to a RAM copy
+ * of the page holding them, and the page is written back when a change to
+ * another page comes in, when nothing changed for
+ * DYNAMIC_KEYMAP_FLASH_WRITE_DELAY, or when committed explicitly.
+ *
+ * Each page of keycodes has two slots in the region, and is written to the
+ * slot it isn't in, behind a header with the layout of the keymap and a
+ * sequence number. A write cut short by a loss of power leaves erased words
+ * in its slot, and the page is then read from the other one, as it was
+ * before the write. A region holding another layout, or missing a page, is
+ * reported as invalid by dynamic_keymap_flash_init().
+ * \{
+ */
+
+#ifndef DYNAMIC_KEYMAP_FLASH_PAGE_SIZE
+#    error "DYNAMIC_KEYMAP_FLASH_PAGE_SIZE is defined by the flash keymap store driver"
+#endif
+
+// Magic, keycode count and sequence number, at the start of every page
+#define DYNAMIC_KEYMAP_FLASH_HEADER_SIZE 8
+
+#define DYNAMIC_KEYMAP_FLASH_KEYCODE_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+#define DYNAMIC_KEYMAP_FLASH_KEYCODES_PER_PAGE ((DYNAMIC_KEYMAP_FLASH_PAGE_SIZE - DYNAMIC_KEYMAP_FLASH_HEADER_SIZE) / 2)
+#define DYNAMIC_KEYMAP_FLASH_PAGE_COUNT ((DYNAMIC_KEYMAP_FLASH_KEYCODE_COUNT + DYNAMIC_KEYMAP_FLASH_KEYCODES_PER_PAGE - 1) / DYNAMIC_KEYMAP_FLASH_KEYCODES_PER_PAGE)
+
+// Bytes of flash taken by the store, two slots of each page
+#ifndef DYNAMIC_KEYMAP_FLASH_SIZE
+#    define DYNAMIC_KEYMAP_FLASH_SIZE (2 * DYNAMIC_KEYMAP_FLASH_PAGE_COUNT * DYNAMIC_KEYMAP_FLASH_PAGE_SIZE)
+#endif
+
+// Milliseconds without changes before a pending page is written
+#ifndef DYNAMIC_KEYMAP_FLASH_WRITE_DELAY
+#    define DYNAMIC_KEYMAP_FLASH_WRITE_DELAY 1000
+#endif
+
+/**
+ * \brief Maps the store.
+ *
+ * \param count number of keycodes the store holds
+ * \return false if the store doesn't hold a complete keymap of `count`
+ * keycodes. It has then been erased, and all the keycodes have to be
+ * written, then committed.
+ */
+bool dynamic_keymap_flash_init(uint16_t count);
+
+/**
+ * \brief Reads the keycode at `index`, including changes not yet written.
+ */
+uint16_t dynamic_keymap_flash_read(uint16_t index);
+
+/**
+ * \brief Changes the keycode at `index`.
+ *
+ * 0xFFFF is what erased flash reads as, and is stored as KC_NO.
+ */
+void dynamic_keymap_flash_write(uint16_t index, uint16_t keycode);
+
+/**
+ * \brief Writes the pending page to flash, if any.
+ *
+ * Erasing the slot blocks for as long as the flash takes to erase it, tens of
+ * milliseconds on most MCUs, during which no keys are scanned.
+ */
+void dynamic_keymap_flash_commit(void);
+
+/**
+ * \brief Writes the pending page once DYNAMIC_KEYMAP_FLASH_WRITE_DELAY has
+ * passed without changes.
+ */
+void dynamic_keymap_flash_task(void);
+
+/**
+ * \defgroup dynamic_keymap_flash_driver Flash keymap store driver
+ *
+ * The region is DYNAMIC_KEYMAP_FLASH_SIZE bytes of flash erasing to 0xFF,
+ * readable through the memory map. Offsets are relative to its start, and
+ * always a multiple of DYNAMIC_KEYMAP_FLASH_PAGE_SIZE.
+ * \{
+ */
+
+bool        dynamic_keymap_flash_driver_init(void);
+const void *dynamic_keymap_flash_driver_address(void);
+// Erases the DYNAMIC_KEYMAP_FLASH_PAGE_SIZE bytes at `offset`
+bool dynamic_keymap_flash_driver_erase(uint32_t offset);
+// Programs DYNAMIC_KEYMAP_FLASH_PAGE_SIZE bytes at `offset`, erased beforehand
+bool dynamic_keymap_flash_driver_program(uint32_t offset, const void *data);
+
+/** \} */
+
+/** \} */
@@ -0,0 +1,225 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "dynamic_keymap_flash.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+const uint16_t keycode_count = DYNAMIC_KEYMAP_FLASH_KEYCODE_COUNT;
+const size_t   slot_count    = DYNAMIC_KEYMAP_FLASH_SIZE / DYNAMIC_KEYMAP_FLASH_PAGE_SIZE;
+const size_t   page_count    = slot_count / 2;
+
+// NOR flash: erasing sets a slot to 0xFF, programming only clears bits
+struct MockFlash {
+    alignas(8) std::array<uint8_t, DYNAMIC_KEYMAP_FLASH_SIZE> data;
+    std::array<size_t, slot_count> erases;
+    // Bytes programmed before the power goes out
+    size_t program_limit;
+
+    void reset() {
+        data.fill(0xFF);
+        erases.fill(0);
+        program_limit = SIZE_MAX;
+    }
+    size_t page_erases(size_t page) const {
+        return erases[page * 2] + erases[page * 2 + 1];
+    }
+    size_t total_erases() const {
+        size_t total = 0;
+        for (size_t count : erases) {
+            total += count;
+        }
+        return total;
+    }
+} flash;
+
+uint16_t sequence(size_t slot) {
+    uint16_t sequence;
+    std::memcpy(&sequence, &flash.data[slot * DYNAMIC_KEYMAP_FLASH_PAGE_SIZE + 6], sizeof(sequence));
+    return sequence == 0xFFFF ? 0 : sequence;
+}
+
+// Keycodes as they sit in the newest slot of their page, past the header
+uint16_t stored(uint16_t index) {
+    size_t page = index / DYNAMIC_KEYMAP_FLASH_KEYCODES_PER_PAGE;
+    size_t slot = sequence(page * 2 + 1) > sequence(page * 2) ? page * 2 + 1 : page * 2;
+
+    uint16_t keycode;
+    std::memcpy(&keycode, &flash.data[slot * DYNAMIC_KEYMAP_FLASH_PAGE_SIZE + DYNAMIC_KEYMAP_FLASH_HEADER_SIZE + (index % DYNAMIC_KEYMAP_FLASH_KEYCODES_PER_PAGE) * 2], sizeof(keycode));
+    return keycode;
+}
+
+uint16_t default_keycode(uint16_t index) {
+    return 0x0004 + index % 0x1000;
+}
+
+} // namespace
+
+extern "C" {
+bool dynamic_keymap_flash_driver_init(void) {
+    return true;
+}
+
+const void *dynamic_keymap_flash_driver_address(void) {
+    return flash.data.data();
+}
+
+bool dynamic_keymap_flash_driver_erase(uint32_t offset) {
+    EXPECT_EQ(offset % DYNAMIC_KEYMAP_FLASH_PAGE_SIZE, 0u);
+    std::memset(&flash.data[offset], 0xFF, DYNAMIC_KEYMAP_FLASH_PAGE_SIZE);
+    flash.erases[offset / DYNAMIC_KEYMAP_FLASH_PAGE_SIZE]++;
+    return true;
+}
+
+bool dynamic_keymap_flash_driver_program(uint32_t offset, const void *data) {
+    EXPECT_EQ(offset % DYNAMIC_KEYMAP_FLASH_PAGE_SIZE, 0u);
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < DYNAMIC_KEYMAP_FLASH_PAGE_SIZE; i++) {
+        if (flash.program_limit == 0) {
+            return false;
+        }
+        flash.program_limit--;
+        EXPECT_EQ(flash.data[offset + i], 0xFF) << "Programming a byte that isn't erased";
+        flash.data[offset + i] &= bytes[i];
+    }
+    return true;
+}
+}
+
+class DynamicKeymapFlash : public ::testing::Test {
+   protected:
+    // Starts off a store holding the default keymap
+    void SetUp() override {
+        flash.reset();
+        ASSERT_FALSE(dynamic_keymap_flash_init(keycode_count));
+        for (uint16_t i = 0; i < keycode_count; i++) {
+            dynamic_keymap_flash_write(i, default_keycode(i));
+        }
+        dynamic_keymap_flash_commit();
+        ASSERT_TRUE(dynamic_keymap_flash_init(keycode_count));
+        flash.erases.fill(0);
+    }
+};
+
+TEST_F(DynamicKeymapFlash, HoldsThirtyTwoLayers) {
+    EXPECT_EQ(keycode_count, 32 * 6 * 21);
+    for (uint16_t i = 0; i < keycode_count; i++) {
+        ASSERT_EQ(dynamic_keymap_flash_read(i), default_keycode(i));
+        // Stored as a plain array, no translation on reads
+        ASSERT_EQ(stored(i), default_keycode(i));
+    }
+}
+
+TEST_F(DynamicKeymapFlash, ChangesAreReadBeforeTheyAreWritten) {
+    dynamic_keymap_flash_write(10, 0x1234);
+    EXPECT_EQ(dynamic_keymap_flash_read(10), 0x1234);
+    EXPECT_EQ(stored(10), default_keycode(10));
+
+    advance_time(DYNAMIC_KEYMAP_FLASH_WRITE_DELAY - 1);
+    dynamic_keymap_flash_task();
+    EXPECT_EQ(flash.total_erases(), 0u);
+
+    advance_time(1);
+    dynamic_keymap_flash_task();
+    EXPECT_EQ(stored(10), 0x1234);
+    EXPECT_EQ(flash.page_erases(0), 1u);
+    EXPECT_EQ(flash.total_erases(), 1u);
+}
+
+TEST_F(DynamicKeymapFlash, OneWritePerPage) {
+    // A whole keymap from the host, as VIA sends it
+    for (uint16_t i = 0; i < keycode_count; i++) {
+        dynamic_keymap_flash_write(i, default_keycode(i) + 1);
+    }
+    dynamic_keymap_flash_commit();
+
+    for (size_t page = 0; page < page_count; page++) {
+        EXPECT_EQ(flash.page_erases(page), 1u) << "page " << page;
+    }
+    for (uint16_t i = 0; i < keycode_count; i++) {
+        ASSERT_EQ(stored(i), default_keycode(i) + 1);
+    }
+    EXPECT_TRUE(dynamic_keymap_flash_init(keycode_count));
+}
+
+TEST_F(DynamicKeymapFlash, UnchangedKeycodesAreNotWritten) {
+    dynamic_keymap_flash_write(3, default_keycode(3));
+    dynamic_keymap_flash_commit();
+    EXPECT_EQ(flash.total_erases(), 0u);
+
+    // Changed, then changed back before the write
+    dynamic_keymap_flash_write(3, 0x4321);
+    dynamic_keymap_flash_write(3, default_keycode(3));
+    dynamic_keymap_flash_commit();
+    EXPECT_EQ(flash.total_erases(), 0u);
+}
+
+TEST_F(DynamicKeymapFlash, ErasedKeycodeIsStoredAsNo) {
+    dynamic_keymap_flash_write(0, 0xFFFF);
+    dynamic_keymap_flash_commit();
+    EXPECT_EQ(dynamic_keymap_flash_read(0), 0x0000);
+    EXPECT_TRUE(dynamic_keymap_flash_init(keycode_count));
+}
+
+TEST_F(DynamicKeymapFlash, WritesAlternateBetweenSlots) {
+    dynamic_keymap_flash_write(10, 0x1234);
+    dynamic_keymap_flash_commit();
+    dynamic_keymap_flash_write(10, 0x4321);
+    dynamic_keymap_flash_commit();
+
+    // Set up in slot 0, then written to slot 1, then slot 0 again
+    EXPECT_EQ(flash.erases[0], 1u);
+    EXPECT_EQ(flash.erases[1], 1u);
+    EXPECT_TRUE(dynamic_keymap_flash_init(keycode_count));
+    EXPECT_EQ(dynamic_keymap_flash_read(10), 0x4321);
+}
+
+TEST_F(DynamicKeymapFlash, InterruptedEraseKeepsPreviousCopy) {
+    // Power lost between erasing the slot and programming it
+    flash.program_limit = 0;
+    dynamic_keymap_flash_write(10, 0x1234);
+    dynamic_keymap_flash_commit();
+
+    EXPECT_TRUE(dynamic_keymap_flash_init(keycode_count));
+    EXPECT_EQ(dynamic_keymap_flash_read(10), default_keycode(10));
+}
+
+TEST_F(DynamicKeymapFlash, InterruptedProgramKeepsPreviousCopy) {
+    // Power lost halfway through programming the slot, header included
+    flash.program_limit = DYNAMIC_KEYMAP_FLASH_PAGE_SIZE / 2;
+    dynamic_keymap_flash_write(10, 0x1234);
+    dynamic_keymap_flash_commit();
+
+    flash.program_limit = SIZE_MAX;
+    EXPECT_TRUE(dynamic_keymap_flash_init(keycode_count));
+    EXPECT_EQ(dynamic_keymap_flash_read(10), default_keycode(10));
+
+    // And the next write goes through
+    dynamic_keymap_flash_write(10, 0x1234);
+    dynamic_keymap_flash_commit();
+    EXPECT_TRUE(dynamic_keymap_flash_init(keycode_count));
+    EXPECT_EQ(dynamic_keymap_flash_read(10), 0x1234);
+}
+
+TEST_F(DynamicKeymapFlash, MissingPageIsDetected) {
+    dynamic_keymap_flash_driver_erase(2 * DYNAMIC_KEYMAP_FLASH_PAGE_SIZE);
+    dynamic_keymap_flash_driver_erase(3 * DYNAMIC_KEYMAP_FLASH_PAGE_SIZE);
+    EXPECT_FALSE(dynamic_keymap_flash_init(keycode_count));
+}
+
+TEST_F(DynamicKeymapFlash, LayoutChangeIsDetected) {
+    EXPECT_FALSE(dynamic_keymap_flash_init(keycode_count - 6 * 21));
+    // The region was erased for the new layout
+    for (uint8_t byte : flash.data) {
+        ASSERT_EQ(byte, 0xFF);
+    }
+}
@@ -0,0 +1,14 @@
+dynamic_keymap_flash_DEFS := \
+	-DDYNAMIC_KEYMAP_ENABLE \
+	-DDYNAMIC_KEYMAP_LAYER_COUNT=32 \
+	-DMATRIX_ROWS=6 \
+	-DMATRIX_COLS=21 \
+	-DDYNAMIC_KEYMAP_FLASH_PAGE_SIZE=1024
+
+dynamic_keymap_flash_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/dynamic_keymap_flash/dynamic_keymap_flash.c \
+	$(QUANTUM_PATH)/dynamic_keymap_flash/tests/dynamic_keymap_flash_tests.cpp
+
+dynamic_keymap_flash_INC := \
+	$(QUANTUM_PATH)/dynamic_keymap_flash
@@ -0,0 +1,2 @@
+TEST_LIST += \
+	dynamic_keymap_flash
@@ -4,12 +4,23 @@
 #include <string.h>
 #include "action.h"
 #include "encoder.h"
+#include "timer.h"
 #include "wait.h"
 
+#if defined(ENCODER_BATCHING) && defined(ENCODER_MAP_ENABLE) && defined(MOUSEKEY_ENABLE)
+#    include "action_tapping.h"
+#    include "keycodes.h"
+#    include "mousekey.h"
+#endif
+
 #ifndef ENCODER_MAP_KEY_DELAY
 #    define ENCODER_MAP_KEY_DELAY TAP_CODE_DELAY
 #endif
 
+#ifndef ENCODER_BATCH_INTERVAL
+#    define ENCODER_BATCH_INTERVAL 0
+#endif
+
 __attribute__((weak)) bool should_process_encoder(void) {
     return is_keyboard_master();
 }
@@ -17,8 +28,31 @@ __attribute__((weak)) bool should_process_encoder(void) {
 static encoder_events_t encoder_events;
 static bool             signal_queue_drain = false;
 
+#ifdef ENCODER_BATCHING
+typedef struct encoder_batch_t {
+    uint8_t  index;
+    bool     clockwise;
+    uint8_t  count;
+    uint16_t started;
+} encoder_batch_t;
+
+// Detents that go out together, count 0 when there are none
+static encoder_batch_t encoder_batch;
+#    ifndef ENCODER_MAP_ENABLE
+static uint16_t encoder_batch_times[NUM_ENCODERS];
+#    endif // ENCODER_MAP_ENABLE
+#endif     // ENCODER_BATCHING
+
 void encoder_init(void) {
     memset(&encoder_events, 0, sizeof(encoder_events));
+#ifdef ENCODER_BATCHING
+    memset(&encoder_batch, 0, sizeof(encoder_batch));
+#    ifndef ENCODER_MAP_ENABLE
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        encoder_batch_times[i] = timer_read() - 1000;
+    }
+#    endif // ENCODER_MAP_ENABLE
+#endif     // ENCODER_BATCHING
     encoder_driver_init();
 }
 
@@ -27,34 +61,103 @@ static void encoder_queue_drain(void) {
     encoder_events.dequeued = encoder_events.enqueued;
 }
 
-static bool encoder_handle_queue(void) {
-    bool    changed = false;
-    uint8_t index;
-    bool    clockwise;
-    while (encoder_dequeue_event(&index, &clockwise)) {
-#ifdef ENCODER_MAP_ENABLE
+#if !defined(ENCODER_BATCHING) || defined(ENCODER_MAP_ENABLE)
+static void encoder_exec(uint8_t index, bool clockwise) {
+#    ifdef ENCODER_MAP_ENABLE
+
+    // The delays below cater for Windows and its wonderful requirements.
+    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
+#        if ENCODER_MAP_KEY_DELAY > 0
+    wait_ms(ENCODER_MAP_KEY_DELAY);
+#        endif // ENCODER_MAP_KEY_DELAY > 0
 
-        // The delays below cater for Windows and its wonderful requirements.
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
-#    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
-#    endif // ENCODER_MAP_KEY_DELAY > 0
+    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+#        if ENCODER_MAP_KEY_DELAY > 0
+    wait_ms(ENCODER_MAP_KEY_DELAY);
+#        endif // ENCODER_MAP_KEY_DELAY > 0
 
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
-#    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
-#    endif // ENCODER_MAP_KEY_DELAY > 0
+#    else // ENCODER_MAP_ENABLE
 
-#else // ENCODER_MAP_ENABLE
+    encoder_update_kb(index, clockwise);
 
-        encoder_update_kb(index, clockwise);
+#    endif // ENCODER_MAP_ENABLE
+}
+#endif // !defined(ENCODER_BATCHING) || defined(ENCODER_MAP_ENABLE)
+
+#ifdef ENCODER_BATCHING
+#    if defined(ENCODER_MAP_ENABLE) && defined(MOUSEKEY_ENABLE)
+// Taps a mouse wheel keycode once for the whole batch, which mousekeys turn into a single report
+static bool encoder_exec_wheel(uint8_t index, bool clockwise, uint8_t count) {
+    uint16_t keycode = get_event_keycode(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true), false);
+    if (!IS_MOUSEKEY_WHEEL(keycode)) {
+        return false;
+    }
 
-#endif // ENCODER_MAP_ENABLE
+    mousekey_set_wheel_detents(count);
+    encoder_exec(index, clockwise);
+    // In case the keycode was handled before reaching mousekeys
+    mousekey_set_wheel_detents(1);
+    return true;
+}
+#    endif // defined(ENCODER_MAP_ENABLE) && defined(MOUSEKEY_ENABLE)
+
+static void encoder_exec_batch(void) {
+    uint8_t index     = encoder_batch.index;
+    bool    clockwise = encoder_batch.clockwise;
+    uint8_t count     = encoder_batch.count;
+    encoder_batch.count = 0;
+
+#    ifdef ENCODER_MAP_ENABLE
+#        ifdef MOUSEKEY_ENABLE
+    if (encoder_exec_wheel(index, clockwise, count)) {
+        return;
+    }
+#        endif // MOUSEKEY_ENABLE
+    for (uint8_t i = 0; i < count; i++) {
+        encoder_exec(index, clockwise);
+    }
+#    else // ENCODER_MAP_ENABLE
+    // Detents per second, since the previous batch of this encoder
+    uint16_t elapsed           = timer_elapsed(encoder_batch_times[index]);
+    uint16_t velocity          = (uint32_t)count * 1000 / (elapsed < 1 ? 1 : (elapsed > 1000 ? 1000 : elapsed));
+    encoder_batch_times[index] = timer_read();
+
+    encoder_update_batch_kb(index, clockwise, count, velocity);
+#    endif // ENCODER_MAP_ENABLE
+}
 
+static bool encoder_handle_queue(void) {
+    bool    changed = false;
+    uint8_t index;
+    bool    clockwise;
+    while (encoder_dequeue_event(&index, &clockwise)) {
+        if (encoder_batch.count && (encoder_batch.index != index || encoder_batch.clockwise != clockwise || encoder_batch.count == UINT8_MAX)) {
+            encoder_exec_batch();
+        }
+        if (!encoder_batch.count) {
+            encoder_batch = (encoder_batch_t){.index = index, .clockwise = clockwise, .count = 0, .started = timer_read()};
+        }
+        encoder_batch.count++;
         changed = true;
     }
+
+    if (encoder_batch.count && timer_elapsed(encoder_batch.started) >= ENCODER_BATCH_INTERVAL) {
+        encoder_exec_batch();
+    }
     return changed;
 }
+#else // ENCODER_BATCHING
+static bool encoder_handle_queue(void) {
+    bool    changed = false;
+    uint8_t index;
+    bool    clockwise;
+    while (encoder_dequeue_event(&index, &clockwise)) {
+        encoder_exec(index, clockwise);
+        changed = true;
+    }
+    return changed;
+}
+#endif // ENCODER_BATCHING
 
 bool encoder_task(void) {
     bool changed = false;
@@ -152,6 +255,23 @@ __attribute__((weak)) bool encoder_update_user(uint8_t index, bool clockwise) {
     return true;
 }
 
+#ifdef ENCODER_BATCHING
+__attribute__((weak)) bool encoder_update_batch_user(uint8_t index, bool clockwise, uint8_t count, uint16_t velocity) {
+    return true;
+}
+
+__attribute__((weak)) bool encoder_update_batch_kb(uint8_t index, bool clockwise, uint8_t count, uint16_t velocity) {
+    bool res = encoder_update_batch_user(index, clockwise, count, velocity);
+    if (res) {
+        // Detent by detent, for the keyboards that only handle single ones
+        for (uint8_t i = 0; i < count; i++) {
+            encoder_update_kb(index, clockwise);
+        }
+    }
+    return res;
+}
+#endif // ENCODER_BATCHING
+
 __attribute__((weak)) bool encoder_update_kb(uint8_t index, bool clockwise) {
     bool res = encoder_update_user(index, clockwise);
 #if !defined(ENCODER_TESTS)
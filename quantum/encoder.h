@@ -49,6 +49,12 @@ bool encoder_dequeue_event(uint8_t *index, bool *clockwise);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+#    ifdef ENCODER_BATCHING
+// Consecutive detents in the same direction, velocity in detents per second
+bool encoder_update_batch_kb(uint8_t index, bool clockwise, uint8_t count, uint16_t velocity);
+bool encoder_update_batch_user(uint8_t index, bool clockwise, uint8_t count, uint16_t velocity);
+#    endif // ENCODER_BATCHING
+
 #    ifdef SPLIT_KEYBOARD
 
 #        if defined(ENCODER_A_PINS_RIGHT)
@@ -120,4 +126,11 @@ extern const uint16_t encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS];
 void encoder_driver_init(void);
 void encoder_driver_task(void);
 
+#    ifdef ENCODER_DRIVER_INTERRUPT
+// Called from pin change interrupts, on platforms where the driver can't set them up itself
+void encoder_interrupt_handle_edge(uint8_t index);
+void encoder_interrupt_add_pulses(uint8_t index, int16_t pulses);
+void encoder_interrupt_init_kb(void);
+#    endif // ENCODER_DRIVER_INTERRUPT
+
 #endif // ENCODER_ENABLE
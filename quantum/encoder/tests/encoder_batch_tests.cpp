@@ -0,0 +1,102 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+struct batch {
+    uint8_t  index;
+    bool     clockwise;
+    uint8_t  count;
+    uint16_t velocity;
+};
+
+std::vector<batch> batches;
+int                single_updates = 0;
+bool               batch_handled  = true;
+
+bool encoder_update_batch_user(uint8_t index, bool clockwise, uint8_t count, uint16_t velocity) {
+    batches.push_back({index, clockwise, count, velocity});
+    return !batch_handled;
+}
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    single_updates++;
+    return true;
+}
+
+void queue(bool clockwise, int detents) {
+    for (int i = 0; i < detents; i++) {
+        encoder_queue_event(0, clockwise);
+    }
+}
+
+class EncoderBatchTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        batches.clear();
+        single_updates = 0;
+        batch_handled  = true;
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderBatchTest, TestFastSpinIsOneBatch) {
+    queue(true, 10);
+    EXPECT_TRUE(encoder_task());
+
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].index, 0);
+    EXPECT_EQ(batches[0].clockwise, true);
+    EXPECT_EQ(batches[0].count, 10);
+    EXPECT_EQ(single_updates, 0);
+}
+
+TEST_F(EncoderBatchTest, TestDirectionChangeSplitsBatches) {
+    queue(true, 3);
+    queue(false, 2);
+    queue(true, 1);
+    encoder_task();
+
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(batches[0].count, 3);
+    EXPECT_EQ(batches[1].clockwise, false);
+    EXPECT_EQ(batches[1].count, 2);
+    EXPECT_EQ(batches[2].clockwise, true);
+    EXPECT_EQ(batches[2].count, 1);
+}
+
+TEST_F(EncoderBatchTest, TestVelocity) {
+    queue(true, 1);
+    encoder_task();
+    advance_time(100);
+    queue(true, 5);
+    encoder_task();
+
+    ASSERT_EQ(batches.size(), 2u);
+    // Nothing to compare the first batch with
+    EXPECT_EQ(batches[0].velocity, 1);
+    // 5 detents in 100ms
+    EXPECT_EQ(batches[1].velocity, 50);
+}
+
+TEST_F(EncoderBatchTest, TestUnhandledBatchFallsBackToSingleUpdates) {
+    batch_handled = false;
+    queue(false, 4);
+    encoder_task();
+
+    EXPECT_EQ(batches.size(), 1u);
+    EXPECT_EQ(single_updates, 4);
+}
+
+TEST_F(EncoderBatchTest, TestNoEventsNoBatch) {
+    EXPECT_FALSE(encoder_task());
+    EXPECT_TRUE(batches.empty());
+}
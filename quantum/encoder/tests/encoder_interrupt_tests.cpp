@@ -0,0 +1,124 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+}
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+std::vector<update> updates;
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates.push_back({static_cast<int8_t>(index), clockwise});
+    return true;
+}
+
+// The pin change interrupt, firing without the main loop getting a look in
+void edge(pin_t pin, bool val) {
+    setPin(pin, val);
+    encoder_interrupt_handle_edge(0);
+}
+
+void clockwise_detent(void) {
+    edge(0, false);
+    edge(1, false);
+    edge(0, true);
+    edge(1, true);
+}
+
+void counter_clockwise_detent(void) {
+    edge(1, false);
+    edge(0, false);
+    edge(1, true);
+    edge(0, true);
+}
+
+class EncoderInterruptTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        updates.clear();
+        setPin(0, true);
+        setPin(1, true);
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderInterruptTest, TestInit) {
+    EXPECT_EQ(pinIsInputHigh[0], true);
+    EXPECT_EQ(pinIsInputHigh[1], true);
+    EXPECT_FALSE(encoder_task());
+    EXPECT_TRUE(updates.empty());
+}
+
+TEST_F(EncoderInterruptTest, TestOneClockwise) {
+    clockwise_detent();
+    EXPECT_TRUE(encoder_task());
+
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestOneCounterClockwise) {
+    counter_clockwise_detent();
+    EXPECT_TRUE(encoder_task());
+
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, false);
+}
+
+TEST_F(EncoderInterruptTest, TestPartialDetentCarriesOver) {
+    edge(0, false);
+    edge(1, false);
+    encoder_task();
+    EXPECT_TRUE(updates.empty());
+
+    edge(0, true);
+    edge(1, true);
+    encoder_task();
+    EXPECT_EQ(updates.size(), 1u);
+}
+
+TEST_F(EncoderInterruptTest, TestBusyLoopKeepsEveryDetent) {
+    // Far more detents than the event queue holds, all before the main loop runs again
+    for (int i = 0; i < 25; i++) {
+        clockwise_detent();
+    }
+    for (int i = 0; i < 3; i++) {
+        counter_clockwise_detent();
+    }
+
+    int tasks = 0;
+    while (encoder_task()) {
+        tasks++;
+    }
+    EXPECT_GT(tasks, 1);
+    ASSERT_EQ(updates.size(), 22u);
+    for (const update &u : updates) {
+        EXPECT_EQ(u.clockwise, true);
+    }
+}
+
+TEST_F(EncoderInterruptTest, TestHardwareCount) {
+    // A timer in encoder mode counts the pulses, the driver only gets the difference
+    encoder_interrupt_add_pulses(0, 9);
+    encoder_task();
+    ASSERT_EQ(updates.size(), 2u);
+    EXPECT_EQ(updates[0].clockwise, false);
+
+    encoder_interrupt_add_pulses(0, -13);
+    while (encoder_task()) {
+    }
+    ASSERT_EQ(updates.size(), 5u);
+    EXPECT_EQ(updates[2].clockwise, true);
+    EXPECT_EQ(updates[4].clockwise, true);
+}
@@ -0,0 +1,44 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_event_queue.h"
+
+#define KEY_EVENT_QUEUE_MASK (KEY_EVENT_QUEUE_SIZE - 1)
+
+static keyevent_t queue[KEY_EVENT_QUEUE_SIZE];
+
+// Only written by the producer
+static uint8_t queue_head = 0;
+// Only written by the consumer
+static uint8_t queue_tail = 0;
+
+bool key_event_queue_push(keyevent_t event) {
+    const uint8_t head = queue_head;
+    const uint8_t next = (head + 1) & KEY_EVENT_QUEUE_MASK;
+
+    if (next == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    queue[head] = event;
+    // Publish the event only once it has been written
+    __atomic_store_n(&queue_head, next, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool key_event_queue_pop(keyevent_t *event) {
+    const uint8_t tail = queue_tail;
+
+    if (tail == __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    *event = queue[tail];
+    // Hand the slot back only once it has been read
+    __atomic_store_n(&queue_tail, (tail + 1) & KEY_EVENT_QUEUE_MASK, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool key_event_queue_is_empty(void) {
+    return __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE) == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,50 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+/**
+ * \file
+ *
+ * \defgroup key_event_queue Key event queue
+ *
+ * A lock-free single producer, single consumer ring buffer of key events.
+ * With MATRIX_SCAN_ASYNC, the matrix is scanned from a thread or interrupt
+ * that pushes the changed keys, stamped with the time they were scanned,
+ * and the main loop pops and processes them at its own pace.
+ *
+ * Only one context may push and only one may pop; neither needs to
+ * disable interrupts or take a lock.
+ * \{
+ */
+
+#ifndef KEY_EVENT_QUEUE_SIZE
+#    define KEY_EVENT_QUEUE_SIZE 32
+#endif
+
+_Static_assert(KEY_EVENT_QUEUE_SIZE >= 2 && KEY_EVENT_QUEUE_SIZE <= 128 && (KEY_EVENT_QUEUE_SIZE & (KEY_EVENT_QUEUE_SIZE - 1)) == 0, "KEY_EVENT_QUEUE_SIZE must be a power of two between 2 and 128");
+
+/**
+ * \brief Appends an event. Producer side only.
+ *
+ * \return false if the queue is full, holding KEY_EVENT_QUEUE_SIZE - 1 events
+ */
+bool key_event_queue_push(keyevent_t event);
+
+/**
+ * \brief Removes the oldest event. Consumer side only.
+ *
+ * \return false if the queue is empty
+ */
+bool key_event_queue_pop(keyevent_t *event);
+
+/**
+ * \brief Whether the queue holds any event.
+ */
+bool key_event_queue_is_empty(void);
+
+/** \} */
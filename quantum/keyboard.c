@@ -16,6 +16,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode_config.h"
 #include "matrix.h"
@@ -32,6 +33,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "synchronization_util.h"
+#include "action_tapping.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -59,6 +62,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef RGB_MATRIX_ENABLE
 #    include "rgb_matrix.h"
 #endif
+#ifdef LED_COMPOSITOR_ENABLE
+#    include "led_compositor.h"
+#endif
+#ifdef SEND_STRING_ENABLE
+#    include "send_string.h"
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
+#ifdef MATRIX_SCAN_ASYNC
+#    include "key_event_queue.h"
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif
@@ -104,6 +122,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+#    include "dynamic_keymap_flash.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -163,6 +187,11 @@ void last_matrix_activity_trigger(void) {
     last_matrix_modification_time = last_input_modification_time = sync_timer_read32();
 }
 
+static uint16_t matrix_scan_time = 0;
+uint16_t        last_matrix_scan_time(void) {
+    return matrix_scan_time;
+}
+
 static uint32_t last_encoder_modification_time = 0;
 uint32_t        last_encoder_activity_time(void) {
     return last_encoder_modification_time;
@@ -313,6 +342,28 @@ __attribute__((weak)) bool matrix_can_read(void) {
     return true;
 }
 
+#ifdef MATRIX_SCAN_ASYNC
+#    ifdef SPLIT_KEYBOARD
+#        error "MATRIX_SCAN_ASYNC is not supported on split keyboards"
+#    endif
+
+static bool     matrix_scan_async_running = false;
+static uint16_t matrix_scan_async_time    = 0;
+
+/** \brief matrix_scan_async_start
+ *
+ * Platforms able to scan the matrix in the background override this to
+ * call matrix_scan_async_task() periodically from a thread or interrupt.
+ */
+__attribute__((weak)) bool matrix_scan_async_start(void) {
+    return false;
+}
+
+bool matrix_scan_async_is_running(void) {
+    return matrix_scan_async_running;
+}
+#endif
+
 /** \brief keyboard_setup
  *
  * FIXME: needs doc
@@ -411,6 +462,9 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
@@ -488,10 +542,16 @@ void keyboard_init(void) {
 #ifdef HAPTIC_ENABLE
     haptic_init();
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_init();
+#endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
+#ifdef MATRIX_SCAN_ASYNC
+    matrix_scan_async_running = matrix_scan_async_start();
+#endif
 
     keyboard_post_init_kb(); /* Always keep this last */
 }
@@ -513,16 +573,105 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
  * internal QMK state machine.
+ *
+ * @param time the time up to which the matrix is known to be unchanged
  */
-static inline void generate_tick_event(void) {
+static inline void generate_tick_event(uint16_t time) {
     static uint16_t last_tick = 0;
-    const uint16_t  now       = timer_read();
-    if (TIMER_DIFF_16(now, last_tick) != 0) {
-        action_exec(MAKE_TICK_EVENT);
-        last_tick = now;
+    if (TIMER_DIFF_16(time, last_tick) != 0) {
+        action_exec(MAKE_TIMED_EVENT(0, 0, false, TICK_EVENT, time));
+        last_tick = time;
     }
 }
 
+#ifdef MATRIX_SCAN_ASYNC
+/**
+ * @brief Scans the matrix and queues an event, stamped with the scan time,
+ * for every key that changed. Only reads the matrix, matrix_scan_kb() is
+ * left to the main loop. If the queue is full, the remaining changes
+ * are left for the next scan rather than dropped.
+ *
+ * Once every change is queued, the scan time is published so the consumer
+ * knows it may time out tapping decisions up to that point.
+ *
+ * @return true if any key changed
+ */
+bool matrix_scan_async_task(void) {
+    static matrix_row_t matrix_previous[MATRIX_ROWS];
+
+    if (!matrix_can_read()) {
+        // Nothing can have changed, let tapping decisions time out
+        __atomic_store_n(&matrix_scan_async_time, timer_read(), __ATOMIC_RELEASE);
+        return false;
+    }
+
+    matrix_scan();
+    const uint16_t time = timer_read();
+
+    bool matrix_changed = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current_row = matrix_get_row(row);
+        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+
+        if (!row_changes || has_ghost_in_row(row, current_row)) {
+            continue;
+        }
+
+        matrix_changed        = true;
+        matrix_row_t col_mask = 1;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
+            if (row_changes & col_mask) {
+                if (!key_event_queue_push(MAKE_TIMED_EVENT(row, col, current_row & col_mask, KEY_EVENT, time))) {
+                    return matrix_changed;
+                }
+                matrix_previous[row] ^= col_mask;
+            }
+        }
+    }
+
+    __atomic_store_n(&matrix_scan_async_time, time, __ATOMIC_RELEASE);
+    return matrix_changed;
+}
+
+/**
+ * @brief Processes the key events queued by matrix_scan_async_task().
+ */
+static bool matrix_task(void) {
+    if (!matrix_scan_async_running) {
+        matrix_scan_async_task();
+    }
+
+    matrix_scan_perf_task();
+
+    // Read before draining: every change up to this time is already queued
+    matrix_scan_time = __atomic_load_n(&matrix_scan_async_time, __ATOMIC_ACQUIRE);
+
+    // Keyboard and user code shares state with the main loop, so it never runs in the scan thread
+    matrix_scan_kb();
+
+    const bool process_keypress = should_process_keypress();
+    bool       matrix_changed   = false;
+    keyevent_t event;
+
+    while (key_event_queue_pop(&event)) {
+        matrix_changed = true;
+
+        if (process_keypress) {
+            action_exec(event);
+        }
+
+        switch_events(event.key.row, event.key.col, event.pressed);
+    }
+
+    if (!matrix_changed) {
+        generate_tick_event(matrix_scan_time);
+    } else if (debug_config.matrix) {
+        matrix_print();
+    }
+
+    return matrix_changed;
+}
+#else
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -532,13 +681,16 @@ static inline void generate_tick_event(void) {
  */
 static bool matrix_task(void) {
     if (!matrix_can_read()) {
-        generate_tick_event();
+        matrix_scan_time = timer_read();
+        generate_tick_event(matrix_scan_time);
         return false;
     }
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
+    // All changes of one scan share its time, however long processing the earlier ones takes
+    matrix_scan_time = timer_read();
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
         matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
@@ -548,7 +700,7 @@ static bool matrix_task(void) {
 
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
-        generate_tick_event();
+        generate_tick_event(matrix_scan_time);
         return matrix_changed;
     }
 
@@ -572,7 +724,7 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    action_exec(MAKE_TIMED_EVENT(row, col, key_pressed, KEY_EVENT, matrix_scan_time));
                 }
 
                 switch_events(row, col, key_pressed);
@@ -584,6 +736,7 @@ static bool matrix_task(void) {
 
     return matrix_changed;
 }
+#endif
 
 /** \brief Tasks previously located in matrix_scan_quantum
  *
@@ -662,22 +815,18 @@ void quantum_task(void) {
 #ifdef LAYER_LOCK_ENABLE
     layer_lock_task();
 #endif
-}
 
-/** \brief Main task that is repeatedly called as fast as possible. */
-void keyboard_task(void) {
-    __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
-        last_matrix_activity_trigger();
-        activity_has_occurred = true;
-    }
-
-    quantum_task();
+#if defined(SEND_STRING_ENABLE) && defined(SENDSTRING_ASYNC)
+    send_string_task();
+#endif
 
-#if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
 #endif
+}
 
+/** \brief Lighting tasks, rendering from the keyboard state. */
+static void lighting_task(void) {
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
 #endif
@@ -688,27 +837,19 @@ void keyboard_task(void) {
 #ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
 #endif
+#ifdef LED_COMPOSITOR_ENABLE
+    led_compositor_task();
+#endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
     backlight_task();
 #    endif
 #endif
+}
 
-#ifdef ENCODER_ENABLE
-    if (encoder_task()) {
-        last_encoder_activity_trigger();
-        activity_has_occurred = true;
-    }
-#endif
-
-#ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
-        last_pointing_device_activity_trigger();
-        activity_has_occurred = true;
-    }
-#endif
-
+/** \brief Display tasks, woken up by any input activity. */
+static void display_task(bool activity_has_occurred) {
 #ifdef OLED_ENABLE
     oled_task();
 #    if OLED_TIMEOUT > 0
@@ -724,6 +865,117 @@ void keyboard_task(void) {
     if (activity_has_occurred) st7565_on();
 #    endif
 #endif
+}
+
+#ifdef THREADED_TASKS
+#    ifndef THREADED_TASKS_MAX_FLUSHES
+#        define THREADED_TASKS_MAX_FLUSHES 4
+#    endif
+
+static bool display_wakeup    = false;
+static bool lighting_rendering = false;
+static void (*lighting_flushes[THREADED_TASKS_MAX_FLUSHES])(void);
+static uint8_t lighting_flush_count = 0;
+
+void keyboard_lighting_request_flush(void (*flush)(void)) {
+    if (!lighting_rendering) {
+        // Not from the lighting thread, e.g. the keymap or suspend, which expect the LEDs to update right away
+        flush();
+        return;
+    }
+
+    for (uint8_t i = 0; i < lighting_flush_count; i++) {
+        if (lighting_flushes[i] == flush) {
+            return;
+        }
+    }
+
+    if (lighting_flush_count < THREADED_TASKS_MAX_FLUSHES) {
+        lighting_flushes[lighting_flush_count++] = flush;
+    } else {
+        // Out of slots, better late than never
+        flush();
+    }
+}
+
+/** \brief Runs the lighting and display tasks from their own thread.
+ *
+ * The keyboard state lock is only held while the frames are drawn into
+ * RAM, which is where the effects, indicators and display callbacks read
+ * the keyboard state. Sending them over I2C or SPI happens after it is
+ * released, so the input thread never waits for a bus transfer; the bus
+ * drivers have their own mutex for that.
+ */
+void keyboard_lighting_task(void) {
+    void (*flushes[THREADED_TASKS_MAX_FLUSHES])(void);
+
+    keyboard_state_lock();
+    lighting_rendering = true;
+    lighting_task();
+
+    display_task(display_wakeup);
+    display_wakeup = false;
+
+    uint8_t flush_count = lighting_flush_count;
+    memcpy(flushes, lighting_flushes, sizeof(flushes[0]) * flush_count);
+    lighting_flush_count = 0;
+    lighting_rendering   = false;
+    keyboard_state_unlock();
+
+    for (uint8_t i = 0; i < flush_count; i++) {
+        flushes[i]();
+    }
+
+#    ifdef OLED_ENABLE
+    oled_render();
+#    endif
+#    ifdef ST7565_ENABLE
+    st7565_render();
+#    endif
+#    ifdef QUANTUM_PAINTER_ENABLE
+    void qp_internal_task(void);
+    qp_internal_task();
+#    endif
+}
+#endif
+
+/** \brief Main task that is repeatedly called as fast as possible. */
+void keyboard_task(void) {
+    __attribute__((unused)) bool activity_has_occurred = false;
+    if (matrix_task()) {
+        last_matrix_activity_trigger();
+        activity_has_occurred = true;
+    }
+
+    quantum_task();
+
+#if defined(SPLIT_WATCHDOG_ENABLE)
+    split_watchdog_task();
+#endif
+
+#ifndef THREADED_TASKS
+    lighting_task();
+#endif
+
+#ifdef ENCODER_ENABLE
+    if (encoder_task()) {
+        last_encoder_activity_trigger();
+        activity_has_occurred = true;
+    }
+#endif
+
+#ifdef POINTING_DEVICE_ENABLE
+    if (pointing_device_task()) {
+        last_pointing_device_activity_trigger();
+        activity_has_occurred = true;
+    }
+#endif
+
+#ifdef THREADED_TASKS
+    if (activity_has_occurred) display_wakeup = true;
+#else
+    display_task(activity_has_occurred);
+#endif
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
@@ -752,7 +1004,40 @@ void keyboard_task(void) {
 
     led_task();
 
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+    dynamic_keymap_flash_task();
+#endif
+
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
 }
+
+static inline __attribute__((unused)) uint32_t earliest_timeout(uint32_t a, uint32_t b) {
+    return a < b ? a : b;
+}
+
+/** \brief Milliseconds until the next internal timeout is due
+ *
+ * Covers the tapping term, combos, tap dance, Auto Shift and deferred executors; with no key changes
+ * in between, nothing those features do can change before then. Returns UINT32_MAX if nothing is pending.
+ */
+uint32_t keyboard_next_timeout(void) {
+    uint32_t timeout = UINT32_MAX;
+#ifndef NO_ACTION_TAPPING
+    timeout = earliest_timeout(timeout, action_tapping_next_timeout());
+#endif
+#ifdef COMBO_ENABLE
+    timeout = earliest_timeout(timeout, combo_next_timeout());
+#endif
+#ifdef TAP_DANCE_ENABLE
+    timeout = earliest_timeout(timeout, tap_dance_next_timeout());
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    timeout = earliest_timeout(timeout, autoshift_next_timeout());
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    timeout = earliest_timeout(timeout, deferred_exec_next_timeout());
+#endif
+    return timeout;
+}
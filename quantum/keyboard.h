@@ -74,7 +74,8 @@ static inline bool IS_DIPSWITCHEVENT(const keyevent_t event) {
 #define MAKE_KEYPOS(row_num, col_num) ((keypos_t){.row = (row_num), .col = (col_num)})
 
 /* Common keyevent_t object factory */
-#define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type)})
+#define MAKE_TIMED_EVENT(row_num, col_num, press, event_type, event_time) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = (event_time), .type = (event_type)})
+#define MAKE_EVENT(row_num, col_num, press, event_type) MAKE_TIMED_EVENT((row_num), (col_num), (press), (event_type), timer_read())
 
 /**
  * @brief Constructs a key event for a pressed or released key.
@@ -109,6 +110,12 @@ void keyboard_setup(void);
 void keyboard_init(void);
 /* it runs repeatedly in main loop */
 void keyboard_task(void);
+#ifdef THREADED_TASKS
+/* it runs repeatedly in the lighting thread */
+void keyboard_lighting_task(void);
+/* it queues a driver flush for the lighting thread to run once the keyboard state is unlocked, anywhere else it flushes right away */
+void keyboard_lighting_request_flush(void (*flush)(void));
+#endif
 /* it runs whenever code has to behave differently on a slave */
 bool is_keyboard_master(void);
 /* it runs whenever code has to behave differently on left vs right split */
@@ -129,6 +136,9 @@ uint32_t last_input_activity_elapsed(void); // Number of milliseconds since the
 uint32_t last_matrix_activity_time(void);    // Timestamp of the last matrix activity
 uint32_t last_matrix_activity_elapsed(void); // Number of milliseconds since the last matrix activity
 
+uint16_t last_matrix_scan_time(void); // Timestamp of the last matrix scan whose changes have all been processed
+uint32_t keyboard_next_timeout(void); // Milliseconds until the next tapping, combo, tap dance, Auto Shift or deferred exec timeout
+
 uint32_t last_encoder_activity_time(void);    // Timestamp of the last encoder activity
 uint32_t last_encoder_activity_elapsed(void); // Number of milliseconds since the last encoder activity
 
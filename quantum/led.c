@@ -18,6 +18,7 @@
 #include "timer.h"
 #include "debug.h"
 #include "gpio.h"
+#include "state_change.h"
 
 #ifdef BACKLIGHT_CAPS_LOCK
 #    ifdef BACKLIGHT_ENABLE
@@ -176,6 +177,7 @@ void led_task(void) {
     if (last_led_status != led_status) {
         last_led_status            = led_status;
         last_led_modification_time = timer_read32();
+        state_publish(STATE_HOST_LEDS);
 
         if (debug_keyboard) {
             dprintf("led_task: %02X\n", led_status);
@@ -0,0 +1,107 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "led_compositor.h"
+#include "sync_timer.h"
+#ifdef THREADED_TASKS
+#    include "keyboard.h"
+#endif
+
+static uint32_t               frame_timer = 0;
+static uint16_t               frame       = 0;
+static led_compositor_flush_t flushes[LED_COMPOSITOR_MAX_FLUSHES];
+static uint8_t                flush_count = 0;
+
+static led_compositor_layer_t *layers[LED_COMPOSITOR_MAX_LAYERS];
+static uint8_t                 layer_count   = 0;
+static uint8_t                 current_alpha = UINT8_MAX;
+
+uint16_t led_compositor_frame(void) {
+    return frame;
+}
+
+void led_compositor_request_flush(led_compositor_flush_t flush) {
+    for (uint8_t i = 0; i < flush_count; i++) {
+        if (flushes[i] == flush) {
+            return;
+        }
+    }
+
+    if (flush_count < LED_COMPOSITOR_MAX_FLUSHES) {
+        flushes[flush_count++] = flush;
+    } else {
+        // Out of slots, better early than never
+        flush();
+    }
+}
+
+bool led_compositor_add_layer(led_compositor_layer_t *layer) {
+    for (uint8_t i = 0; i < layer_count; i++) {
+        if (layers[i] == layer) {
+            return true;
+        }
+    }
+
+    if (layer_count >= LED_COMPOSITOR_MAX_LAYERS) {
+        return false;
+    }
+
+    // Keep the list sorted by priority, layers of equal priority are drawn in the order they were added
+    uint8_t i = layer_count;
+    while (i > 0 && layers[i - 1]->priority > layer->priority) {
+        layers[i] = layers[i - 1];
+        i--;
+    }
+    layers[i] = layer;
+    layer_count++;
+    return true;
+}
+
+void led_compositor_remove_layer(led_compositor_layer_t *layer) {
+    for (uint8_t i = 0; i < layer_count; i++) {
+        if (layers[i] == layer) {
+            for (uint8_t j = i + 1; j < layer_count; j++) {
+                layers[j - 1] = layers[j];
+            }
+            layer_count--;
+            return;
+        }
+    }
+}
+
+void led_compositor_render_layers(uint8_t led_min, uint8_t led_max) {
+    for (uint8_t i = 0; i < layer_count; i++) {
+        if (layers[i]->alpha == 0) {
+            continue;
+        }
+        current_alpha = layers[i]->alpha;
+        layers[i]->render(led_min, led_max);
+    }
+    current_alpha = UINT8_MAX;
+}
+
+uint8_t led_compositor_alpha(void) {
+    return current_alpha;
+}
+
+void led_compositor_flush(void) {
+    for (uint8_t i = 0; i < flush_count; i++) {
+#ifdef THREADED_TASKS
+        // From the lighting thread, sent once it released the keyboard state
+        keyboard_lighting_request_flush(flushes[i]);
+#else
+        flushes[i]();
+#endif
+    }
+    flush_count = 0;
+}
+
+void led_compositor_task(void) {
+    if (sync_timer_elapsed32(frame_timer) < LED_COMPOSITOR_FRAME_TIME) {
+        return;
+    }
+    frame_timer = sync_timer_read32();
+
+    led_compositor_flush();
+    frame++;
+}
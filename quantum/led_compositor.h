@@ -0,0 +1,86 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup led_compositor LED frame compositor
+ *
+ * Owns a single frame clock shared by RGB Matrix, LED Matrix and RGBLight.
+ * Each renderer starts at most one frame per compositor frame and hands its
+ * flush over instead of writing to the hardware directly; all pending
+ * flushes then go out together, once each, when the frame ends. On top of
+ * the RGB Matrix effect and indicators, overlay layers are drawn in
+ * priority order and alpha blended.
+ * \{
+ */
+
+#ifndef LED_COMPOSITOR_FRAME_TIME
+#    define LED_COMPOSITOR_FRAME_TIME 16
+#endif
+
+#ifndef LED_COMPOSITOR_MAX_FLUSHES
+#    define LED_COMPOSITOR_MAX_FLUSHES 4
+#endif
+
+#ifndef LED_COMPOSITOR_MAX_LAYERS
+#    define LED_COMPOSITOR_MAX_LAYERS 4
+#endif
+
+typedef void (*led_compositor_flush_t)(void);
+
+typedef struct led_compositor_layer_t {
+    uint8_t priority; // layers are drawn in ascending priority, after the effect and indicators
+    uint8_t alpha;    // opacity, from 0 (invisible) to 255 (opaque)
+    void (*render)(uint8_t led_min, uint8_t led_max);
+} led_compositor_layer_t;
+
+/**
+ * \brief The current frame number, incremented each time a frame ends.
+ */
+uint16_t led_compositor_frame(void);
+
+/**
+ * \brief Queues a driver flush for the end of the current frame.
+ *
+ * Requesting the same flush more than once per frame only runs it once.
+ */
+void led_compositor_request_flush(led_compositor_flush_t flush);
+
+/**
+ * \brief Runs all pending flushes immediately, without waiting for the frame to end.
+ */
+void led_compositor_flush(void);
+
+/**
+ * \brief Adds an overlay layer. The layer must stay valid until removed.
+ *
+ * Adding a layer that is already registered does nothing.
+ *
+ * \return false if LED_COMPOSITOR_MAX_LAYERS are already registered
+ */
+bool led_compositor_add_layer(led_compositor_layer_t *layer);
+
+/**
+ * \brief Removes a previously added overlay layer.
+ */
+void led_compositor_remove_layer(led_compositor_layer_t *layer);
+
+/**
+ * \brief Draws all overlay layers for the given LED range.
+ */
+void led_compositor_render_layers(uint8_t led_min, uint8_t led_max);
+
+/**
+ * \brief The opacity colors are currently drawn with: that of the layer being rendered, 255 otherwise.
+ */
+uint8_t led_compositor_alpha(void);
+
+void led_compositor_task(void);
+
+/** \} */
@@ -31,6 +31,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef LED_COMPOSITOR_ENABLE
+#    include "led_compositor.h"
+#endif
+
 #ifndef LED_MATRIX_CENTER
 const led_point_t k_led_matrix_center = {112, 32};
 #else
@@ -74,6 +78,9 @@ static uint8_t         led_last_enable   = UINT8_MAX;
 static uint8_t         led_last_effect   = UINT8_MAX;
 static effect_params_t led_effect_params = {0, LED_FLAG_ALL, false};
 static led_task_states led_task_state    = SYNCING;
+#ifdef LED_COMPOSITOR_ENABLE
+static uint16_t led_last_frame = 0;
+#endif
 
 // double buffers
 static uint32_t led_timer_buffer;
@@ -242,7 +249,15 @@ static void led_task_timers(void) {
 static void led_task_sync(void) {
     eeconfig_flush_led_matrix(false);
     // next task
+#ifdef LED_COMPOSITOR_ENABLE
+    // Start a new frame each time the compositor does
+    if (led_last_frame != led_compositor_frame()) {
+        led_last_frame = led_compositor_frame();
+        led_task_state = STARTING;
+    }
+#else
     if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
+#endif
 }
 
 static void led_task_start(void) {
@@ -318,7 +333,13 @@ static void led_task_flush(uint8_t effect) {
     led_last_enable = led_matrix_eeconfig.enable;
 
     // update pwm buffers
+#if defined(LED_COMPOSITOR_ENABLE)
+    led_compositor_request_flush(led_matrix_update_pwm_buffers);
+#elif defined(THREADED_TASKS)
+    keyboard_lighting_request_flush(led_matrix_update_pwm_buffers);
+#else
     led_matrix_update_pwm_buffers();
+#endif
 
     // next task
     led_task_state = SYNCING;
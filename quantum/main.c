@@ -46,6 +46,11 @@ int main(void) {
 
     /* Main loop */
     while (true) {
+#ifdef THREADED_TASKS
+        void keyboard_state_lock(void);
+        keyboard_state_lock();
+#endif
+
         protocol_pre_task();
         protocol_keyboard_task();
         protocol_post_task();
@@ -60,7 +65,7 @@ int main(void) {
         console_task();
 #endif
 
-#ifdef QUANTUM_PAINTER_ENABLE
+#if defined(QUANTUM_PAINTER_ENABLE) && !defined(THREADED_TASKS)
         // Run Quantum Painter task
         void qp_internal_task(void);
         qp_internal_task();
@@ -73,5 +78,14 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef THREADED_TASKS
+        void keyboard_state_unlock(void);
+        keyboard_state_unlock();
+
+        // Leave the rest of the input period to the lower priority threads
+        void threaded_tasks_wait(void);
+        threaded_tasks_wait();
+#endif
     }
 }
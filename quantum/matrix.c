@@ -343,7 +343,10 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef MATRIX_SCAN_ASYNC
+    // Called from the main loop instead, this may run in the scan thread
     matrix_scan_kb();
+#    endif
 #endif
     return (uint8_t)changed;
 }
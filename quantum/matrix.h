@@ -75,6 +75,15 @@ void matrix_scan_kb(void);
 void matrix_init_user(void);
 void matrix_scan_user(void);
 
+#ifdef MATRIX_SCAN_ASYNC
+/* start scanning from a thread or interrupt, false if the main loop has to keep scanning */
+bool matrix_scan_async_start(void);
+/* whether the matrix is being scanned in the background */
+bool matrix_scan_async_is_running(void);
+/* scan and queue the changed keys, called from the background context */
+bool matrix_scan_async_task(void);
+#endif
+
 #ifdef SPLIT_KEYBOARD
 bool matrix_post_scan(void);
 void matrix_slave_scan_kb(void);
@@ -0,0 +1,59 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mouse_motion.h"
+
+#define MOUSE_MOTION_SEGMENT_SIZE (MOUSE_MOTION_CURVE_MAX / MOUSE_MOTION_CURVE_SEGMENTS)
+
+_Static_assert(MOUSE_MOTION_CURVE_MAX % MOUSE_MOTION_CURVE_SEGMENTS == 0, "Curve segments must evenly divide the curve range");
+
+uint16_t mouse_motion_curve_gain(const uint16_t *curve, uint16_t position) {
+    if (position >= MOUSE_MOTION_CURVE_MAX) {
+        return curve[MOUSE_MOTION_CURVE_SEGMENTS];
+    }
+
+    uint8_t  index = position / MOUSE_MOTION_SEGMENT_SIZE;
+    uint8_t  fract = position % MOUSE_MOTION_SEGMENT_SIZE;
+    uint16_t start = curve[index];
+    uint16_t end   = curve[index + 1];
+
+    return start + (((int32_t)end - start) * fract) / MOUSE_MOTION_SEGMENT_SIZE;
+}
+
+int32_t mouse_motion_apply_axis(int16_t *remainder, int32_t value, uint16_t gain) {
+    int32_t scaled = value * (int32_t)gain + *remainder;
+    // Division truncates towards zero, so the carry keeps the sign of the motion
+    int32_t whole = scaled / MOUSE_MOTION_ONE;
+    *remainder    = scaled - whole * MOUSE_MOTION_ONE;
+    return whole;
+}
+
+static inline uint16_t mouse_motion_combine_gain(uint16_t scale, uint16_t accel) {
+    uint32_t gain = ((uint32_t)scale * accel) >> MOUSE_MOTION_FRACT_BITS;
+    return gain > UINT16_MAX ? UINT16_MAX : gain;
+}
+
+void mouse_motion_apply(const mouse_motion_config_t *config, mouse_motion_state_t *state, int32_t *x, int32_t *y) {
+    uint16_t gain_x = config->scale_x;
+    uint16_t gain_y = config->scale_y;
+
+    if (config->curve && config->speed_max) {
+        // Octagonal approximation of the motion vector length: max + min / 2
+        uint32_t abs_x = *x < 0 ? -*x : *x;
+        uint32_t abs_y = *y < 0 ? -*y : *y;
+        uint32_t speed = abs_x > abs_y ? abs_x + abs_y / 2 : abs_y + abs_x / 2;
+        uint32_t pos   = (speed * MOUSE_MOTION_CURVE_MAX) / config->speed_max;
+        uint16_t accel = mouse_motion_curve_gain(config->curve, pos > MOUSE_MOTION_CURVE_MAX ? MOUSE_MOTION_CURVE_MAX : pos);
+
+        gain_x = mouse_motion_combine_gain(gain_x, accel);
+        gain_y = mouse_motion_combine_gain(gain_y, accel);
+    }
+
+    *x = mouse_motion_apply_axis(&state->x, *x, gain_x);
+    *y = mouse_motion_apply_axis(&state->y, *y, gain_y);
+}
+
+void mouse_motion_reset(mouse_motion_state_t *state) {
+    state->x = 0;
+    state->y = 0;
+}
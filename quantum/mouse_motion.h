@@ -0,0 +1,101 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup mouse_motion Fixed-point pointer motion engine
+ *
+ * Shared by the pointing device pipeline and mouse keys. Motion values are
+ * scaled with fixed-point gains, optionally shaped by an acceleration curve,
+ * and the fractional part left over after each report is carried into the
+ * next one so that down-scaled high-CPI sensors don't lose precision.
+ * \{
+ */
+
+/* Fixed-point format used for all gains: 1.0 == MOUSE_MOTION_ONE */
+#define MOUSE_MOTION_FRACT_BITS 8
+#define MOUSE_MOTION_ONE (1 << MOUSE_MOTION_FRACT_BITS)
+
+/* Express a gain as a ratio, e.g. MOUSE_MOTION_RATIO(1, 4) for quarter speed */
+#define MOUSE_MOTION_RATIO(num, den) ((uint16_t)(((uint32_t)(num) << MOUSE_MOTION_FRACT_BITS) / (den)))
+
+/* Acceleration curves are gain lookup tables of MOUSE_MOTION_CURVE_POINTS
+ * entries, evenly spread over positions 0..MOUSE_MOTION_CURVE_MAX and
+ * linearly interpolated in between. */
+#define MOUSE_MOTION_CURVE_SEGMENTS 16
+#define MOUSE_MOTION_CURVE_POINTS (MOUSE_MOTION_CURVE_SEGMENTS + 1)
+#define MOUSE_MOTION_CURVE_MAX 256
+
+// clang-format off
+#define MOUSE_MOTION_CURVE_POW(i, exp) \
+    ((exp) >= 3 ? (int32_t)(i) * (i) * (i) : (exp) == 2 ? (int32_t)(i) * (i) : (int32_t)(i))
+#define MOUSE_MOTION_CURVE_POINT(i, min, max, exp) \
+    ((uint16_t)((min) + ((int32_t)(max) - (int32_t)(min)) * MOUSE_MOTION_CURVE_POW(i, exp) / MOUSE_MOTION_CURVE_POW(MOUSE_MOTION_CURVE_SEGMENTS, exp)))
+
+/**
+ * \brief Generates a gain lookup table at compile time.
+ *
+ * The gain ramps from `min` to `max` following x^exp, where exp is 1 (linear),
+ * 2 (quadratic) or 3 (cubic). Use as an initialiser for a
+ * `const uint16_t name[MOUSE_MOTION_CURVE_POINTS]` array.
+ */
+#define MOUSE_MOTION_CURVE(min, max, exp) { \
+    MOUSE_MOTION_CURVE_POINT(0, min, max, exp),  MOUSE_MOTION_CURVE_POINT(1, min, max, exp),  \
+    MOUSE_MOTION_CURVE_POINT(2, min, max, exp),  MOUSE_MOTION_CURVE_POINT(3, min, max, exp),  \
+    MOUSE_MOTION_CURVE_POINT(4, min, max, exp),  MOUSE_MOTION_CURVE_POINT(5, min, max, exp),  \
+    MOUSE_MOTION_CURVE_POINT(6, min, max, exp),  MOUSE_MOTION_CURVE_POINT(7, min, max, exp),  \
+    MOUSE_MOTION_CURVE_POINT(8, min, max, exp),  MOUSE_MOTION_CURVE_POINT(9, min, max, exp),  \
+    MOUSE_MOTION_CURVE_POINT(10, min, max, exp), MOUSE_MOTION_CURVE_POINT(11, min, max, exp), \
+    MOUSE_MOTION_CURVE_POINT(12, min, max, exp), MOUSE_MOTION_CURVE_POINT(13, min, max, exp), \
+    MOUSE_MOTION_CURVE_POINT(14, min, max, exp), MOUSE_MOTION_CURVE_POINT(15, min, max, exp), \
+    MOUSE_MOTION_CURVE_POINT(16, min, max, exp)                                               \
+}
+// clang-format on
+
+typedef struct {
+    uint16_t        scale_x;   // per-axis gain, 1.0 == MOUSE_MOTION_ONE
+    uint16_t        scale_y;   // ...
+    const uint16_t *curve;     // optional acceleration curve, NULL to disable
+    uint16_t        speed_max; // input speed (counts per report) mapped to the end of the curve
+} mouse_motion_config_t;
+
+typedef struct {
+    int16_t x; // fractional carry, in 1/MOUSE_MOTION_ONE counts
+    int16_t y; // ...
+} mouse_motion_state_t;
+
+/**
+ * \brief Looks up the interpolated gain of a curve.
+ *
+ * \param curve lookup table of MOUSE_MOTION_CURVE_POINTS entries
+ * \param position 0..MOUSE_MOTION_CURVE_MAX, larger values are clamped
+ * \return gain, 1.0 == MOUSE_MOTION_ONE
+ */
+uint16_t mouse_motion_curve_gain(const uint16_t *curve, uint16_t position);
+
+/**
+ * \brief Scales a single axis, carrying the fractional part.
+ *
+ * \param remainder fractional carry for this axis, updated in place
+ * \param value raw motion
+ * \param gain 1.0 == MOUSE_MOTION_ONE
+ * \return whole counts to report
+ */
+int32_t mouse_motion_apply_axis(int16_t *remainder, int32_t value, uint16_t gain);
+
+/**
+ * \brief Scales and accelerates an x/y motion pair in place.
+ */
+void mouse_motion_apply(const mouse_motion_config_t *config, mouse_motion_state_t *state, int32_t *x, int32_t *y);
+
+/**
+ * \brief Drops any accumulated fractional motion.
+ */
+void mouse_motion_reset(mouse_motion_state_t *state);
+
+/** \} */
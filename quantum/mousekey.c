@@ -23,6 +23,9 @@
 #include "print.h"
 #include "debug.h"
 #include "mousekey.h"
+#ifdef MK_MOTION_CURVE
+#    include "mouse_motion.h"
+#endif
 
 static inline int8_t times_inv_sqrt2(int8_t x) {
     // 181/256 (0.70703125) is used as an approximation for 1/sqrt(2)
@@ -52,6 +55,21 @@ static int8_t  mousekey_y_inertia = 0; // ...
 #ifdef MK_KINETIC_SPEED
 static uint16_t mouse_timer = 0;
 #endif
+#ifdef MK_MOTION_CURVE
+static mouse_motion_state_t mousekey_motion = {0};
+#endif
+static uint8_t mousekey_wheel_detents = 1;
+
+/* Scales the wheel movement of a press by the detents it stands for */
+static mouse_hv_report_t wheel_detents_unit(uint16_t unit) {
+    uint32_t amount        = (uint32_t)unit * mousekey_wheel_detents;
+    mousekey_wheel_detents = 1;
+#ifdef WHEEL_EXTENDED_REPORT
+    return amount > INT16_MAX ? INT16_MAX : amount;
+#else
+    return amount > INT8_MAX ? INT8_MAX : amount;
+#endif
+}
 
 #ifndef MK_3_SPEED
 
@@ -110,6 +128,40 @@ static uint8_t move_unit(void) {
     return (unit > MOUSEKEY_MOVE_MAX ? MOUSEKEY_MOVE_MAX : (unit == 0 ? 1 : unit));
 }
 
+#                ifdef MK_MOTION_CURVE
+
+/*
+ * Curve-shaped acceleration
+ *
+ *  speed = delta * max_speed * curve(repeat / time_to_max)
+ *
+ * Speed is kept in fixed point (see mouse_motion.h), with fractional pixels
+ * carried between repeats, so slow speeds below one pixel per event work.
+ */
+static const uint16_t mk_motion_curve[MOUSE_MOTION_CURVE_POINTS] = MOUSE_MOTION_CURVE(0, MOUSE_MOTION_ONE, MK_MOTION_CURVE_EXPONENT);
+
+static uint16_t move_speed(void) {
+    uint32_t speed;
+    if (mousekey_accel & (1 << 0)) {
+        speed = ((uint32_t)MOUSEKEY_MOVE_DELTA * mk_max_speed * MOUSE_MOTION_ONE) / 4;
+    } else if (mousekey_accel & (1 << 1)) {
+        speed = ((uint32_t)MOUSEKEY_MOVE_DELTA * mk_max_speed * MOUSE_MOTION_ONE) / 2;
+    } else if (mousekey_accel & (1 << 2)) {
+        speed = (uint32_t)MOUSEKEY_MOVE_DELTA * mk_max_speed * MOUSE_MOTION_ONE;
+    } else if (mousekey_repeat >= mk_time_to_max) {
+        speed = (uint32_t)MOUSEKEY_MOVE_DELTA * mk_max_speed * MOUSE_MOTION_ONE;
+    } else {
+        uint16_t position = ((uint16_t)mousekey_repeat * MOUSE_MOTION_CURVE_MAX) / mk_time_to_max;
+        speed             = ((uint32_t)MOUSEKEY_MOVE_DELTA * mk_max_speed * mouse_motion_curve_gain(mk_motion_curve, position));
+    }
+    if (speed > (uint32_t)MOUSEKEY_MOVE_MAX * MOUSE_MOTION_ONE) {
+        speed = (uint32_t)MOUSEKEY_MOVE_MAX * MOUSE_MOTION_ONE;
+    }
+    return speed;
+}
+
+#                endif // MK_MOTION_CURVE
+
 #            else // MOUSEKEY_INERTIA mode
 
 static int8_t move_unit(uint8_t axis) {
@@ -341,6 +393,15 @@ void mousekey_task(void) {
 
     if ((tmpmr.x || tmpmr.y) && timer_elapsed(last_timer_c) > (mousekey_repeat ? mk_interval : mk_delay * 10)) {
         if (mousekey_repeat != UINT8_MAX) mousekey_repeat++;
+#        ifdef MK_MOTION_CURVE
+        uint16_t speed = move_speed();
+        /* diagonal move [1/sqrt(2)], exact in fixed point */
+        if (tmpmr.x && tmpmr.y) speed = ((uint32_t)speed * 181) / 256;
+        if (tmpmr.x != 0) mouse_report.x = mouse_motion_apply_axis(&mousekey_motion.x, (tmpmr.x > 0) ? 1 : -1, speed);
+        if (tmpmr.y != 0) mouse_report.y = mouse_motion_apply_axis(&mousekey_motion.y, (tmpmr.y > 0) ? 1 : -1, speed);
+        /* keep the repeat cadence while accumulating sub-pixel movement */
+        if (!mouse_report.x && !mouse_report.y) last_timer_c = timer_read();
+#        else
         if (tmpmr.x != 0) mouse_report.x = move_unit() * ((tmpmr.x > 0) ? 1 : -1);
         if (tmpmr.y != 0) mouse_report.y = move_unit() * ((tmpmr.y > 0) ? 1 : -1);
 
@@ -355,6 +416,7 @@ void mousekey_task(void) {
                 mouse_report.y = 1;
             }
         }
+#        endif // MK_MOTION_CURVE
     }
 
 #    endif // MOUSEKEY_INERTIA or not
@@ -429,13 +491,13 @@ void mousekey_on(uint8_t code) {
 #    endif // inertia or not
 
     else if (code == QK_MOUSE_WHEEL_UP)
-        mouse_report.v = wheel_unit();
+        mouse_report.v = wheel_detents_unit(wheel_unit());
     else if (code == QK_MOUSE_WHEEL_DOWN)
-        mouse_report.v = wheel_unit() * -1;
+        mouse_report.v = wheel_detents_unit(wheel_unit()) * -1;
     else if (code == QK_MOUSE_WHEEL_LEFT)
-        mouse_report.h = wheel_unit() * -1;
+        mouse_report.h = wheel_detents_unit(wheel_unit()) * -1;
     else if (code == QK_MOUSE_WHEEL_RIGHT)
-        mouse_report.h = wheel_unit();
+        mouse_report.h = wheel_detents_unit(wheel_unit());
     else if (IS_MOUSEKEY_BUTTON(code))
         mouse_report.buttons |= 1 << (code - QK_MOUSE_BUTTON_1);
     else if (code == QK_MOUSE_ACCELERATION_0)
@@ -493,6 +555,9 @@ void mousekey_off(uint8_t code) {
 #    ifdef MK_KINETIC_SPEED
         mouse_timer = 0;
 #    endif /* #ifdef MK_KINETIC_SPEED */
+#    ifdef MK_MOTION_CURVE
+        mouse_motion_reset(&mousekey_motion);
+#    endif
     }
     if (mouse_report.v == 0 && mouse_report.h == 0) mousekey_wheel_repeat = 0;
 }
@@ -577,13 +642,13 @@ void mousekey_on(uint8_t code) {
     else if (code == QK_MOUSE_CURSOR_RIGHT)
         mouse_report.x = c_offset;
     else if (code == QK_MOUSE_WHEEL_UP)
-        mouse_report.v = w_offset;
+        mouse_report.v = wheel_detents_unit(w_offset);
     else if (code == QK_MOUSE_WHEEL_DOWN)
-        mouse_report.v = w_offset * -1;
+        mouse_report.v = wheel_detents_unit(w_offset) * -1;
     else if (code == QK_MOUSE_WHEEL_LEFT)
-        mouse_report.h = w_offset * -1;
+        mouse_report.h = wheel_detents_unit(w_offset) * -1;
     else if (code == QK_MOUSE_WHEEL_RIGHT)
-        mouse_report.h = w_offset;
+        mouse_report.h = wheel_detents_unit(w_offset);
     else if (IS_MOUSEKEY_BUTTON(code))
         mouse_report.buttons |= 1 << (code - QK_MOUSE_BUTTON_1);
     else if (code == QK_MOUSE_ACCELERATION_0)
@@ -643,6 +708,9 @@ void mousekey_clear(void) {
     mousekey_repeat       = 0;
     mousekey_wheel_repeat = 0;
     mousekey_accel        = 0;
+#ifdef MK_MOTION_CURVE
+    mouse_motion_reset(&mousekey_motion);
+#endif
 #ifdef MOUSEKEY_INERTIA
     mousekey_frame     = 0;
     mousekey_x_inertia = 0;
@@ -671,6 +739,10 @@ static void mousekey_debug(void) {
     print(")\n");
 }
 
+void mousekey_set_wheel_detents(uint8_t detents) {
+    mousekey_wheel_detents = detents ? detents : 1;
+}
+
 report_mouse_t mousekey_get_report(void) {
     return mouse_report;
 }
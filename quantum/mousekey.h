@@ -184,6 +184,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MOUSEKEY_OVERLAP_INTERVAL MOUSEKEY_INTERVAL
 #endif
 
+#ifdef MK_MOTION_CURVE
+#    if defined(MK_3_SPEED) || defined(MK_COMBINED) || defined(MK_KINETIC_SPEED) || defined(MOUSEKEY_INERTIA)
+#        error "MK_MOTION_CURVE is only supported with the default acceleration mode"
+#    endif
+#    ifndef MK_MOTION_CURVE_EXPONENT
+#        define MK_MOTION_CURVE_EXPONENT 2
+#    endif
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -201,6 +210,8 @@ void           mousekey_off(uint8_t code);
 void           mousekey_clear(void);
 void           mousekey_send(void);
 report_mouse_t mousekey_get_report(void);
+// The next wheel key press scrolls as far as this many presses, e.g. for a batch of encoder detents
+void mousekey_set_wheel_detents(uint8_t detents);
 bool           should_mousekey_report_send(report_mouse_t *mouse_report);
 
 #ifdef __cplusplus
@@ -18,6 +18,7 @@
 
 #include <string.h>
 #include "timer.h"
+#include "state_change.h"
 #ifdef OS_DETECTION_KEYBOARD_RESET
 #    include "quantum.h"
 #endif
@@ -96,6 +97,7 @@ void os_detection_task(void) {
             if (detected_os != reported_os || first_report) {
                 first_report = false;
                 reported_os  = detected_os;
+                state_publish(STATE_DETECTED_OS);
                 process_detected_host_os_kb(detected_os);
             }
         }
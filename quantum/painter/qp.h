@@ -88,6 +88,36 @@
 #    define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_PALETTE_CACHE_SIZE
+/**
+ * @def This controls how many palettes are kept once converted to the native pixel format of a display, so that images
+ *      and fonts redrawn with the same colors don't need their palettes converted again. Each entry requires as much
+ *      RAM as the largest palette -- 64 bytes, or 1kB if \ref QUANTUM_PAINTER_SUPPORTS_256_PALETTE is enabled. The
+ *      palette last used is always reused, even if set to 0.
+ */
+#    if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
+#        define QUANTUM_PAINTER_PALETTE_CACHE_SIZE 1
+#    else
+#        define QUANTUM_PAINTER_PALETTE_CACHE_SIZE 4
+#    endif
+#endif
+
+#ifndef QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS
+/**
+ * @def The address in external flash of the asset directory written by `qmk painter-pack-assets`. Images and fonts
+ *      can be loaded from it using \ref qp_load_image_flash and \ref qp_load_font_flash.
+ */
+#    define QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS 0
+#endif
+
+#ifndef QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE
+/**
+ * @def This controls how many bytes are read ahead from external flash at a time when drawing assets stored there.
+ *      Larger values mean fewer, longer transfers from flash, at the cost of RAM. The cache is shared by all assets.
+ */
+#    define QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE 64
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
@@ -353,6 +383,20 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads an image from the asset directory in external flash.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image.
+ *
+ * @param name[in] the name of the image, as packed by `qmk painter-pack-assets`
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(const char *name);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -440,6 +484,19 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads a font from the asset directory in external flash.
+ *
+ * @note Fonts can be unloaded by calling \ref qp_close_font.
+ *
+ * @param name[in] the name of the font, as packed by `qmk painter-pack-assets`
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(const char *name);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes a font handle when no longer in use.
  *
@@ -36,23 +36,23 @@ bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count,
 bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg);
 bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg);
 
-// Global variable used for interpolated pixel lookup table.
+// Global variable used for the pixel lookup table, holding the current palette in native pixel format.
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 extern qp_pixel_t qp_internal_global_pixel_lookup_table[256];
 #else
 extern qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 #endif
 
-// Generates a color-interpolated lookup table based off the number of items, from foreground to background, for use with monochrome image rendering.
-// Returns true if a palette was created, false if the palette is reused.
-// As this uses a global, this may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() below to reset.
-bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
+// Sets up the lookup table with a native palette interpolated from foreground to background, based off the number of items, for use with monochrome image rendering.
+// Palettes are cached per native pixel format, so only palettes that weren't used recently are generated and converted.
+bool qp_internal_prepare_interpolated_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
 
-// Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
-void qp_internal_invalidate_palette(void);
+// Helper shared between image and font rendering -- sets up the lookup table with the native palette matching the palette block specified in the asset. Expects the stream to be positioned at the start of the block header, and leaves it after the block.
+// The asset and frame identify the palette in the cache, in which case the block is skipped rather than read.
+bool qp_internal_prepare_qgf_palette(painter_device_t device, const void* asset, uint16_t frame, qp_stream_t* stream, uint8_t bpp);
 
-// Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
-bool qp_internal_load_qgf_palette(qp_stream_t* stream, uint8_t bpp);
+// Drops the cached palettes read from the asset, or all cached palettes if NULL. Needed whenever an asset handle is closed, as it may be reused for another asset.
+void qp_internal_invalidate_palette(const void* asset);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter codec functions
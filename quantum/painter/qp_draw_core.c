@@ -22,17 +22,40 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 // Buffer used for transmitting native pixel data to the downstream device.
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
 
-// Static buffer to contain a generated color palette
-static bool                                       generated_palette = false;
-static int16_t                                    generated_steps   = -1;
-__attribute__((__aligned__(4))) static qp_pixel_t interpolated_fg_hsv888;
-__attribute__((__aligned__(4))) static qp_pixel_t interpolated_bg_hsv888;
+// Static buffer to contain the current color palette, in native pixel format
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[256];
 #else
 __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 #endif
 
+// Identifies a palette once converted to native pixel format
+typedef struct qp_palette_key_t {
+    painter_driver_convert_palette_func palette_convert; // Native pixel format of the device
+    const void                         *asset;           // Image or font the palette was read from, NULL if interpolated
+    uint16_t                            frame;           // Frame of the image the palette was read from
+    int16_t                             steps;           // Number of entries
+    qp_pixel_t                          fg_hsv888;       // Interpolated palettes only
+    qp_pixel_t                          bg_hsv888;       // Interpolated palettes only
+} qp_palette_key_t;
+
+// Key of the palette currently held by the lookup table
+static bool             current_palette_valid = false;
+static qp_palette_key_t current_palette;
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+// Converted palettes, so that redrawing the same assets doesn't need them to be converted again
+typedef struct qp_palette_cache_entry_t {
+    bool             valid;
+    uint32_t         last_used;
+    qp_palette_key_t key;
+    qp_pixel_t       palette[ARRAY_SIZE(qp_internal_global_pixel_lookup_table)];
+} qp_palette_cache_entry_t;
+
+static qp_palette_cache_entry_t palette_cache[QUANTUM_PAINTER_PALETTE_CACHE_SIZE];
+static uint32_t                 palette_cache_uses = 0;
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
 
@@ -64,27 +87,80 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     }
 }
 
-// Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
-void qp_internal_invalidate_palette(void) {
-    generated_palette = false;
-    generated_steps   = -1;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Palette cache
+
+static inline bool qp_palette_key_equals(const qp_palette_key_t *a, const qp_palette_key_t *b) {
+    return a->palette_convert == b->palette_convert && a->asset == b->asset && a->frame == b->frame && a->steps == b->steps && a->fg_hsv888.dummy == b->fg_hsv888.dummy && a->bg_hsv888.dummy == b->bg_hsv888.dummy;
 }
 
-// Interpolates between two colors to generate a palette
-bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
-    // Check if we need to generate a new palette -- if the input parameters match then assume the palette can stay unchanged.
-    // This may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() to reset.
-    if (generated_palette == true && generated_steps == steps && memcmp(&interpolated_fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&interpolated_bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0) {
-        // We already have the correct palette, no point regenerating it.
+// Sets up the lookup table with the palette matching the key, if it was converted before. Returns false if it needs to be generated.
+static bool qp_palette_cache_lookup(const qp_palette_key_t *key) {
+    if (current_palette_valid && qp_palette_key_equals(&current_palette, key)) {
+        return true;
+    }
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; ++i) {
+        qp_palette_cache_entry_t *entry = &palette_cache[i];
+        if (entry->valid && qp_palette_key_equals(&entry->key, key)) {
+            entry->last_used = ++palette_cache_uses;
+            memcpy(qp_internal_global_pixel_lookup_table, entry->palette, key->steps * sizeof(qp_pixel_t));
+            current_palette       = *key;
+            current_palette_valid = true;
+            return true;
+        }
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
+    return false;
+}
+
+// Converts the generated palette in the lookup table to native pixel format, and keeps it for reuse
+static bool qp_palette_cache_convert(painter_device_t device, const qp_palette_key_t *key) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    current_palette_valid = false;
+    if (!driver->driver_vtable->palette_convert(device, key->steps, qp_internal_global_pixel_lookup_table)) {
         return false;
     }
+    current_palette       = *key;
+    current_palette_valid = true;
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    // Replace the least recently used entry
+    qp_palette_cache_entry_t *entry = &palette_cache[0];
+    for (uint8_t i = 1; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE && entry->valid; ++i) {
+        if (!palette_cache[i].valid || palette_cache[i].last_used < entry->last_used) {
+            entry = &palette_cache[i];
+        }
+    }
+    entry->valid     = true;
+    entry->last_used = ++palette_cache_uses;
+    entry->key       = *key;
+    memcpy(entry->palette, qp_internal_global_pixel_lookup_table, key->steps * sizeof(qp_pixel_t));
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
+    return true;
+}
+
+// Drops the palettes read from the asset, or all palettes if NULL. Asset handles are reused once closed, so their palettes can't be kept.
+void qp_internal_invalidate_palette(const void *asset) {
+    if (asset == NULL || current_palette.asset == asset) {
+        current_palette_valid = false;
+    }
 
-    // Save the parameters so we know whether we can skip generation
-    generated_palette      = true;
-    generated_steps        = steps;
-    interpolated_fg_hsv888 = fg_hsv888;
-    interpolated_bg_hsv888 = bg_hsv888;
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; ++i) {
+        if (asset == NULL || palette_cache[i].key.asset == asset) {
+            palette_cache[i].valid = false;
+        }
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+}
 
+// Interpolates between two colors to generate a palette
+static void qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
     int16_t hue_fg = fg_hsv888.hsv888.h;
     int16_t hue_bg = bg_hsv888.hsv888.h;
 
@@ -103,12 +179,28 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
 
         qp_dprintf("qp_internal_interpolate_palette: %3d of %d -- H: %3d, S: %3d, V: %3d\n", (int)(i + 1), (int)steps, (int)qp_internal_global_pixel_lookup_table[i].hsv888.h, (int)qp_internal_global_pixel_lookup_table[i].hsv888.s, (int)qp_internal_global_pixel_lookup_table[i].hsv888.v);
     }
+}
 
-    return true;
+bool qp_internal_prepare_interpolated_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    // Only the HSV components take part in the key
+    qp_pixel_t fg = {.dummy = 0};
+    qp_pixel_t bg = {.dummy = 0};
+    fg.hsv888     = fg_hsv888.hsv888;
+    bg.hsv888     = bg_hsv888.hsv888;
+
+    qp_palette_key_t key = {.palette_convert = driver->driver_vtable->palette_convert, .asset = NULL, .frame = 0, .steps = steps, .fg_hsv888 = fg, .bg_hsv888 = bg};
+    if (qp_palette_cache_lookup(&key)) {
+        return true;
+    }
+
+    qp_internal_interpolate_palette(fg, bg, steps);
+    return qp_palette_cache_convert(device, &key);
 }
 
-// Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
-bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
+// Reads the palette block of an asset into the lookup table. Expects the stream to be positioned at the start of the block header.
+static bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     qgf_palette_v1_t palette_descriptor;
     if (qp_stream_read(&palette_descriptor, sizeof(qgf_palette_v1_t), 1, stream) != 1) {
         qp_dprintf("Failed to read palette_descriptor, expected length was not %d\n", (int)sizeof(qgf_palette_v1_t));
@@ -118,9 +210,6 @@ bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     // BPP determines the number of palette entries, each entry is a HSV888 triplet.
     const uint16_t palette_entries = 1u << bpp;
 
-    // Ensure we aren't reusing any palette
-    qp_internal_invalidate_palette();
-
     // Read the palette entries
     for (uint16_t i = 0; i < palette_entries; ++i) {
         // Read the palette entry
@@ -140,6 +229,23 @@ bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     return true;
 }
 
+bool qp_internal_prepare_qgf_palette(painter_device_t device, const void *asset, uint16_t frame, qp_stream_t *stream, uint8_t bpp) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    const uint16_t   palette_entries = 1u << bpp;
+    qp_palette_key_t key             = {.palette_convert = driver->driver_vtable->palette_convert, .asset = asset, .frame = frame, .steps = palette_entries, .fg_hsv888 = {.dummy = 0}, .bg_hsv888 = {.dummy = 0}};
+    if (qp_palette_cache_lookup(&key)) {
+        // Skip over the palette block, as if it had been read
+        return qp_stream_seek(stream, sizeof(qgf_palette_v1_t) + palette_entries * sizeof(qgf_palette_entry_v1_t), SEEK_CUR) == 0;
+    }
+
+    current_palette_valid = false;
+    if (!qp_internal_load_qgf_palette(stream, bpp)) {
+        return false;
+    }
+    return qp_palette_cache_convert(device, &key);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_setpixel
 
@@ -7,6 +7,10 @@
 #include "qgf.h"
 #include "deferred_exec.h"
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+#    include "qp_flash_assets.h"
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QGF image handles
 
@@ -16,6 +20,9 @@ typedef struct qgf_image_handle_t {
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
@@ -85,6 +92,29 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    const char *name = (const char *)arg;
+
+    uint32_t address, length;
+    if (!qp_flash_assets_find(name, &address, &length)) {
+        return false;
+    }
+
+    image->flash_stream = qp_make_flash_stream(address, length);
+    return true;
+}
+
+painter_image_handle_t qp_load_image_flash(const char *name) {
+    return qp_load_image_internal(image_flash_stream_factory, (void *)name);
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -98,6 +128,7 @@ bool qp_close_image(painter_image_handle_t image) {
     // Free up this image for use elsewhere.
     qgf_image->validate_ok = false;
     qp_stream_close(&qgf_image->stream);
+    qp_internal_invalidate_palette(qgf_image);
     return true;
 }
 
@@ -125,8 +156,6 @@ typedef struct qgf_frame_info_t {
 } qgf_frame_info_t;
 
 static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
-    painter_driver_t *driver = (painter_driver_t *)device;
-
     // Drop out if we can't actually place the data we read out anywhere
     if (!info) {
         qp_dprintf("Failed to prepare stream for read, output info buffer unavailable\n");
@@ -148,39 +177,26 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
-    // Ensure we aren't reusing any palette
-    qp_internal_invalidate_palette();
-
     if (!qp_internal_bpp_capable(info->bpp)) {
         qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
         qp_comms_stop(device);
         return false;
     }
 
-    // Handle palette if needed
-    const uint16_t palette_entries  = 1u << info->bpp;
-    bool           needs_pixconvert = false;
+    // Handle palette if needed, converting it to native format unless cached
+    bool palette_ok = true;
     if (info->has_palette) {
-        // Load the palette from the stream
-        if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
-            return false;
-        }
-
-        needs_pixconvert = true;
-    } else {
-        if (info->bpp <= 8) {
-            // Interpolate from fg/bg
-            needs_pixconvert = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
-        }
+        // Load the palette from the stream, keyed by frame as each frame may have its own
+        palette_ok = qp_internal_prepare_qgf_palette(device, qgf_image, frame_number, (qp_stream_t *)&qgf_image->stream, info->bpp);
+    } else if (info->bpp <= 8) {
+        // Interpolate from fg/bg
+        palette_ok = qp_internal_prepare_interpolated_palette(device, fg_hsv888, bg_hsv888, 1u << info->bpp);
     }
 
-    if (needs_pixconvert) {
-        // Convert the palette to native format
-        if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
-            qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
-            return false;
-        }
+    if (!palette_ok) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
+        qp_comms_stop(device);
+        return false;
     }
 
     // Handle delta if needed
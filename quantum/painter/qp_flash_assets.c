@@ -0,0 +1,50 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "flash.h"
+#include "qp_flash_assets.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asset directory lookup
+
+bool qp_flash_assets_find(const char *name, uint32_t *address, uint32_t *length) {
+    static bool flash_initialised = false;
+    if (!flash_initialised) {
+        flash_init();
+        flash_initialised = true;
+    }
+
+    qp_flash_assets_header_v1_t header;
+    if (flash_read_range(QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS, &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("qp_flash_assets_find: fail (could not read directory)\n");
+        return false;
+    }
+    if (header.magic != QP_FLASH_ASSETS_MAGIC || header.version != 0x01) {
+        qp_dprintf("qp_flash_assets_find: fail (no asset directory found)\n");
+        return false;
+    }
+
+    uint32_t entry_address = QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS + sizeof(header);
+    for (uint16_t i = 0; i < header.asset_count; ++i, entry_address += sizeof(qp_flash_asset_entry_v1_t)) {
+        qp_flash_asset_entry_v1_t entry;
+        if (flash_read_range(entry_address, &entry, sizeof(entry)) != FLASH_STATUS_SUCCESS) {
+            qp_dprintf("qp_flash_assets_find: fail (could not read entry %d)\n", (int)i);
+            return false;
+        }
+        if (strncmp(name, entry.name, sizeof(entry.name)) == 0) {
+            // Streams take a signed length, and the asset must lie wholly within the 32-bit flash address space
+            if (entry.length == 0 || entry.length > INT32_MAX || (uint64_t)QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS + entry.offset + entry.length > UINT32_MAX) {
+                qp_dprintf("qp_flash_assets_find: fail (entry '%s' has an invalid range)\n", name);
+                return false;
+            }
+            *address = QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS + entry.offset;
+            *length  = entry.length;
+            return true;
+        }
+    }
+
+    qp_dprintf("qp_flash_assets_find: fail (no asset named '%s')\n", name);
+    return false;
+}
@@ -0,0 +1,48 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Quantum Painter asset directory, as written to external flash by `qmk painter-pack-assets`.
+// See https://docs.qmk.fm/#/quantum_painter for more information.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qp_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asset directory structures
+
+/////////////////////////////////////////
+// Directory header, at QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS
+
+typedef struct QP_PACKED qp_flash_assets_header_v1_t {
+    uint32_t magic : 24;  // constant, equal to 0x415051 ("QPA")
+    uint8_t  version;     // constant, equal to 0x01
+    uint16_t asset_count; // number of entries following the header
+    uint16_t reserved;    // zero
+} qp_flash_assets_header_v1_t;
+
+_Static_assert(sizeof(qp_flash_assets_header_v1_t) == 8, "qp_flash_assets_header_v1_t must be 8 bytes in v1 of the asset directory");
+
+#define QP_FLASH_ASSETS_MAGIC 0x415051
+
+/////////////////////////////////////////
+// Directory entry, one per asset
+
+#define QP_FLASH_ASSET_NAME_LENGTH 24
+
+typedef struct QP_PACKED qp_flash_asset_entry_v1_t {
+    char     name[QP_FLASH_ASSET_NAME_LENGTH]; // NUL-terminated, padded with NULs
+    uint32_t offset;                           // from the start of the directory header
+    uint32_t length;                           // size of the QGF or QFF data
+} qp_flash_asset_entry_v1_t;
+
+_Static_assert(sizeof(qp_flash_asset_entry_v1_t) == 32, "qp_flash_asset_entry_v1_t must be 32 bytes in v1 of the asset directory");
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asset directory API
+
+// Looks up the named asset, returning its absolute address in flash and its length
+bool qp_flash_assets_find(const char *name, uint32_t *address, uint32_t *length);
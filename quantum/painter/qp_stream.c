@@ -3,6 +3,10 @@
 
 #include "qp_stream.h"
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+#    include "flash.h"
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
@@ -119,6 +123,105 @@ qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     return stream;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+// Only one asset is decoded at a time, so a single cache serves every stream
+static uint8_t  flash_cache[QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE];
+static uint32_t flash_cache_address = 0;
+static uint32_t flash_cache_length  = 0;
+
+static inline int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+
+    uint32_t address = s->address + s->position;
+    if (address < flash_cache_address || address - flash_cache_address >= flash_cache_length) {
+        // Refill the cache with one burst read, stopping at the end of the stream
+        uint32_t length = s->length - s->position;
+        if (length > sizeof(flash_cache)) {
+            length = sizeof(flash_cache);
+        }
+        if (flash_read_range(address, flash_cache, length) != FLASH_STATUS_SUCCESS) {
+            flash_cache_length = 0;
+            s->is_eof          = true;
+            return STREAM_EOF;
+        }
+        flash_cache_address = address;
+        flash_cache_length  = length;
+    }
+
+    s->position++;
+    return flash_cache[address - flash_cache_address];
+}
+
+static inline bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // Read-only.
+    return false;
+}
+
+static inline int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek, see mem_seek() above
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    s->position = position;
+    s->is_eof   = false;
+    return 0;
+}
+
+static inline int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static inline bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    // The flash may have been rewritten since the cache was filled
+    flash_cache_length = 0;
+
+    qp_flash_stream_t stream = {
+        .base     = {.get = flash_get, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close},
+        .address  = address,
+        .length   = length,
+        .position = 0,
+    };
+    return stream;
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
@@ -4,6 +4,8 @@ QUANTUM_PAINTER_ANIMATIONS_ENABLE ?= yes
 
 QUANTUM_PAINTER_LVGL_INTEGRATION ?= no
 
+QUANTUM_PAINTER_FLASH_ASSETS_ENABLE ?= no
+
 # The list of permissible drivers that can be listed in QUANTUM_PAINTER_DRIVERS
 VALID_QUANTUM_PAINTER_DRIVERS := \
     surface \
@@ -47,6 +49,13 @@ ifeq ($(strip $(QUANTUM_PAINTER_ANIMATIONS_ENABLE)), yes)
     OPT_DEFS += -DQUANTUM_PAINTER_ANIMATIONS_ENABLE
 endif
 
+# Check if people want to load images and fonts from external flash
+ifeq ($(strip $(QUANTUM_PAINTER_FLASH_ASSETS_ENABLE)), yes)
+    OPT_DEFS += -DQUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+    FLASH_DRIVER ?= spi
+    SRC += $(QUANTUM_DIR)/painter/qp_flash_assets.c
+endif
+
 # Comms flags
 QUANTUM_PAINTER_NEEDS_COMMS_DUMMY ?= no
 QUANTUM_PAINTER_NEEDS_COMMS_SPI ?= no
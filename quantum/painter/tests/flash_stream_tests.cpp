@@ -0,0 +1,183 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "flash.h"
+#include "qp_stream.h"
+#include "qp_flash_assets.h"
+}
+
+namespace {
+
+// RAM-backed stand-in for the external flash, recording each burst read
+std::vector<uint8_t>                     flash_memory;
+std::vector<std::pair<uint32_t, size_t>> flash_reads;
+
+void append_le(std::vector<uint8_t> &out, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out.push_back((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void append_entry(std::vector<uint8_t> &out, const char *name, uint32_t offset, uint32_t length) {
+    char padded[QP_FLASH_ASSET_NAME_LENGTH] = {0};
+    strncpy(padded, name, sizeof(padded) - 1);
+    out.insert(out.end(), padded, padded + sizeof(padded));
+    append_le(out, offset, 4);
+    append_le(out, length, 4);
+}
+
+} // namespace
+
+extern "C" {
+
+void flash_init(void) {}
+
+flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len) {
+    if (addr > flash_memory.size() || len > flash_memory.size() - addr) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    flash_reads.emplace_back(addr, len);
+    memcpy(buf, flash_memory.data() + addr, len);
+    return FLASH_STATUS_SUCCESS;
+}
+}
+
+class FlashStream : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        flash_memory.resize(1024);
+        for (size_t i = 0; i < flash_memory.size(); i++) {
+            flash_memory[i] = (uint8_t)(i * 7 + 3);
+        }
+        flash_reads.clear();
+    }
+
+    int16_t get(qp_flash_stream_t &stream) {
+        return qp_stream_get(&stream);
+    }
+};
+
+TEST_F(FlashStream, ReadsAreServedFromTheCache) {
+    auto stream = qp_make_flash_stream(100, 200);
+
+    for (int32_t i = 0; i < QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE; i++) {
+        EXPECT_EQ(get(stream), flash_memory[100 + i]);
+    }
+    ASSERT_EQ(flash_reads.size(), 1);
+    EXPECT_EQ(flash_reads[0].first, 100);
+    EXPECT_EQ(flash_reads[0].second, QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE);
+
+    // The next byte is past the cached burst, so the cache is refilled from there
+    EXPECT_EQ(get(stream), flash_memory[100 + QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE]);
+    ASSERT_EQ(flash_reads.size(), 2);
+    EXPECT_EQ(flash_reads[1].first, 100 + QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE);
+}
+
+TEST_F(FlashStream, SeekWithinCacheDoesNotReadFlash) {
+    auto stream = qp_make_flash_stream(100, 200);
+
+    EXPECT_EQ(get(stream), flash_memory[100]);
+    EXPECT_EQ(qp_stream_seek(&stream, 5, SEEK_SET), 0);
+    EXPECT_EQ(get(stream), flash_memory[105]);
+    EXPECT_EQ(qp_stream_seek(&stream, 2, SEEK_SET), 0);
+    EXPECT_EQ(get(stream), flash_memory[102]);
+    EXPECT_EQ(flash_reads.size(), 1);
+}
+
+TEST_F(FlashStream, BackwardSeekRefillsTheCache) {
+    auto stream = qp_make_flash_stream(100, 200);
+
+    EXPECT_EQ(qp_stream_seek(&stream, 150, SEEK_SET), 0);
+    EXPECT_EQ(get(stream), flash_memory[250]);
+    EXPECT_EQ(qp_stream_seek(&stream, -140, SEEK_CUR), 0);
+    EXPECT_EQ(qp_stream_tell(&stream), 11);
+    EXPECT_EQ(get(stream), flash_memory[111]);
+
+    ASSERT_EQ(flash_reads.size(), 2);
+    EXPECT_EQ(flash_reads[1].first, 111);
+}
+
+TEST_F(FlashStream, EofAtStreamEnd) {
+    auto stream = qp_make_flash_stream(100, 200);
+
+    EXPECT_EQ(qp_stream_seek(&stream, -3, SEEK_END), 0);
+    EXPECT_EQ(get(stream), flash_memory[297]);
+    EXPECT_EQ(get(stream), flash_memory[298]);
+    EXPECT_EQ(get(stream), flash_memory[299]);
+    EXPECT_FALSE(qp_stream_eof(&stream));
+    EXPECT_EQ(get(stream), STREAM_EOF);
+    EXPECT_TRUE(qp_stream_eof(&stream));
+
+    // The refill stopped at the end of the stream rather than reading a whole cache's worth
+    ASSERT_EQ(flash_reads.size(), 1);
+    EXPECT_EQ(flash_reads[0].first, 297);
+    EXPECT_EQ(flash_reads[0].second, 3);
+
+    // Seeking past the end is refused, and seeking back clears EOF
+    EXPECT_NE(qp_stream_seek(&stream, 1, SEEK_END), 0);
+    EXPECT_EQ(qp_stream_seek(&stream, 0, SEEK_SET), 0);
+    EXPECT_FALSE(qp_stream_eof(&stream));
+    EXPECT_EQ(get(stream), flash_memory[100]);
+}
+
+TEST_F(FlashStream, ReadErrorEndsTheStream) {
+    // The stream runs past the end of the fake flash, so the refill fails
+    auto stream = qp_make_flash_stream(1000, 100);
+
+    EXPECT_EQ(get(stream), STREAM_EOF);
+    EXPECT_TRUE(qp_stream_eof(&stream));
+}
+
+TEST_F(FlashStream, NewStreamDiscardsTheCache) {
+    auto first = qp_make_flash_stream(100, 200);
+    EXPECT_EQ(get(first), flash_memory[100]);
+
+    flash_memory[100] ^= 0xFF;
+    auto second = qp_make_flash_stream(100, 200);
+    EXPECT_EQ(get(second), flash_memory[100]);
+    EXPECT_EQ(flash_reads.size(), 2);
+}
+
+class FlashAssets : public FlashStream {
+   protected:
+    void write_directory(const std::vector<uint8_t> &entries, uint16_t count) {
+        std::vector<uint8_t> directory;
+        append_le(directory, QP_FLASH_ASSETS_MAGIC, 3);
+        append_le(directory, 0x01, 1);
+        append_le(directory, count, 2);
+        append_le(directory, 0, 2);
+        directory.insert(directory.end(), entries.begin(), entries.end());
+        std::copy(directory.begin(), directory.end(), flash_memory.begin() + QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS);
+    }
+};
+
+TEST_F(FlashAssets, FindsNamedAsset) {
+    std::vector<uint8_t> entries;
+    append_entry(entries, "logo", 512, 100);
+    append_entry(entries, "font", 612, 50);
+    write_directory(entries, 2);
+
+    uint32_t address = 0, length = 0;
+    EXPECT_TRUE(qp_flash_assets_find("font", &address, &length));
+    EXPECT_EQ(address, QUANTUM_PAINTER_FLASH_ASSETS_ADDRESS + 612);
+    EXPECT_EQ(length, 50);
+    EXPECT_FALSE(qp_flash_assets_find("missing", &address, &length));
+}
+
+TEST_F(FlashAssets, RejectsInvalidRanges) {
+    std::vector<uint8_t> entries;
+    append_entry(entries, "empty", 512, 0);
+    append_entry(entries, "wraps", 0xFFFFFF00, 0x200);
+    append_entry(entries, "huge", 512, 0x80000000);
+    write_directory(entries, 3);
+
+    uint32_t address = 0, length = 0;
+    EXPECT_FALSE(qp_flash_assets_find("empty", &address, &length));
+    EXPECT_FALSE(qp_flash_assets_find("wraps", &address, &length));
+    EXPECT_FALSE(qp_flash_assets_find("huge", &address, &length));
+}
@@ -0,0 +1,223 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_draw.h"
+#include "qp_surface_internal.h"
+extern const surface_painter_driver_vtable_t rgb565_surface_driver_vtable;
+}
+
+namespace {
+
+const uint16_t icon_width  = 16;
+const uint16_t icon_height = 16;
+
+// Counts conversions done by the surface driver
+size_t                          conversions = 0;
+surface_painter_driver_vtable_t counting_vtable;
+surface_painter_driver_vtable_t other_format_vtable;
+
+bool counting_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    conversions++;
+    return rgb565_surface_driver_vtable.base.palette_convert(device, palette_size, palette);
+}
+
+// Same pixels, but stands for a display with another native pixel format
+bool other_format_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    return counting_palette_convert(device, palette_size, palette);
+}
+
+void append_le(std::vector<uint8_t> &out, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out.push_back((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void append_block_header(std::vector<uint8_t> &out, uint8_t type_id, uint32_t length) {
+    out.push_back(type_id);
+    out.push_back(~type_id);
+    append_le(out, length, 3);
+}
+
+// Single frame QGF image, every pixel set to `index`
+std::vector<uint8_t> make_icon(qp_image_format_t format, uint8_t bpp, const std::vector<uint8_t> &palette_hsv, uint8_t index) {
+    std::vector<uint8_t> pixels((icon_width * icon_height * bpp) / 8);
+    for (size_t i = 0; i < pixels.size() * 8 / bpp; i++) {
+        pixels[i * bpp / 8] |= index << ((i * bpp) % 8);
+    }
+
+    const uint32_t frame_offset = 5 + 18 + 5 + 4;
+    const uint32_t total_size   = frame_offset + 5 + 6 + (palette_hsv.empty() ? 0 : 5 + palette_hsv.size()) + 5 + pixels.size();
+
+    std::vector<uint8_t> out;
+    append_block_header(out, 0x00, 18);
+    out.insert(out.end(), {'Q', 'G', 'F', 0x01});
+    append_le(out, total_size, 4);
+    append_le(out, ~total_size, 4);
+    append_le(out, icon_width, 2);
+    append_le(out, icon_height, 2);
+    append_le(out, 1, 2);
+
+    append_block_header(out, 0x01, 4);
+    append_le(out, frame_offset, 4);
+
+    append_block_header(out, 0x02, 6);
+    out.insert(out.end(), {(uint8_t)format, 0x00, 0x00, 0xFF});
+    append_le(out, 0, 2);
+
+    if (!palette_hsv.empty()) {
+        append_block_header(out, 0x03, palette_hsv.size());
+        out.insert(out.end(), palette_hsv.begin(), palette_hsv.end());
+    }
+
+    append_block_header(out, 0x05, pixels.size());
+    out.insert(out.end(), pixels.begin(), pixels.end());
+    EXPECT_EQ(out.size(), total_size);
+    return out;
+}
+
+// HSV triplets of a 4 color palette
+const std::vector<uint8_t> four_colors = {0, 0, 0, 0, 255, 255, 85, 255, 255, 170, 255, 255};
+
+uint16_t native_color(uint8_t hue, uint8_t sat, uint8_t val) {
+    qp_pixel_t pixel = {.hsv888 = {.h = hue, .s = sat, .v = val}};
+    rgb565_surface_driver_vtable.base.palette_convert(nullptr, 1, &pixel);
+    return pixel.rgb565;
+}
+
+} // namespace
+
+class PainterPaletteCache : public ::testing::Test {
+   protected:
+    surface_painter_device_t devices[2] = {};
+    uint16_t                 framebuffers[2][icon_width * icon_height] = {};
+    painter_device_t         display;
+    painter_device_t         other_display;
+
+    void SetUp() override {
+        counting_vtable                          = rgb565_surface_driver_vtable;
+        counting_vtable.base.palette_convert     = counting_palette_convert;
+        other_format_vtable                      = rgb565_surface_driver_vtable;
+        other_format_vtable.base.palette_convert = other_format_palette_convert;
+
+        display       = qp_make_rgb565_surface_advanced(&devices[0], 1, icon_width, icon_height, framebuffers[0]);
+        other_display = qp_make_rgb565_surface_advanced(&devices[1], 1, icon_width, icon_height, framebuffers[1]);
+        devices[0].base.driver_vtable = &counting_vtable.base;
+        devices[1].base.driver_vtable = &other_format_vtable.base;
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(other_display, QP_ROTATION_0));
+
+        // Start each test from an empty cache
+        qp_internal_invalidate_palette(NULL);
+        conversions = 0;
+    }
+
+    uint16_t pixel(painter_device_t device, uint16_t x, uint16_t y) {
+        return framebuffers[device == display ? 0 : 1][y * icon_width + x];
+    }
+};
+
+TEST_F(PainterPaletteCache, RecoloredIconsConvertPaletteOnce) {
+    std::vector<uint8_t>   data = make_icon(GRAYSCALE_2BPP, 2, {}, 3);
+    painter_image_handle_t icon = qp_load_image_mem(data.data());
+    ASSERT_NE(icon, nullptr);
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(qp_drawimage_recolor(display, 0, 0, icon, 85, 255, 255, 0, 0, 0));
+    }
+    EXPECT_EQ(conversions, 1u);
+    EXPECT_EQ(pixel(display, 5, 5), native_color(85, 255, 255));
+
+    // Interpolated palettes only depend on the colors, so other icons reuse them
+    std::vector<uint8_t>   other_data = make_icon(GRAYSCALE_2BPP, 2, {}, 0);
+    painter_image_handle_t other_icon = qp_load_image_mem(other_data.data());
+    ASSERT_TRUE(qp_drawimage_recolor(display, 0, 0, other_icon, 85, 255, 255, 0, 0, 0));
+    EXPECT_EQ(conversions, 1u);
+    EXPECT_EQ(pixel(display, 5, 5), native_color(0, 0, 0));
+
+    qp_close_image(other_icon);
+    qp_close_image(icon);
+}
+
+TEST_F(PainterPaletteCache, AlternatingColorsAreKept) {
+    std::vector<uint8_t>   data = make_icon(GRAYSCALE_2BPP, 2, {}, 3);
+    painter_image_handle_t icon = qp_load_image_mem(data.data());
+
+    const uint8_t hues[] = {0, 85, 170};
+    for (int i = 0; i < 30; i++) {
+        uint8_t hue = hues[i % 3];
+        ASSERT_TRUE(qp_drawimage_recolor(display, 0, 0, icon, hue, 255, 255, 0, 0, 0));
+        ASSERT_EQ(pixel(display, 0, 0), native_color(hue, 255, 255));
+    }
+    EXPECT_EQ(conversions, (size_t)(QUANTUM_PAINTER_PALETTE_CACHE_SIZE >= 3 ? 3 : 30));
+
+    qp_close_image(icon);
+}
+
+TEST_F(PainterPaletteCache, PaletteImagesConvertOnceUntilClosed) {
+    std::vector<uint8_t>   data = make_icon(PALETTE_2BPP, 2, four_colors, 2);
+    painter_image_handle_t icon = qp_load_image_mem(data.data());
+    ASSERT_NE(icon, nullptr);
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(qp_drawimage(display, 0, 0, icon));
+    }
+    EXPECT_EQ(conversions, 1u);
+    EXPECT_EQ(pixel(display, 15, 15), native_color(85, 255, 255));
+
+    // The handle is reused for the next image, which has its own palette
+    qp_close_image(icon);
+    std::vector<uint8_t> other_colors = four_colors;
+    other_colors[8]                   = 128;
+    std::vector<uint8_t> other_data   = make_icon(PALETTE_2BPP, 2, other_colors, 2);
+    icon                              = qp_load_image_mem(other_data.data());
+    ASSERT_TRUE(qp_drawimage(display, 0, 0, icon));
+    EXPECT_EQ(conversions, 2u);
+    EXPECT_EQ(pixel(display, 15, 15), native_color(85, 255, 128));
+
+    qp_close_image(icon);
+}
+
+TEST_F(PainterPaletteCache, OtherPixelFormatIsConvertedAgain) {
+    std::vector<uint8_t>   data = make_icon(GRAYSCALE_2BPP, 2, {}, 3);
+    painter_image_handle_t icon = qp_load_image_mem(data.data());
+
+    ASSERT_TRUE(qp_drawimage_recolor(display, 0, 0, icon, 170, 255, 255, 0, 0, 0));
+    ASSERT_TRUE(qp_drawimage_recolor(other_display, 0, 0, icon, 170, 255, 255, 0, 0, 0));
+    EXPECT_EQ(conversions, 2u);
+    ASSERT_TRUE(qp_drawimage_recolor(display, 0, 0, icon, 170, 255, 255, 0, 0, 0));
+    ASSERT_TRUE(qp_drawimage_recolor(other_display, 0, 0, icon, 170, 255, 255, 0, 0, 0));
+    EXPECT_EQ(conversions, QUANTUM_PAINTER_PALETTE_CACHE_SIZE >= 2 ? 2u : 4u);
+
+    qp_close_image(icon);
+}
+
+// Redraws a row of status icons, as a keymap would on every layer change
+TEST_F(PainterPaletteCache, RepeatedIconDrawsBenchmark) {
+    std::vector<uint8_t>   mono_data    = make_icon(GRAYSCALE_2BPP, 2, {}, 3);
+    std::vector<uint8_t>   palette_data = make_icon(PALETTE_2BPP, 2, four_colors, 1);
+    painter_image_handle_t mono         = qp_load_image_mem(mono_data.data());
+    painter_image_handle_t colored      = qp_load_image_mem(palette_data.data());
+
+    const int  frames = 1000;
+    const auto start  = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        ASSERT_TRUE(qp_drawimage_recolor(display, 0, 0, mono, 0, 255, 255, 0, 0, 0));
+        ASSERT_TRUE(qp_drawimage_recolor(display, 0, 0, mono, 85, 255, 255, 0, 0, 0));
+        ASSERT_TRUE(qp_drawimage(display, 0, 0, colored));
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::printf("%d frames of 3 icons: %lld us, %zu palette conversions\n", frames, (long long)elapsed.count(), conversions);
+    EXPECT_EQ(conversions, QUANTUM_PAINTER_PALETTE_CACHE_SIZE >= 3 ? 3u : (size_t)(3 * frames));
+
+    qp_close_image(colored);
+    qp_close_image(mono);
+}
@@ -0,0 +1,44 @@
+painter_palette_cache_DEFS := \
+	-DQUANTUM_PAINTER_ENABLE \
+	-DQUANTUM_PAINTER_SURFACE_ENABLE \
+	-DQUANTUM_PAINTER_DUMMY_COMMS_ENABLE \
+	-DDEFERRED_EXEC_ENABLE \
+	-DEEPROM_TEST_HARNESS
+
+painter_palette_cache_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/unicode/utf8.c \
+	$(QUANTUM_PATH)/painter/qp.c \
+	$(QUANTUM_PATH)/painter/qp_stream.c \
+	$(QUANTUM_PATH)/painter/qgf.c \
+	$(QUANTUM_PATH)/painter/qp_comms.c \
+	$(QUANTUM_PATH)/painter/qp_draw_core.c \
+	$(QUANTUM_PATH)/painter/qp_draw_codec.c \
+	$(QUANTUM_PATH)/painter/qp_draw_image.c \
+	$(DRIVER_PATH)/painter/comms/qp_comms_dummy.c \
+	$(DRIVER_PATH)/painter/generic/qp_surface_common.c \
+	$(DRIVER_PATH)/painter/generic/qp_surface_rgb565.c \
+	$(QUANTUM_PATH)/painter/tests/palette_cache_tests.cpp
+
+painter_palette_cache_INC := \
+	$(QUANTUM_PATH)/painter \
+	$(QUANTUM_PATH)/unicode \
+	$(DRIVER_PATH)/painter/comms \
+	$(DRIVER_PATH)/painter/generic
+
+painter_flash_stream_DEFS := \
+	-DQUANTUM_PAINTER_ENABLE \
+	-DQUANTUM_PAINTER_FLASH_ASSETS_ENABLE \
+	-DQUANTUM_PAINTER_FLASH_ASSETS_ADDRESS=64 \
+	-DEEPROM_TEST_HARNESS
+
+painter_flash_stream_SRC := \
+	$(QUANTUM_PATH)/painter/qp_stream.c \
+	$(QUANTUM_PATH)/painter/qp_flash_assets.c \
+	$(QUANTUM_PATH)/painter/tests/flash_stream_tests.cpp
+
+painter_flash_stream_INC := \
+	$(QUANTUM_PATH)/painter \
+	$(DRIVER_PATH)/flash
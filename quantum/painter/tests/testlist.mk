@@ -0,0 +1,3 @@
+TEST_LIST += \
+	painter_palette_cache \
+	painter_flash_stream
@@ -79,6 +79,25 @@ uint16_t pointing_device_get_shared_cpi(void) {
 static report_mouse_t local_mouse_report         = {};
 static bool           pointing_device_force_send = false;
 
+#ifdef POINTING_DEVICE_MOTION_ENABLE
+#    ifdef POINTING_DEVICE_ACCEL_ENABLE
+static const uint16_t pointing_device_accel_curve[MOUSE_MOTION_CURVE_POINTS] = MOUSE_MOTION_CURVE(POINTING_DEVICE_ACCEL_MIN_GAIN, POINTING_DEVICE_ACCEL_MAX_GAIN, POINTING_DEVICE_ACCEL_EXPONENT);
+#    endif
+
+static mouse_motion_config_t pointing_device_motion_config = {
+    .scale_x = POINTING_DEVICE_MOTION_SCALE_X,
+    .scale_y = POINTING_DEVICE_MOTION_SCALE_Y,
+#    ifdef POINTING_DEVICE_ACCEL_ENABLE
+    .curve     = pointing_device_accel_curve,
+    .speed_max = POINTING_DEVICE_ACCEL_SPEED_MAX,
+#    endif
+};
+static mouse_motion_state_t local_motion_state = {};
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+static mouse_motion_state_t shared_motion_state = {};
+#    endif
+#endif
+
 #define POINTING_DEVICE_DRIVER_CONCAT(name) name##_pointing_device_driver
 #define POINTING_DEVICE_DRIVER(name) POINTING_DEVICE_DRIVER_CONCAT(name)
 
@@ -239,6 +258,53 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+#ifdef POINTING_DEVICE_MOTION_ENABLE
+/**
+ * @brief Sets the fixed-point motion scale of each axis
+ *
+ * Allows runtime changes of pointer speed, e.g. for a sniping mode, without losing sub-count precision.
+ *
+ * @param[in] scale_x uint16_t gain, 1.0 == MOUSE_MOTION_ONE
+ * @param[in] scale_y uint16_t gain, 1.0 == MOUSE_MOTION_ONE
+ */
+void pointing_device_set_motion_scale(uint16_t scale_x, uint16_t scale_y) {
+    pointing_device_motion_config.scale_x = scale_x;
+    pointing_device_motion_config.scale_y = scale_y;
+    pointing_device_reset_motion();
+}
+
+/**
+ * @brief Discards any fractional motion carried between reports
+ *
+ */
+void pointing_device_reset_motion(void) {
+    mouse_motion_reset(&local_motion_state);
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+    mouse_motion_reset(&shared_motion_state);
+#    endif
+}
+
+/**
+ * @brief Applies the motion engine scaling and acceleration to a mouse report
+ *
+ * Fractional counts that cannot be reported are carried in state and added to the next report.
+ *
+ * @param[in] mouse_report report_mouse_t to be adjusted
+ * @param[in] state mouse_motion_state_t carry for this sensor
+ * @return report_mouse_t with adjusted values
+ */
+static report_mouse_t pointing_device_apply_motion(report_mouse_t mouse_report, mouse_motion_state_t *state) {
+    int32_t x = mouse_report.x;
+    int32_t y = mouse_report.y;
+
+    mouse_motion_apply(&pointing_device_motion_config, state, &x, &y);
+
+    mouse_report.x = CONSTRAIN_HID_XY(x);
+    mouse_report.y = CONSTRAIN_HID_XY(y);
+    return mouse_report;
+}
+#endif
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
@@ -303,9 +369,16 @@ __attribute__((weak)) bool pointing_device_task(void) {
         local_mouse_report  = pointing_device_adjust_by_defines_right(local_mouse_report);
         shared_mouse_report = pointing_device_adjust_by_defines(shared_mouse_report);
     }
+#    ifdef POINTING_DEVICE_MOTION_ENABLE
+    local_mouse_report  = pointing_device_apply_motion(local_mouse_report, &local_motion_state);
+    shared_mouse_report = pointing_device_apply_motion(shared_mouse_report, &shared_motion_state);
+#    endif
     local_mouse_report = is_keyboard_left() ? pointing_device_task_combined_kb(local_mouse_report, shared_mouse_report) : pointing_device_task_combined_kb(shared_mouse_report, local_mouse_report);
 #else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
+#    ifdef POINTING_DEVICE_MOTION_ENABLE
+    local_mouse_report = pointing_device_apply_motion(local_mouse_report, &local_motion_state);
+#    endif
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
 #endif
     // automatic mouse layer function
@@ -114,6 +114,31 @@ typedef int16_t hv_clamp_range_t;
 #define CONSTRAIN_HID(amt) ((amt) < INT8_MIN ? INT8_MIN : ((amt) > INT8_MAX ? INT8_MAX : (amt)))
 #define CONSTRAIN_HID_XY(amt) ((amt) < XY_REPORT_MIN ? XY_REPORT_MIN : ((amt) > XY_REPORT_MAX ? XY_REPORT_MAX : (amt)))
 
+#if defined(POINTING_DEVICE_MOTION_SCALE_X) || defined(POINTING_DEVICE_MOTION_SCALE_Y) || defined(POINTING_DEVICE_ACCEL_ENABLE)
+#    define POINTING_DEVICE_MOTION_ENABLE
+#    include "mouse_motion.h"
+#    ifndef POINTING_DEVICE_MOTION_SCALE_X
+#        define POINTING_DEVICE_MOTION_SCALE_X MOUSE_MOTION_ONE
+#    endif
+#    ifndef POINTING_DEVICE_MOTION_SCALE_Y
+#        define POINTING_DEVICE_MOTION_SCALE_Y MOUSE_MOTION_ONE
+#    endif
+#    ifdef POINTING_DEVICE_ACCEL_ENABLE
+#        ifndef POINTING_DEVICE_ACCEL_MIN_GAIN
+#            define POINTING_DEVICE_ACCEL_MIN_GAIN MOUSE_MOTION_ONE
+#        endif
+#        ifndef POINTING_DEVICE_ACCEL_MAX_GAIN
+#            define POINTING_DEVICE_ACCEL_MAX_GAIN (2 * MOUSE_MOTION_ONE)
+#        endif
+#        ifndef POINTING_DEVICE_ACCEL_EXPONENT
+#            define POINTING_DEVICE_ACCEL_EXPONENT 2
+#        endif
+#        ifndef POINTING_DEVICE_ACCEL_SPEED_MAX
+#            define POINTING_DEVICE_ACCEL_SPEED_MAX 64
+#        endif
+#    endif
+#endif
+
 void           pointing_device_init(void);
 bool           pointing_device_task(void);
 bool           pointing_device_send(void);
@@ -130,6 +155,11 @@ uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, poi
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
 void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
 
+#ifdef POINTING_DEVICE_MOTION_ENABLE
+void pointing_device_set_motion_scale(uint16_t scale_x, uint16_t scale_y);
+void pointing_device_reset_motion(void);
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
@@ -308,7 +308,7 @@ static void autoshift_end(uint16_t keycode, uint16_t now, bool matrix_trigger, k
  */
 void autoshift_matrix_scan(void) {
     if (autoshift_flags.in_progress) {
-        const uint16_t now = timer_read();
+        const uint16_t now = last_matrix_scan_time();
         if (TIMER_DIFF_16(now, autoshift_time) >=
 #ifdef AUTO_SHIFT_TIMEOUT_PER_KEY
             get_autoshift_timeout(autoshift_lastkey, &autoshift_lastrecord)
@@ -321,6 +321,20 @@ void autoshift_matrix_scan(void) {
     }
 }
 
+uint32_t autoshift_next_timeout(void) {
+    if (!autoshift_flags.in_progress) {
+        return UINT32_MAX;
+    }
+    uint16_t timeout =
+#ifdef AUTO_SHIFT_TIMEOUT_PER_KEY
+        get_autoshift_timeout(autoshift_lastkey, &autoshift_lastrecord);
+#else
+        autoshift_timeout;
+#endif
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), autoshift_time);
+    return elapsed < timeout ? timeout - elapsed : 0;
+}
+
 void autoshift_toggle(void) {
     autoshift_flags.enabled = !autoshift_flags.enabled;
     autoshift_flush_shift();
@@ -364,14 +378,14 @@ void set_autoshift_timeout(uint16_t timeout) {
 }
 
 bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
-    // Note that record->event.time isn't reliable, see:
-    // https://github.com/qmk/qmk_firmware/pull/9826#issuecomment-733559550
+    // Events are stamped with the time of the scan that saw them, so holds are
+    // measured from the switch changing rather than from when it got processed.
     // clang-format off
     const uint16_t now =
 #if !defined(RETRO_SHIFT) || defined(NO_ACTION_TAPPING)
-        timer_read()
+        record->event.time
 #else
-        (record->event.pressed) ? retroshift_time : timer_read()
+        (record->event.pressed) ? retroshift_time : record->event.time
 #endif
     ;
     // clang-format on
@@ -459,7 +473,9 @@ bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
                 && get_hold_on_other_key_press(keycode, record)
 #    endif
             ) {
-                autoshift_end(KC_NO, now, false, &autoshift_lastrecord);
+                // The release may have waited in the tapping buffer, the
+                // in-progress key has been held at least up to the last scan.
+                autoshift_end(KC_NO, last_matrix_scan_time(), false, &autoshift_lastrecord);
             }
 #endif
             // clang-format on
@@ -491,7 +507,7 @@ bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
 // Called to record time before possible delays by action_tapping_process.
 void retroshift_poll_time(keyevent_t *event) {
     last_retroshift_time = retroshift_time;
-    retroshift_time      = timer_read();
+    retroshift_time      = event->time;
 }
 // Used to swap the times of Retro Shifted key and Auto Shift key that interrupted it.
 void retroshift_swap_times(void) {
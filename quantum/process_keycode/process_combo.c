@@ -455,7 +455,7 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
 
 #ifndef COMBO_NO_TIMER
             /* Don't buffer this combo if its combo term has passed. */
-            if (timer && timer_elapsed(timer) > time) {
+            if (timer && TIMER_DIFF_16(record->event.time, timer) > time) {
                 DISABLE_COMBO(combo);
                 return COMBO_KEY_PRESSED;
             } else
@@ -592,10 +592,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_STRICT_TIMER
         if (!timer) {
             // timer is set only on the first key
-            timer = timer_read();
+            timer = record->event.time;
         }
 #    else
-        timer = timer_read();
+        timer = record->event.time;
 #    endif
 #endif
 
@@ -633,7 +633,8 @@ void combo_task(void) {
     }
 
 #ifndef COMBO_NO_TIMER
-    if (timer && timer_elapsed(timer) > longest_term) {
+    // Time out against the last processed scan rather than now, a key pressed in time may still be queued
+    if (timer && TIMER_DIFF_16(last_matrix_scan_time(), timer) > longest_term) {
         if (combo_buffer_read != combo_buffer_write) {
             apply_combos();
             longest_term = 0;
@@ -647,6 +648,16 @@ void combo_task(void) {
 #endif
 }
 
+uint32_t combo_next_timeout(void) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        uint16_t elapsed = TIMER_DIFF_16(timer_read(), timer);
+        return elapsed <= longest_term ? longest_term + 1 - elapsed : 0;
+    }
+#endif
+    return UINT32_MAX;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
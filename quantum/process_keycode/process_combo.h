@@ -75,6 +75,8 @@ typedef struct combo_t {
 
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
+// Milliseconds until the pending combo times out, UINT32_MAX if none is
+uint32_t combo_next_timeout(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
 void combo_enable(void);
@@ -18,15 +18,29 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "host.h"
+#include "timer.h"
 #include "wait.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    include "eeprom.h"
+#    include "eeconfig.h"
+#    ifndef DYNAMIC_MACRO_EEPROM_START
+#        if defined(VIA_ENABLE) || defined(DYNAMIC_KEYMAP_ENABLE)
+#            error "DYNAMIC_MACRO_EEPROM_STORAGE needs an explicit DYNAMIC_MACRO_EEPROM_START when VIA or dynamic keymaps are enabled"
+#        endif
+#        define DYNAMIC_MACRO_EEPROM_START (EECONFIG_SIZE)
+#    endif
+#endif
+
 // default feedback method
 void dynamic_macro_led_blink(void) {
 #ifdef BACKLIGHT_ENABLE
@@ -83,165 +97,418 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
 }
 
 /* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+ * need a `slot` variable accessible at the call site.
+ */
+#define DYNAMIC_MACRO_CURRENT_SLOT() (slot + 1)
+#define DYNAMIC_MACRO_DIRECTION(slot) ((slot) == 0 ? +1 : -1)
+#define DYNAMIC_MACRO_CURRENT_CAPACITY() ((int)(DYNAMIC_MACRO_BUFFER_SIZE - macro_length[!slot]))
+
+/* Events are stored as a byte stream rather than as whole keyrecord_t
+ * structures. Each event starts with a single byte:
+ *
+ *   bit 7    - pressed
+ *   bits 0-6 - the matrix position (row * MATRIX_COLS + col) of a plain
+ *              key event, or DYNAMIC_MACRO_EXTENDED for anything else
+ *
+ * An extended event carries a flags byte (the event type in the low
+ * nibble), the raw row and column, and then the tap state and the
+ * keycode if flagged. With DYNAMIC_MACRO_RECORD_TIMING each event ends
+ * with the milliseconds elapsed since the previous one, as a varint.
+ *
+ * Most keystrokes thus take two bytes, one for the press and one for
+ * the release.
+ */
+#define DYNAMIC_MACRO_PRESSED 0x80
+#define DYNAMIC_MACRO_EXTENDED 0x7F
+#define DYNAMIC_MACRO_TYPE_MASK 0x0F
+#define DYNAMIC_MACRO_HAS_TAP 0x10
+#define DYNAMIC_MACRO_HAS_KEYCODE 0x20
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 10
+
+_Static_assert(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_BUFFER_SIZE must fit in 16 bits");
+
+/* Both macros use the same buffer but read/write on different
+ * ends of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ * macro_byte(0, 0)   macro_length[0]
+ *  v                   v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *                           ^                                 ^
+ *                    macro_length[1]                 macro_byte(1, 0)
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ */
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+/* The length in bytes of each saved macro. */
+static uint16_t macro_length[2] = {0, 0};
+
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+/* The bytes recorded so far, and the length the macro would have if it
+ * ended after the last recorded key release. */
+static uint16_t record_length = 0;
+static uint16_t record_trim   = 0;
+#ifdef DYNAMIC_MACRO_RECORD_TIMING
+static uint16_t record_time = 0;
+#endif
+
+/* Nested playback: macro 1 may replay macro 2 and vice versa, so at most
+ * both are being played at once. */
+typedef struct {
+    uint8_t       slot;
+    uint16_t      offset;
+    layer_state_t saved_layer_state;
+} dynamic_macro_playback_t;
+
+static dynamic_macro_playback_t playback[2];
+static uint8_t                  playback_depth = 0;
+static uint16_t                 playback_timer = 0;
+
+static inline uint8_t *macro_byte(uint8_t slot, uint16_t offset) {
+    return slot == 0 ? &macro_buffer[offset] : &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - 1 - offset];
+}
+
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    define DYNAMIC_MACRO_EEPROM_MAGIC 0xD4AC
+
+typedef struct {
+    uint16_t magic;
+    uint16_t size;
+    uint8_t  cols;
+    uint16_t length[2];
+} dynamic_macro_eeprom_header_t;
+
+#    define DYNAMIC_MACRO_EEPROM_HEADER ((void *)(DYNAMIC_MACRO_EEPROM_START))
+#    define DYNAMIC_MACRO_EEPROM_BUFFER ((uint8_t *)(DYNAMIC_MACRO_EEPROM_START) + sizeof(dynamic_macro_eeprom_header_t))
+
+#    ifdef TOTAL_EEPROM_BYTE_COUNT
+_Static_assert((DYNAMIC_MACRO_EEPROM_START) + sizeof(dynamic_macro_eeprom_header_t) + (DYNAMIC_MACRO_BUFFER_SIZE) <= (TOTAL_EEPROM_BYTE_COUNT), "Dynamic macros are configured to use more EEPROM than is available.");
+#    endif
+
+/**
+ * Save the given macro. Only its part of the buffer is written, and
+ * only the bytes that changed actually hit the EEPROM.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+static void dynamic_macro_save(uint8_t slot) {
+    dynamic_macro_eeprom_header_t header = {
+        .magic  = DYNAMIC_MACRO_EEPROM_MAGIC,
+        .size   = DYNAMIC_MACRO_BUFFER_SIZE,
+        .cols   = MATRIX_COLS,
+        .length = {macro_length[0], macro_length[1]},
+    };
+    eeprom_update_block(&header, DYNAMIC_MACRO_EEPROM_HEADER, sizeof(header));
+
+    uint16_t start = slot == 0 ? 0 : DYNAMIC_MACRO_BUFFER_SIZE - macro_length[1];
+    eeprom_update_block(&macro_buffer[start], DYNAMIC_MACRO_EEPROM_BUFFER + start, macro_length[slot]);
+}
+#endif
+
+void dynamic_macro_init(void) {
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_eeprom_header_t header;
+    eeprom_read_block(&header, DYNAMIC_MACRO_EEPROM_HEADER, sizeof(header));
+
+    if (header.magic != DYNAMIC_MACRO_EEPROM_MAGIC || header.size != DYNAMIC_MACRO_BUFFER_SIZE || header.cols != MATRIX_COLS || header.length[0] + header.length[1] > DYNAMIC_MACRO_BUFFER_SIZE) {
+        dprintln("dynamic macro: no saved macros");
+        return;
+    }
+
+    eeprom_read_block(macro_buffer, DYNAMIC_MACRO_EEPROM_BUFFER, DYNAMIC_MACRO_BUFFER_SIZE);
+    macro_length[0] = header.length[0];
+    macro_length[1] = header.length[1];
+#endif
+}
 
 /**
- * Start recording of the dynamic macro.
+ * Encode a single event.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param[out] out    At least DYNAMIC_MACRO_MAX_EVENT_SIZE bytes.
+ * @param[in]  record The event to encode.
+ * @return The encoded size in bytes.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
-    dprintln("dynamic macro recording: started");
+static uint8_t dynamic_macro_encode(uint8_t *out, keyrecord_t *record) {
+    keyevent_t event = record->event;
+    uint8_t    size  = 0;
+    uint8_t    flags = event.type & DYNAMIC_MACRO_TYPE_MASK;
+
+#ifndef NO_ACTION_TAPPING
+    uint8_t tap;
+    memcpy(&tap, &record->tap, sizeof(tap));
+    if (tap) {
+        flags |= DYNAMIC_MACRO_HAS_TAP;
+    }
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode) {
+        flags |= DYNAMIC_MACRO_HAS_KEYCODE;
+    }
+#endif
 
-    dynamic_macro_record_start_kb(direction);
+    uint8_t  pressed  = event.pressed ? DYNAMIC_MACRO_PRESSED : 0;
+    uint16_t position = (uint16_t)event.key.row * MATRIX_COLS + event.key.col;
 
-    clear_keyboard();
-    layer_clear();
-    *macro_pointer = macro_buffer;
+    if (flags == KEY_EVENT && event.key.row < MATRIX_ROWS && position < DYNAMIC_MACRO_EXTENDED) {
+        out[size++] = pressed | position;
+    } else {
+        out[size++] = pressed | DYNAMIC_MACRO_EXTENDED;
+        out[size++] = flags;
+        out[size++] = event.key.row;
+        out[size++] = event.key.col;
+#ifndef NO_ACTION_TAPPING
+        if (flags & DYNAMIC_MACRO_HAS_TAP) {
+            out[size++] = tap;
+        }
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        if (flags & DYNAMIC_MACRO_HAS_KEYCODE) {
+            out[size++] = record->keycode & 0xFF;
+            out[size++] = record->keycode >> 8;
+        }
+#endif
+    }
+
+#ifdef DYNAMIC_MACRO_RECORD_TIMING
+    uint16_t delta = record_length == 0 ? 0 : TIMER_DIFF_16(event.time, record_time);
+    do {
+        out[size++] = (delta & 0x7F) | (delta > 0x7F ? 0x80 : 0);
+        delta >>= 7;
+    } while (delta);
+#endif
+
+    return size;
 }
 
 /**
- * Play the dynamic macro.
+ * Decode a single event.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param[in]  slot   The macro to read from.
+ * @param[in]  offset The offset of the event in the macro.
+ * @param[out] record The decoded event, without a timestamp.
+ * @param[out] delay  The recorded time since the previous event, left
+ *                    untouched unless DYNAMIC_MACRO_RECORD_TIMING is defined.
+ * @return The encoded size in bytes.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+static uint8_t dynamic_macro_decode(uint8_t slot, uint16_t offset, keyrecord_t *record, uint16_t *delay) {
+    uint8_t size = 0;
+    uint8_t head = *macro_byte(slot, offset + size++);
+
+    memset(record, 0, sizeof(keyrecord_t));
+    record->event.pressed = head & DYNAMIC_MACRO_PRESSED;
+    head &= ~DYNAMIC_MACRO_PRESSED;
+
+    if (head != DYNAMIC_MACRO_EXTENDED) {
+        record->event.type    = KEY_EVENT;
+        record->event.key.row = head / MATRIX_COLS;
+        record->event.key.col = head % MATRIX_COLS;
+    } else {
+        uint8_t flags         = *macro_byte(slot, offset + size++);
+        record->event.type    = flags & DYNAMIC_MACRO_TYPE_MASK;
+        record->event.key.row = *macro_byte(slot, offset + size++);
+        record->event.key.col = *macro_byte(slot, offset + size++);
+#ifndef NO_ACTION_TAPPING
+        if (flags & DYNAMIC_MACRO_HAS_TAP) {
+            memcpy(&record->tap, macro_byte(slot, offset + size++), sizeof(record->tap));
+        }
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        if (flags & DYNAMIC_MACRO_HAS_KEYCODE) {
+            record->keycode = *macro_byte(slot, offset + size++);
+            record->keycode |= (uint16_t)*macro_byte(slot, offset + size++) << 8;
+        }
+#endif
+    }
+
+#ifdef DYNAMIC_MACRO_RECORD_TIMING
+    uint8_t byte;
+    uint8_t shift = 0;
+    *delay        = 0;
+    do {
+        byte = *macro_byte(slot, offset + size++);
+        *delay |= (uint16_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+#endif
+
+    return size;
+}
+
+/**
+ * Start recording of the dynamic macro.
+ *
+ * @param[in] slot 0 or 1, the macro to record.
+ */
+static void dynamic_macro_record_start(uint8_t slot) {
+    dprintln("dynamic macro recording: started");
+
+    dynamic_macro_record_start_kb(DYNAMIC_MACRO_DIRECTION(slot));
 
-    layer_state_t saved_layer_state = layer_state;
+    /* Recording resets the keyboard state, which any playback relies on. */
+    playback_depth = 0;
 
     clear_keyboard();
     layer_clear();
+    macro_length[slot] = 0;
+    record_length      = 0;
+    record_trim        = 0;
+    macro_id           = slot + 1;
+}
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
+/**
+ * Start playing the dynamic macro. The events themselves are replayed by
+ * dynamic_macro_task(), so that the keyboard keeps scanning meanwhile.
+ *
+ * @param[in] slot 0 or 1, the macro to play.
+ */
+static void dynamic_macro_play(uint8_t slot) {
+    for (uint8_t i = 0; i < playback_depth; i++) {
+        if (playback[i].slot == slot) {
+            dprintln("dynamic macro: ignoring a recursive playback");
+            return;
+        }
     }
 
-    clear_keyboard();
+    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-    layer_state_set(saved_layer_state);
+    playback[playback_depth++] = (dynamic_macro_playback_t){
+        .slot              = slot,
+        .offset            = 0,
+        .saved_layer_state = layer_state,
+    };
 
-    dynamic_macro_play_kb(direction);
+    clear_keyboard();
+    layer_clear();
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
+ * @param[in] slot   0 or 1, the macro being recorded.
+ * @param[in] record The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+static void dynamic_macro_record_key(uint8_t slot, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && record_length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
+    uint8_t event[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint8_t size = dynamic_macro_encode(event, record);
+
+    /* The other end of the other macro is the last buffer byte it
      * is safe to use before overwriting the other macro.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    if (record_length + size <= DYNAMIC_MACRO_CURRENT_CAPACITY()) {
+        for (uint8_t i = 0; i < size; i++) {
+            *macro_byte(slot, record_length + i) = event[i];
+        }
+        record_length += size;
+        if (!record->event.pressed) {
+            record_trim = record_length;
+        }
+#ifdef DYNAMIC_MACRO_RECORD_TIMING
+        record_time = record->event.time;
+#endif
     }
-    dynamic_macro_record_key_kb(direction, record);
+    dynamic_macro_record_key_kb(DYNAMIC_MACRO_DIRECTION(slot), record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), record_length, DYNAMIC_MACRO_CURRENT_CAPACITY());
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * length of the macro.
+ *
+ * @param[in] slot 0 or 1, the macro being recorded.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
-    dynamic_macro_record_end_kb(direction);
+static void dynamic_macro_record_end(uint8_t slot) {
+    dynamic_macro_record_end_kb(DYNAMIC_MACRO_DIRECTION(slot));
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    if (record_trim != record_length) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
+    macro_length[slot] = record_trim;
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), macro_length[slot]);
 
-    *macro_end = macro_pointer;
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_save(slot);
+#endif
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
+/**
+ * If a dynamic macro is currently being recorded, stop recording.
+ */
+void dynamic_macro_stop_recording(void) {
+    if (macro_id != 0) {
+        dynamic_macro_record_end(macro_id - 1);
+    }
+    macro_id = 0;
+}
+
+bool dynamic_macro_is_playing(void) {
+    return playback_depth > 0;
+}
+
+/**
+ * Replay the next event of the macro being played, once its delay has
+ * passed and the host can take another report.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+void dynamic_macro_task(void) {
+    if (playback_depth == 0) {
+        return;
+    }
 
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
+    dynamic_macro_playback_t *current = &playback[playback_depth - 1];
+    uint8_t                   slot    = current->slot;
 
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+    if (current->offset >= macro_length[slot]) {
+        playback_depth--;
 
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+        clear_keyboard();
 
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+        layer_state_set(current->saved_layer_state);
 
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
+        dynamic_macro_play_kb(DYNAMIC_MACRO_DIRECTION(slot));
+        return;
+    }
 
-/**
- * If a dynamic macro is currently being recorded, stop recording.
- */
-void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
+    keyrecord_t record;
+    uint16_t    delay = DYNAMIC_MACRO_DELAY;
+    uint8_t     size  = dynamic_macro_decode(slot, current->offset, &record, &delay);
+
+    if (current->offset > 0 && timer_elapsed(playback_timer) < delay) {
+        return;
     }
-    macro_id = 0;
+    if (!host_keyboard_ready()) {
+        return;
+    }
+
+    current->offset += size;
+    playback_timer    = timer_read();
+    record.event.time = playback_timer;
+
+    /* May start a nested playback. */
+    process_record(&record);
 }
 
 /* Handle the key events related to the dynamic macros.
@@ -252,18 +519,16 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
-                    macro_id = 1;
+                    dynamic_macro_record_start(0);
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
-                    macro_id = 2;
+                    dynamic_macro_record_start(1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(0);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(1);
                     return false;
             }
         }
@@ -289,14 +554,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_kb(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(macro_id - 1, record);
                 }
                 return true;
                 break;
@@ -35,6 +35,25 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* The size in bytes of the buffer shared by both macros. Defaults to the
+ * memory DYNAMIC_MACRO_SIZE full key records used to take; as most
+ * events are now stored in a single byte, this holds several times as
+ * many of them.
+ */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
+/* The time in ms between replayed events, unless they were recorded
+ * with DYNAMIC_MACRO_RECORD_TIMING.
+ */
+#ifndef DYNAMIC_MACRO_DELAY
+#    define DYNAMIC_MACRO_DELAY 0
+#endif
+
+void dynamic_macro_init(void);
+void dynamic_macro_task(void);
+bool dynamic_macro_is_playing(void);
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -23,8 +23,10 @@
 #include "wait.h"
 #include "keymap_introspection.h"
 
+// Only one dance can be waiting for its timeout, any other key press finishes it
 static uint16_t active_td;
 static uint16_t last_tap_time;
+static uint16_t active_td_term;
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data) {
     tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
@@ -164,9 +166,13 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
             action->state.pressed = record->event.pressed;
             if (record->event.pressed) {
-                last_tap_time = timer_read();
+                last_tap_time = record->event.time;
                 process_tap_dance_action_on_each_tap(action);
                 active_td = action->state.finished ? 0 : keycode;
+                if (active_td) {
+                    // Resolve the term once per tap rather than on every scan
+                    active_td_term = GET_TAPPING_TERM(keycode, record);
+                }
             } else {
                 process_tap_dance_action_on_each_release(action);
                 if (action->state.finished) {
@@ -186,7 +192,7 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 void tap_dance_task(void) {
     tap_dance_action_t *action;
 
-    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+    if (!active_td || TIMER_DIFF_16(last_matrix_scan_time(), last_tap_time) <= active_td_term) return;
 
     action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
     if (!action->state.interrupted) {
@@ -194,6 +200,14 @@ void tap_dance_task(void) {
     }
 }
 
+uint32_t tap_dance_next_timeout(void) {
+    if (!active_td) {
+        return UINT32_MAX;
+    }
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), last_tap_time);
+    return elapsed <= active_td_term ? active_td_term + 1 - elapsed : 0;
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
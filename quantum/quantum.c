@@ -190,6 +190,9 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+    dynamic_keymap_flash_commit();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -200,11 +203,17 @@ void shutdown_quantum(bool jump_to_bootloader) {
     uint16_t timer_start = timer_read();
     PLAY_SONG(goodbye_song);
     shutdown_kb(jump_to_bootloader);
+#ifdef LED_COMPOSITOR_ENABLE
+    led_compositor_flush();
+#endif
     while (timer_elapsed(timer_start) < 250)
         wait_ms(1);
     stop_all_notes();
 #else
     shutdown_kb(jump_to_bootloader);
+#ifdef LED_COMPOSITOR_ENABLE
+    led_compositor_flush();
+#endif
     wait_ms(250);
 #endif
 #ifdef HAPTIC_ENABLE
@@ -539,6 +548,9 @@ void suspend_power_down_quantum(void) {
 #    ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
 #    endif
+#    ifdef LED_COMPOSITOR_ENABLE
+    led_compositor_task();
+#    endif
 
     // Turn off LED indicators
     led_suspend();
@@ -553,6 +565,11 @@ void suspend_power_down_quantum(void) {
     rgblight_suspend();
 #    endif
 
+#    ifdef LED_COMPOSITOR_ENABLE
+    // Don't leave anything pending while asleep
+    led_compositor_flush();
+#    endif
+
 #    if defined(LED_MATRIX_ENABLE)
     led_matrix_set_suspend_state(true);
 #    endif
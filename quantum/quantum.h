@@ -36,6 +36,10 @@
 #    include "rgb_matrix.h"
 #endif
 
+#ifdef LED_COMPOSITOR_ENABLE
+#    include "led_compositor.h"
+#endif
+
 #include "keymap_common.h"
 #include "quantum_keycodes.h"
 #include "keycode_config.h"
@@ -44,6 +48,7 @@
 #include "bootloader.h"
 #include "timer.h"
 #include "sync_timer.h"
+#include "state_change.h"
 #include "gpio.h"
 #include "atomic_util.h"
 #include "host.h"
@@ -186,6 +191,10 @@ extern layer_state_t layer_state;
 #    include "dynamic_keymap.h"
 #endif
 
+#ifdef DYNAMIC_KEYMAP_FLASH_STORE
+#    include "dynamic_keymap_flash.h"
+#endif
+
 #ifdef JOYSTICK_ENABLE
 #    include "joystick.h"
 #endif
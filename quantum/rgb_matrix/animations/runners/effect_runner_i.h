@@ -2,7 +2,7 @@
 
 typedef hsv_t (*i_f)(hsv_t hsv, uint8_t i, uint8_t time);
 
-bool effect_runner_i(effect_params_t* params, i_f effect_func) {
+bool RGB_MATRIX_RUNNER(effect_runner_i)(effect_params_t* params, i_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint8_t time = scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed / 4, 1));
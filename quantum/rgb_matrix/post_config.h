@@ -27,3 +27,8 @@
     defined(ENABLE_RGB_MATRIX_SOLID_MULTISPLASH)
 #    define RGB_MATRIX_KEYPRESSES
 #endif
+
+// Overlay layers of the LED compositor are blended onto the shadow buffer
+#if defined(LED_COMPOSITOR_ENABLE) && !defined(RGB_MATRIX_SHADOW_BUFFER)
+#    define RGB_MATRIX_SHADOW_BUFFER
+#endif
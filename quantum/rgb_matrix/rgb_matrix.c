@@ -29,6 +29,13 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_EFFECT_PROFILE
+#    include "basic_profiling.h"
+#endif
+#ifdef LED_COMPOSITOR_ENABLE
+#    include "led_compositor.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -39,7 +46,12 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
-// Generic effect runners
+// Generic effect runners, optionally placed in RAM to avoid flash wait states
+#if defined(RGB_MATRIX_RUNNERS_IN_RAM) && defined(RESIDENT_IN_RAM)
+#    define RGB_MATRIX_RUNNER(name) RESIDENT_IN_RAM(name)
+#else
+#    define RGB_MATRIX_RUNNER(name) name
+#endif
 #include "rgb_matrix_runners.inc"
 
 // ------------------------------------------
@@ -76,6 +88,9 @@ static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
+#ifdef LED_COMPOSITOR_ENABLE
+static uint16_t rgb_last_frame = 0;
+#endif
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -139,8 +154,80 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_SHADOW_BUFFER
+// What the driver buffer currently holds, and what was last flushed to the hardware
+static rgb_t   rgb_frame[RGB_MATRIX_LED_COUNT];
+static rgb_t   rgb_shadow[RGB_MATRIX_LED_COUNT];
+static uint8_t rgb_changed[RGB_MATRIX_CHANGE_MASK_SIZE];
+static bool    rgb_shadow_valid = false;
+
+#    ifdef LED_COMPOSITOR_ENABLE
+// Colors drawn underneath the overlay layers, and the LEDs the layers drew over. Effects don't necessarily redraw every
+// LED on every frame, so the base colors are put back before the layers are blended again.
+static rgb_t   rgb_base[RGB_MATRIX_LED_COUNT];
+static uint8_t rgb_overlaid[RGB_MATRIX_CHANGE_MASK_SIZE];
+static bool    rgb_overlaying = false;
+#    endif
+
+static inline bool rgb_matrix_frame_update(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_t *led = &rgb_frame[index];
+#    ifdef LED_COMPOSITOR_ENABLE
+    if (rgb_overlaying) {
+        // Overlay layers are blended onto what is already there
+        uint8_t alpha = led_compositor_alpha();
+        if (alpha < UINT8_MAX) {
+            red   = blend8(led->r, red, alpha);
+            green = blend8(led->g, green, alpha);
+            blue  = blend8(led->b, blue, alpha);
+        }
+        rgb_overlaid[index / 8] |= (1 << (index % 8));
+    } else {
+        rgb_base[index].r = red;
+        rgb_base[index].g = green;
+        rgb_base[index].b = blue;
+        rgb_overlaid[index / 8] &= ~(1 << (index % 8));
+    }
+#    endif
+    if (led->r == red && led->g == green && led->b == blue) {
+        return false;
+    }
+    led->r = red;
+    led->g = green;
+    led->b = blue;
+    rgb_changed[index / 8] |= (1 << (index % 8));
+    return true;
+}
+#endif
+
 void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_SHADOW_BUFFER
+    bool changed = false;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (!(rgb_changed[i / 8] & (1 << (i % 8)))) continue;
+        // Set to something else and back within the same frame
+        if (rgb_shadow_valid && memcmp(&rgb_frame[i], &rgb_shadow[i], sizeof(rgb_t)) == 0) {
+            rgb_changed[i / 8] &= ~(1 << (i % 8));
+            continue;
+        }
+        rgb_shadow[i] = rgb_frame[i];
+        changed       = true;
+    }
+
+    // Static frames cause no bus traffic at all, the very first one always goes out
+    if (!changed && rgb_shadow_valid) {
+        return;
+    }
+    rgb_shadow_valid = true;
+
+    if (rgb_matrix_driver.flush_changed) {
+        rgb_matrix_driver.flush_changed(rgb_changed);
+    } else {
+        rgb_matrix_driver.flush();
+    }
+    memset(rgb_changed, 0, sizeof(rgb_changed));
+#else
     rgb_matrix_driver.flush();
+#endif
 }
 
 __attribute__((weak)) int rgb_matrix_led_index(int index) {
@@ -153,13 +240,42 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_SHADOW_BUFFER
+    index = rgb_matrix_led_index(index);
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        if (!rgb_matrix_frame_update(index, red, green, blue)) {
+            return;
+        }
+        red   = rgb_frame[index].r;
+        green = rgb_frame[index].g;
+        blue  = rgb_frame[index].b;
+    }
+    rgb_matrix_driver.set_color(index, red, green, blue);
+#else
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #if defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
+#elif defined(RGB_MATRIX_SHADOW_BUFFER)
+#    ifdef LED_COMPOSITOR_ENABLE
+    // Blending gives each LED its own color
+    if (led_compositor_alpha() < UINT8_MAX) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+            rgb_matrix_set_color(i, red, green, blue);
+        return;
+    }
+#    endif
+    bool changed = false;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        changed |= rgb_matrix_frame_update(i, red, green, blue);
+    }
+    if (changed) {
+        rgb_matrix_driver.set_color_all(red, green, blue);
+    }
 #else
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
@@ -248,6 +364,69 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+typedef bool (*rgb_matrix_effect_func_t)(effect_params_t *params);
+
+// Dense dispatch table, only the enabled effects get an entry
+static const rgb_matrix_effect_func_t rgb_matrix_effect_funcs[RGB_MATRIX_EFFECT_MAX] PROGMEM = {
+    [RGB_MATRIX_NONE] = rgb_matrix_none,
+// ---------------------------------------------
+// -----Begin rgb effect table macros-----------
+#define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_##name] = name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+
+#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#    define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_CUSTOM_##name] = name,
+#    ifdef RGB_MATRIX_CUSTOM_KB
+#        include "rgb_matrix_kb.inc"
+#    endif
+#    ifdef RGB_MATRIX_CUSTOM_USER
+#        include "rgb_matrix_user.inc"
+#    endif
+#    undef RGB_MATRIX_EFFECT
+#endif
+    // -----End rgb effect table macros-------------
+    // ---------------------------------------------
+};
+
+#ifdef RGB_MATRIX_EFFECT_PROFILE
+static rgb_matrix_effect_profile_t rgb_effect_profile[RGB_MATRIX_EFFECT_MAX];
+
+rgb_matrix_effect_profile_t rgb_matrix_get_effect_profile(uint8_t mode) {
+    rgb_matrix_effect_profile_t profile = {0};
+    if (mode < RGB_MATRIX_EFFECT_MAX) {
+        profile = rgb_effect_profile[mode];
+    }
+    return profile;
+}
+
+void rgb_matrix_reset_effect_profile(void) {
+    memset(rgb_effect_profile, 0, sizeof(rgb_effect_profile));
+}
+
+static void rgb_matrix_print_effect_profile(uint8_t mode) {
+    rgb_matrix_effect_profile_t *profile = &rgb_effect_profile[mode];
+    if (profile->renders) {
+        dprintf("rgb matrix effect %u: %lu renders, avg %lu, max %lu ticks\n", mode, (unsigned long)profile->renders, (unsigned long)(profile->total / profile->renders), (unsigned long)profile->max);
+    }
+}
+
+static bool rgb_matrix_profile_effect(uint8_t effect) {
+    rgb_matrix_effect_func_t func  = (rgb_matrix_effect_func_t)pgm_read_ptr(&rgb_matrix_effect_funcs[effect]);
+    uint32_t                 start = TIMESTAMP_GETTER;
+    bool                     ret   = func(&rgb_effect_params);
+    uint32_t                 ticks = (uint32_t)(TIMESTAMP_GETTER - start);
+
+    rgb_matrix_effect_profile_t *profile = &rgb_effect_profile[effect];
+    profile->renders++;
+    profile->total += ticks;
+    if (ticks > profile->max) {
+        profile->max = ticks;
+    }
+    return ret;
+}
+#endif // RGB_MATRIX_EFFECT_PROFILE
+
 static void rgb_task_timers(void) {
 #if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
@@ -270,7 +449,15 @@ static void rgb_task_timers(void) {
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
+#ifdef LED_COMPOSITOR_ENABLE
+    // Start a new frame each time the compositor does
+    if (rgb_last_frame != led_compositor_frame()) {
+        rgb_last_frame = led_compositor_frame();
+        rgb_task_state = STARTING;
+    }
+#else
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#endif
 }
 
 static void rgb_task_start(void) {
@@ -297,42 +484,20 @@ static void rgb_task_render(uint8_t effect) {
 
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
-    switch (effect) {
-        case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
-            break;
-
-// ---------------------------------------------
-// -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
-        break;
-#include "rgb_matrix_effects.inc"
-#undef RGB_MATRIX_EFFECT
-
-#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
-            break;
-#    ifdef RGB_MATRIX_CUSTOM_KB
-#        include "rgb_matrix_kb.inc"
-#    endif
-#    ifdef RGB_MATRIX_CUSTOM_USER
-#        include "rgb_matrix_user.inc"
-#    endif
-#    undef RGB_MATRIX_EFFECT
+    if (effect < RGB_MATRIX_EFFECT_MAX) {
+#ifdef RGB_MATRIX_EFFECT_PROFILE
+        if (rgb_effect_params.init && rgb_last_effect < RGB_MATRIX_EFFECT_MAX) {
+            rgb_matrix_print_effect_profile(rgb_last_effect);
+        }
+        rendering = rgb_matrix_profile_effect(effect);
+#else
+        rendering = ((rgb_matrix_effect_func_t)pgm_read_ptr(&rgb_matrix_effect_funcs[effect]))(&rgb_effect_params);
 #endif
-            // -----End rgb effect switch case macros-------
-            // ---------------------------------------------
-
+    } else if (effect == UINT8_MAX) {
         // Factory default magic value
-        case UINT8_MAX: {
-            rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+        rgb_matrix_test();
+        rgb_task_state = FLUSHING;
+        return;
     }
 
     rgb_effect_params.iter++;
@@ -353,7 +518,13 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#if defined(LED_COMPOSITOR_ENABLE)
+    led_compositor_request_flush(rgb_matrix_update_pwm_buffers);
+#elif defined(THREADED_TASKS)
+    keyboard_lighting_request_flush(rgb_matrix_update_pwm_buffers);
+#else
     rgb_matrix_update_pwm_buffers();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
@@ -434,6 +605,22 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     return limits;
 }
 
+#ifdef LED_COMPOSITOR_ENABLE
+static void rgb_matrix_render_layers(uint8_t led_min, uint8_t led_max) {
+    // Start over from the base colors where the layers drew last time
+    for (uint8_t i = led_min; i < led_max; i++) {
+        int index = rgb_matrix_led_index(i);
+        if (index >= 0 && index < RGB_MATRIX_LED_COUNT && (rgb_overlaid[index / 8] & (1 << (index % 8)))) {
+            rgb_matrix_set_color(i, rgb_base[index].r, rgb_base[index].g, rgb_base[index].b);
+        }
+    }
+
+    rgb_overlaying = true;
+    led_compositor_render_layers(led_min, led_max);
+    rgb_overlaying = false;
+}
+#endif
+
 void rgb_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
      * Could move the invocations to rgb_task_render, but then it's missing a few checks
@@ -442,6 +629,9 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      */
     RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     rgb_matrix_indicators_advanced_kb(min, max);
+#ifdef LED_COMPOSITOR_ENABLE
+    rgb_matrix_render_layers(min, max);
+#endif
 }
 
 __attribute__((weak)) bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max) {
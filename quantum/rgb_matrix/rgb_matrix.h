@@ -168,6 +168,17 @@ void rgb_matrix_init(void);
 
 void rgb_matrix_reload_from_eeprom(void);
 
+#ifdef RGB_MATRIX_EFFECT_PROFILE
+typedef struct {
+    uint32_t renders; // number of render passes
+    uint32_t total;   // accumulated render time, in profiling timestamp ticks
+    uint32_t max;     // longest single render pass, in profiling timestamp ticks
+} rgb_matrix_effect_profile_t;
+
+rgb_matrix_effect_profile_t rgb_matrix_get_effect_profile(uint8_t mode);
+void                        rgb_matrix_reset_effect_profile(void);
+#endif
+
 void        rgb_matrix_set_suspend_state(bool state);
 bool        rgb_matrix_get_suspend_state(void);
 void        rgb_matrix_toggle(void);
@@ -46,6 +46,11 @@ typedef struct {
     void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
     /* Flush any buffered changes to the hardware. */
     void (*flush)(void);
+    /* Optional, used instead of flush() with RGB_MATRIX_SHADOW_BUFFER: flush only the LEDs whose bit is set in the change mask. */
+    void (*flush_changed)(const uint8_t *changed);
 } rgb_matrix_driver_t;
 
+/* One bit per LED index, as passed to flush_changed() */
+#define RGB_MATRIX_CHANGE_MASK_SIZE ((RGB_MATRIX_LED_COUNT + 7) / 8)
+
 extern const rgb_matrix_driver_t rgb_matrix_driver;
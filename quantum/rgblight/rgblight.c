@@ -23,10 +23,16 @@
 #include "debug.h"
 #include "util.h"
 #include "led_tables.h"
+#ifdef THREADED_TASKS
+#    include "keyboard.h"
+#endif
 #include <lib/lib8tion/lib8tion.h>
 #ifdef EEPROM_ENABLE
 #    include "eeprom.h"
 #endif
+#ifdef LED_COMPOSITOR_ENABLE
+#    include "led_compositor.h"
+#endif
 
 #ifdef RGBLIGHT_SPLIT
 /* for split keyboard */
@@ -894,7 +900,13 @@ void rgblight_set(void) {
     }
 #endif
 
+#if defined(LED_COMPOSITOR_ENABLE)
+    led_compositor_request_flush(rgblight_driver.flush);
+#elif defined(THREADED_TASKS)
+    keyboard_lighting_request_flush(rgblight_driver.flush);
+#else
     rgblight_driver.flush();
+#endif
 }
 
 #ifdef RGBLIGHT_SPLIT
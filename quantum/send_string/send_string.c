@@ -24,6 +24,12 @@
 #include "action.h"
 #include "wait.h"
 
+#ifdef SENDSTRING_ASYNC
+#    include <string.h>
+#    include "host.h"
+#    include "timer.h"
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
@@ -292,6 +298,238 @@ void tap_random_base64(void) {
     }
 }
 
+#ifdef SENDSTRING_ASYNC
+typedef enum {
+    SEND_STRING_OP_DELAY,
+    SEND_STRING_OP_REGISTER,
+    SEND_STRING_OP_UNREGISTER,
+} send_string_op_action_t;
+
+typedef struct {
+    uint8_t  action;
+    uint8_t  keycode;
+    uint16_t delay; // ms to wait after the action
+} send_string_op_t;
+
+typedef struct {
+    const char *string;
+    uint8_t     interval;
+#    if defined(__AVR__)
+    bool progmem;
+#    endif
+} send_string_job_t;
+
+// The most ops a single source character can expand to: a press and a release each for Shift, AltGr, the key
+// itself and the Space after a dead key. Nothing is compiled unless this much room is left in the ring.
+#    define SEND_STRING_OPS_PER_CHAR 8
+
+_Static_assert(SEND_STRING_ASYNC_BUFFER_SIZE >= SEND_STRING_OPS_PER_CHAR, "SEND_STRING_ASYNC_BUFFER_SIZE is too small");
+
+static send_string_job_t async_jobs[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t           async_job_head  = 0;
+static uint8_t           async_job_count = 0;
+static send_string_op_t  async_ops[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint8_t           async_op_head  = 0;
+static uint8_t           async_op_count = 0;
+static uint16_t          async_wait_until;
+static bool              async_waiting = false;
+// Keys pressed by playback and not released yet, their release may not even be compiled
+static uint8_t async_held[32];
+
+static inline void async_set_held(uint8_t keycode, bool held) {
+    if (held) {
+        async_held[keycode / 8] |= (1 << (keycode % 8));
+    } else {
+        async_held[keycode / 8] &= ~(1 << (keycode % 8));
+    }
+}
+
+static inline char async_read(const send_string_job_t *job) {
+#    if defined(__AVR__)
+    if (job->progmem) {
+        return pgm_read_byte(job->string);
+    }
+#    endif
+    return *job->string;
+}
+
+static void async_push(uint8_t action, uint8_t keycode, uint16_t delay) {
+    send_string_op_t *op = &async_ops[(async_op_head + async_op_count) % SEND_STRING_ASYNC_BUFFER_SIZE];
+
+    op->action  = action;
+    op->keycode = keycode;
+    op->delay   = delay;
+    async_op_count++;
+}
+
+static void async_push_char(char ascii_code, uint8_t interval) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) async_push(SEND_STRING_OP_REGISTER, KC_LEFT_SHIFT, interval);
+    if (is_altgred) async_push(SEND_STRING_OP_REGISTER, KC_RIGHT_ALT, interval);
+    async_push(SEND_STRING_OP_REGISTER, keycode, interval);
+    async_push(SEND_STRING_OP_UNREGISTER, keycode, interval);
+    if (is_altgred) async_push(SEND_STRING_OP_UNREGISTER, KC_RIGHT_ALT, interval);
+    if (is_shifted) async_push(SEND_STRING_OP_UNREGISTER, KC_LEFT_SHIFT, interval);
+    if (is_dead) {
+        async_push(SEND_STRING_OP_REGISTER, KC_SPACE, TAP_CODE_DELAY);
+        async_push(SEND_STRING_OP_UNREGISTER, KC_SPACE, interval);
+    }
+}
+
+/* Compiles the next character (or special sequence) of a job into ops. */
+static void async_compile(send_string_job_t *job) {
+    char ascii_code = async_read(job);
+
+    if (ascii_code == SS_QMK_PREFIX) {
+        job->string++;
+        ascii_code = async_read(job);
+
+        if (ascii_code == SS_TAP_CODE) {
+            job->string++;
+            uint8_t keycode = async_read(job);
+            async_push(SEND_STRING_OP_REGISTER, keycode, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+            async_push(SEND_STRING_OP_UNREGISTER, keycode, job->interval);
+        } else if (ascii_code == SS_DOWN_CODE) {
+            job->string++;
+            async_push(SEND_STRING_OP_REGISTER, async_read(job), job->interval);
+        } else if (ascii_code == SS_UP_CODE) {
+            job->string++;
+            async_push(SEND_STRING_OP_UNREGISTER, async_read(job), job->interval);
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint16_t ms = 0;
+
+            job->string++;
+            while (isdigit(async_read(job))) {
+                ms *= 10;
+                ms += async_read(job) - '0';
+                job->string++;
+            }
+            async_push(SEND_STRING_OP_DELAY, KC_NO, ms + job->interval);
+        }
+    } else {
+        async_push_char(ascii_code, job->interval);
+    }
+
+    job->string++;
+}
+
+/* Keeps the op buffer topped up from the queued strings. */
+static void async_fill(void) {
+    while (async_job_count > 0 && SEND_STRING_ASYNC_BUFFER_SIZE - async_op_count >= SEND_STRING_OPS_PER_CHAR) {
+        send_string_job_t *job = &async_jobs[async_job_head];
+
+        if (!async_read(job)) {
+            async_job_head = (async_job_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+            async_job_count--;
+            continue;
+        }
+
+        async_compile(job);
+    }
+}
+
+static bool async_enqueue(const char *string, uint8_t interval, bool progmem) {
+    if (async_job_count >= SEND_STRING_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+
+    send_string_job_t *job = &async_jobs[(async_job_head + async_job_count) % SEND_STRING_ASYNC_QUEUE_SIZE];
+
+    job->string   = string;
+    job->interval = interval;
+#    if defined(__AVR__)
+    job->progmem = progmem;
+#    endif
+    async_job_count++;
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    return async_enqueue(string, interval, false);
+}
+
+#    if defined(__AVR__)
+bool send_string_async_P(const char *string) {
+    return send_string_async_with_delay_P(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    return async_enqueue(string, interval, true);
+}
+#    endif
+
+bool send_string_async_busy(void) {
+    return async_job_count > 0 || async_op_count > 0 || async_waiting;
+}
+
+void send_string_async_cancel(void) {
+    for (uint16_t keycode = 0; keycode <= UINT8_MAX; keycode++) {
+        if (async_held[keycode / 8] & (1 << (keycode % 8))) {
+            unregister_code(keycode);
+        }
+    }
+    memset(async_held, 0, sizeof(async_held));
+
+    async_op_count  = 0;
+    async_job_count = 0;
+    async_waiting   = false;
+}
+
+void send_string_task(void) {
+    async_fill();
+
+    while (async_op_count > 0 || async_waiting) {
+        if (async_waiting) {
+            if (!timer_expired(timer_read(), async_wait_until)) {
+                return;
+            }
+            async_waiting = false;
+            continue;
+        }
+
+        // Let the host catch up instead of blocking on a full endpoint. Without a driver reports go nowhere,
+        // so there is nothing to wait for.
+        if (host_get_driver() && !host_keyboard_ready()) {
+            return;
+        }
+
+        send_string_op_t op = async_ops[async_op_head];
+        async_op_head       = (async_op_head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+        async_op_count--;
+
+        if (op.action == SEND_STRING_OP_REGISTER) {
+            register_code(op.keycode);
+            async_set_held(op.keycode, true);
+        } else if (op.action == SEND_STRING_OP_UNREGISTER) {
+            unregister_code(op.keycode);
+            async_set_held(op.keycode, false);
+        }
+
+        if (op.delay) {
+            async_wait_until = timer_read() + op.delay;
+            async_waiting    = true;
+        }
+
+        async_fill();
+    }
+}
+#endif
+
 #if defined(__AVR__)
 void send_string_P(const char *string) {
     send_string_with_delay_P(string, TAP_CODE_DELAY);
@@ -23,6 +23,7 @@
  * \{
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "progmem.h"
@@ -161,4 +162,72 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SENDSTRING_ASYNC) || defined(__DOXYGEN__)
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#    endif
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 16
+#    endif
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * This function simply calls `send_string_async_with_delay(string, TAP_CODE_DELAY)`.
+ *
+ * \param string The string to type out. It is read as it is typed, so it must stay valid until then, eg. a string literal.
+ *
+ * \return false if SEND_STRING_ASYNC_QUEUE_SIZE strings are already queued.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background, with a delay between each character.
+ *
+ * Rather than blocking until the whole string is typed, the keystrokes are sent by `send_string_task()` as fast as the host accepts them, while the keyboard keeps running.
+ *
+ * \param string The string to type out. It is read as it is typed, so it must stay valid until then, eg. a string literal.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ *
+ * \return false if SEND_STRING_ASYNC_QUEUE_SIZE strings are already queued.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, TAP_CODE_DELAY).
+ */
+bool send_string_async_P(const char *string);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background, with a delay between each character.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_P(string) send_string_async_with_delay(string, TAP_CODE_DELAY)
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Whether queued strings are still being typed out.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Drop all queued strings, releasing any keys they are holding down.
+ */
+void send_string_async_cancel(void);
+
+void send_string_task(void);
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+#endif
+
 /** \} */
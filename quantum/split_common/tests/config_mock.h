@@ -0,0 +1,18 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 10
+#define MATRIX_COLS 8
+
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_LED_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_WATCHDOG_ENABLE
+#define SPLIT_TRANSACTION_IDS_USER USER_SYNC_A
+
+/* The serial_usart.c default, and roughly what a half duplex link loses per
+ * change of direction: the echo of the last byte, switching the pin and
+ * waking up the thread on the other side. */
+#define SERIAL_USART_SPEED 230400
+#define MOCK_SERIAL_TURNAROUND_NS 20000
@@ -0,0 +1,158 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial_protocol.h"
+#include "mock_serial.h"
+
+#define sizeof_member(type, member) sizeof(((type *)NULL)->member)
+
+#define trans_initiator2target_initializer(member) \
+    { sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), 0, 0, NULL }
+#define trans_target2initiator_initializer(member) \
+    { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), NULL }
+
+// The same layout as transactions.c, without the callbacks, which are up to the tests
+static const split_transaction_desc_t default_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
+    [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [PUT_SYNC_TIMER]            = trans_initiator2target_initializer(sync_timer),
+    [PUT_LAYER_STATE]           = trans_initiator2target_initializer(layers.layer_state),
+    [PUT_DEFAULT_LAYER_STATE]   = trans_initiator2target_initializer(layers.default_layer_state),
+    [PUT_LED_STATE]             = trans_initiator2target_initializer(led_state),
+    [PUT_MODS]                  = trans_initiator2target_initializer(mods),
+    [PUT_WATCHDOG]              = trans_initiator2target_initializer(watchdog_pinged),
+    [PUT_RPC_INFO]              = trans_initiator2target_initializer(rpc_info),
+    [PUT_RPC_REQ_DATA]          = trans_initiator2target_initializer(rpc_m2s_buffer),
+    [EXECUTE_RPC]               = trans_initiator2target_initializer(rpc_info.payload.transaction_id),
+    [GET_RPC_RESP_DATA]         = trans_target2initiator_initializer(rpc_s2m_buffer),
+};
+
+static split_shared_memory_t master_shmem;
+split_shared_memory_t *const split_shmem = &master_shmem;
+split_shared_memory_t        mock_slave_shmem;
+
+split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+split_transaction_desc_t mock_slave_transaction_table[NUM_TOTAL_TRANSACTIONS];
+
+typedef struct {
+    uint8_t data[2 * SERIAL_PROTOCOL_FRAME_SIZE];
+    size_t  head;
+    size_t  tail;
+    size_t  sent;
+    size_t  corrupt_index;
+    bool    corrupt;
+} mock_queue_t;
+
+static mock_queue_t        queues[2];
+static mock_serial_stats_t stats;
+static bool                slave_turn = false;
+
+void mock_serial_account(mock_serial_stats_t *account, mock_serial_direction_t direction, size_t bytes) {
+    if (account->bytes > 0 && direction != account->last_direction) {
+        account->turnarounds++;
+        account->link_time_ns += MOCK_SERIAL_TURNAROUND_NS;
+    }
+    account->last_direction = direction;
+    account->bytes += bytes;
+    // One start and one stop bit
+    account->link_time_ns += (uint64_t)bytes * 10 * 1000000000 / SERIAL_USART_SPEED;
+}
+
+static void swap(void *a, void *b, size_t size) {
+    uint8_t *x = a, *y = b;
+    for (size_t i = 0; i < size; i++) {
+        uint8_t t = x[i];
+        x[i]      = y[i];
+        y[i]      = t;
+    }
+}
+
+static void swap_halves(void) {
+    swap(split_shmem, &mock_slave_shmem, sizeof(split_shared_memory_t));
+    swap(split_transaction_table, mock_slave_transaction_table, sizeof(split_transaction_table));
+    slave_turn = !slave_turn;
+}
+
+// What the slave thread of serial_protocol.c does with everything the master sent
+static void run_slave(void) {
+    mock_queue_t *queue = &queues[MOCK_MASTER_TO_SLAVE];
+
+    swap_halves();
+    while (queue->head != queue->tail) {
+        if (!serial_protocol_framed_react()) {
+            stats.slave_failures++;
+            serial_transport_driver_clear();
+        }
+    }
+    swap_halves();
+}
+
+void mock_serial_reset(void) {
+    memset(queues, 0, sizeof(queues));
+    memset(&stats, 0, sizeof(stats));
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    memset(&mock_slave_shmem, 0, sizeof(mock_slave_shmem));
+    memcpy(split_transaction_table, default_transaction_table, sizeof(default_transaction_table));
+    memcpy(mock_slave_transaction_table, default_transaction_table, sizeof(default_transaction_table));
+}
+
+void mock_serial_corrupt(mock_serial_direction_t direction, size_t index) {
+    queues[direction].corrupt       = true;
+    queues[direction].corrupt_index = queues[direction].sent + index;
+}
+
+mock_serial_stats_t mock_serial_stats(void) {
+    return stats;
+}
+
+void serial_transport_driver_clear(void) {
+    mock_queue_t *queue = &queues[slave_turn ? MOCK_MASTER_TO_SLAVE : MOCK_SLAVE_TO_MASTER];
+    queue->head = queue->tail = 0;
+}
+
+void serial_transport_driver_slave_init(void) {}
+
+void serial_transport_driver_master_init(void) {}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    mock_serial_direction_t direction = slave_turn ? MOCK_SLAVE_TO_MASTER : MOCK_MASTER_TO_SLAVE;
+    mock_queue_t           *queue     = &queues[direction];
+
+    if (queue->tail + size > sizeof(queue->data)) {
+        return false;
+    }
+    for (size_t i = 0; i < size; i++, queue->sent++) {
+        uint8_t byte = source[i];
+        if (queue->corrupt && queue->sent == queue->corrupt_index) {
+            byte ^= 0x10;
+            queue->corrupt = false;
+        }
+        queue->data[queue->tail++] = byte;
+    }
+    mock_serial_account(&stats, direction, size);
+    return true;
+}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    mock_queue_t *queue = &queues[slave_turn ? MOCK_MASTER_TO_SLAVE : MOCK_SLAVE_TO_MASTER];
+
+    if (!slave_turn && queue->tail - queue->head < size) {
+        run_slave();
+    }
+    // Nothing more is coming, that's a timeout
+    if (queue->tail - queue->head < size) {
+        return false;
+    }
+    memcpy(destination, &queue->data[queue->head], size);
+    queue->head += size;
+    if (queue->head == queue->tail) {
+        queue->head = queue->tail = 0;
+    }
+    return true;
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    return serial_transport_receive(destination, size);
+}
@@ -0,0 +1,45 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
+#include "transactions.h"
+
+/* A loopback link with both halves in one process. Outside of the slave's
+ * turn `split_shmem` and `split_transaction_table` are the master's, the
+ * slave's live in the mock_slave_* copies and are swapped in whenever the
+ * master waits for bytes the slave hasn't sent yet. */
+
+typedef enum {
+    MOCK_MASTER_TO_SLAVE,
+    MOCK_SLAVE_TO_MASTER,
+} mock_serial_direction_t;
+
+typedef struct {
+    uint32_t                bytes;
+    uint32_t                turnarounds;
+    uint32_t                slave_failures;
+    uint64_t                link_time_ns;
+    mock_serial_direction_t last_direction;
+} mock_serial_stats_t;
+
+extern split_shared_memory_t    mock_slave_shmem;
+extern split_transaction_desc_t mock_slave_transaction_table[NUM_TOTAL_TRANSACTIONS];
+
+// Restores both tables to the defaults and clears both shared memories, the queues and the stats
+void mock_serial_reset(void);
+
+// Flips a bit of the byte with the given index of everything sent in that direction from now on
+void mock_serial_corrupt(mock_serial_direction_t direction, size_t index);
+
+// Accounts for bytes and turnarounds the same way the link does, for modelling other protocols
+void mock_serial_account(mock_serial_stats_t *stats, mock_serial_direction_t direction, size_t bytes);
+
+mock_serial_stats_t mock_serial_stats(void);
@@ -0,0 +1,24 @@
+split_serial_framed_DEFS := -DSPLIT_KEYBOARD -DSERIAL_PROTOCOL_FRAMED
+split_serial_framed_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(PLATFORM_PATH)/chibios/drivers \
+	$(DRIVER_PATH)
+split_serial_framed_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+
+split_serial_framed_SRC := \
+	$(PLATFORM_PATH)/chibios/drivers/serial_protocol_framed.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_serial.c \
+	$(QUANTUM_PATH)/split_common/tests/split_serial_framed_tests.cpp
+
+split_serial_stream_DEFS := -DSPLIT_KEYBOARD -DSERIAL_USART_STREAMING
+split_serial_stream_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(PLATFORM_PATH)/chibios/drivers \
+	$(DRIVER_PATH)
+split_serial_stream_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+
+split_serial_stream_SRC := \
+	$(PLATFORM_PATH)/chibios/drivers/serial_stream.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/tests/split_serial_stream_tests.cpp
@@ -0,0 +1,232 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <vector>
+
+extern "C" {
+#include "crc.h"
+#include "serial_protocol.h"
+#include "split_common/tests/mock_serial.h"
+}
+
+namespace {
+
+std::vector<int8_t> slave_calls;
+
+// Called on the slave, so the table and shared memory are the slave's
+int8_t transaction_of(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer) {
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (trans->initiator2target_buffer_size == initiator2target_buffer_size && trans->target2initiator_buffer_size == target2initiator_buffer_size && split_trans_initiator2target_buffer(trans) == initiator2target_buffer && split_trans_target2initiator_buffer(trans) == target2initiator_buffer) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+void record_call(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    slave_calls.push_back(transaction_of(initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer));
+}
+
+// The same as slave_rpc_info_callback() in transactions.c
+void rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = split_shmem->rpc_info.payload.m2s_length;
+    split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = split_shmem->rpc_info.payload.s2m_length;
+}
+
+void rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    for (uint8_t i = 0; i < split_shmem->rpc_info.payload.s2m_length; i++) {
+        split_shmem->rpc_s2m_buffer[i] = split_shmem->rpc_m2s_buffer[i] + 1;
+    }
+}
+
+void record_all_calls(void) {
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        mock_slave_transaction_table[id].slave_callback = record_call;
+    }
+}
+
+void set_slave_matrix(uint8_t seed) {
+    for (size_t i = 0; i < sizeof(mock_slave_shmem.smatrix.matrix) / sizeof(mock_slave_shmem.smatrix.matrix[0]); i++) {
+        mock_slave_shmem.smatrix.matrix[i] = seed + i;
+    }
+    mock_slave_shmem.smatrix.checksum = crc8(mock_slave_shmem.smatrix.matrix, sizeof(mock_slave_shmem.smatrix.matrix));
+}
+
+// What the old protocol sends for one transaction: the id, the handshake, then the buffers
+void account_legacy_transaction(mock_serial_stats_t *stats, int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    mock_serial_account(stats, MOCK_MASTER_TO_SLAVE, 1);
+    mock_serial_account(stats, MOCK_SLAVE_TO_MASTER, 1);
+    if (trans->initiator2target_buffer_size) {
+        mock_serial_account(stats, MOCK_MASTER_TO_SLAVE, trans->initiator2target_buffer_size);
+    }
+    if (trans->target2initiator_buffer_size) {
+        mock_serial_account(stats, MOCK_SLAVE_TO_MASTER, trans->target2initiator_buffer_size);
+    }
+}
+
+} // namespace
+
+class SplitSerialFramed : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_serial_reset();
+        slave_calls.clear();
+    }
+};
+
+TEST_F(SplitSerialFramed, BatchInOneRoundTrip) {
+    const uint8_t ids[] = {PUT_LAYER_STATE, PUT_LED_STATE, PUT_MODS, GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA};
+
+    record_all_calls();
+    split_shmem->layers.layer_state = 0x1234;
+    split_shmem->led_state          = 0x04;
+    split_shmem->mods.real_mods     = 0x02;
+    set_slave_matrix(1);
+
+    EXPECT_TRUE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+
+    EXPECT_EQ(slave_calls, std::vector<int8_t>(ids, ids + sizeof(ids)));
+    EXPECT_EQ(mock_slave_shmem.layers.layer_state, 0x1234);
+    EXPECT_EQ(mock_slave_shmem.led_state, 0x04);
+    EXPECT_EQ(mock_slave_shmem.mods.real_mods, 0x02);
+    EXPECT_EQ(memcmp(&split_shmem->smatrix, &mock_slave_shmem.smatrix, sizeof(split_shmem->smatrix)), 0);
+
+    mock_serial_stats_t stats = mock_serial_stats();
+    EXPECT_EQ(stats.turnarounds, 1);
+    EXPECT_EQ(stats.slave_failures, 0);
+}
+
+TEST_F(SplitSerialFramed, SplitsBatchesLargerThanAFrame) {
+    std::vector<uint8_t> ids(12, PUT_RPC_REQ_DATA);
+
+    record_all_calls();
+    ASSERT_GT(ids.size() * RPC_M2S_BUFFER_SIZE, SERIAL_PROTOCOL_FRAME_SIZE);
+
+    EXPECT_TRUE(serial_protocol_framed_initiate(ids.data(), ids.size()));
+
+    EXPECT_EQ(slave_calls, std::vector<int8_t>(ids.begin(), ids.end()));
+    EXPECT_EQ(mock_serial_stats().turnarounds, 3);
+}
+
+TEST_F(SplitSerialFramed, CallbackResizesFollowingTransactions) {
+    const uint8_t ids[] = {PUT_RPC_INFO, PUT_RPC_REQ_DATA, EXECUTE_RPC, GET_RPC_RESP_DATA};
+
+    // Only the info transaction tells the slave how much data comes with the others
+    mock_slave_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = 0;
+    mock_slave_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = 0;
+    mock_slave_transaction_table[PUT_RPC_INFO].slave_callback                    = rpc_info_callback;
+    mock_slave_transaction_table[EXECUTE_RPC].slave_callback                     = rpc_exec_callback;
+
+    split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = 5;
+    split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = 3;
+    split_shmem->rpc_info.payload.m2s_length                                = 5;
+    split_shmem->rpc_info.payload.s2m_length                                = 3;
+    for (uint8_t i = 0; i < 5; i++) {
+        split_shmem->rpc_m2s_buffer[i] = 10 * i;
+    }
+
+    EXPECT_TRUE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+
+    EXPECT_EQ(split_shmem->rpc_s2m_buffer[0], 1);
+    EXPECT_EQ(split_shmem->rpc_s2m_buffer[1], 11);
+    EXPECT_EQ(split_shmem->rpc_s2m_buffer[2], 21);
+    EXPECT_EQ(split_shmem->rpc_s2m_buffer[3], 0);
+    EXPECT_EQ(mock_serial_stats().turnarounds, 1);
+}
+
+TEST_F(SplitSerialFramed, SizeMismatchFailsFrame) {
+    const uint8_t ids[] = {PUT_RPC_REQ_DATA, GET_SLAVE_MATRIX_DATA};
+
+    record_all_calls();
+    mock_slave_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size = 4;
+    set_slave_matrix(1);
+
+    EXPECT_FALSE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+    EXPECT_EQ(mock_serial_stats().slave_failures, 1);
+    EXPECT_EQ(split_shmem->smatrix.matrix[0], 0);
+}
+
+TEST_F(SplitSerialFramed, CorruptedRequestIsRejected) {
+    const uint8_t ids[] = {PUT_LAYER_STATE, GET_SLAVE_MATRIX_DATA};
+
+    record_all_calls();
+    split_shmem->layers.layer_state = 0x0F;
+    set_slave_matrix(1);
+
+    mock_serial_corrupt(MOCK_MASTER_TO_SLAVE, 6);
+    EXPECT_FALSE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+    EXPECT_TRUE(slave_calls.empty());
+    EXPECT_EQ(mock_slave_shmem.layers.layer_state, 0);
+    EXPECT_EQ(split_shmem->smatrix.matrix[0], 0);
+    EXPECT_EQ(mock_serial_stats().slave_failures, 1);
+
+    // The next frame starts clean
+    EXPECT_TRUE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+    EXPECT_EQ(mock_slave_shmem.layers.layer_state, 0x0F);
+    EXPECT_EQ(split_shmem->smatrix.matrix[0], 1);
+}
+
+TEST_F(SplitSerialFramed, CorruptedResponseIsRejected) {
+    const uint8_t ids[] = {GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA};
+
+    set_slave_matrix(1);
+
+    mock_serial_corrupt(MOCK_SLAVE_TO_MASTER, 4);
+    EXPECT_FALSE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+    EXPECT_EQ(split_shmem->smatrix.checksum, 0);
+    EXPECT_EQ(split_shmem->smatrix.matrix[0], 0);
+
+    EXPECT_TRUE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+    EXPECT_EQ(memcmp(&split_shmem->smatrix, &mock_slave_shmem.smatrix, sizeof(split_shmem->smatrix)), 0);
+}
+
+TEST_F(SplitSerialFramed, IllegalIdIsNotSent) {
+    const uint8_t ids[] = {GET_SLAVE_MATRIX_DATA, NUM_TOTAL_TRANSACTIONS};
+
+    EXPECT_FALSE(serial_protocol_framed_initiate(ids, sizeof(ids)));
+    EXPECT_EQ(mock_serial_stats().bytes, 0);
+}
+
+// Not a pass/fail check on host speed: a transactions_master() cycle where everything changed, as
+// transport.c batches it, against the link time of the old protocol for the same transactions. How
+// much is won depends mostly on MOCK_SERIAL_TURNAROUND_NS against the byte time of the link.
+TEST_F(SplitSerialFramed, CyclesPerSecond) {
+    const uint8_t  reads[]  = {GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA};
+    const uint8_t  writes[] = {PUT_SYNC_TIMER, PUT_LAYER_STATE, PUT_DEFAULT_LAYER_STATE, PUT_LED_STATE, PUT_MODS, PUT_WATCHDOG};
+    const unsigned cycles   = 10000;
+
+    mock_serial_stats_t legacy = {};
+    for (unsigned cycle = 0; cycle < cycles; cycle++) {
+        for (uint8_t id : reads) {
+            account_legacy_transaction(&legacy, id);
+        }
+        for (uint8_t id : writes) {
+            account_legacy_transaction(&legacy, id);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned cycle = 0; cycle < cycles; cycle++) {
+        set_slave_matrix(cycle);
+        split_shmem->sync_timer = cycle;
+        ASSERT_TRUE(serial_protocol_framed_initiate(reads, sizeof(reads)));
+        ASSERT_TRUE(serial_protocol_framed_initiate(writes, sizeof(writes)));
+    }
+    auto host_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    mock_serial_stats_t framed = mock_serial_stats();
+    EXPECT_EQ(framed.slave_failures, 0);
+    EXPECT_EQ(mock_slave_shmem.sync_timer, cycles - 1);
+    EXPECT_LT(framed.turnarounds * 4, legacy.turnarounds);
+    EXPECT_LT(framed.link_time_ns, legacy.link_time_ns);
+
+    RecordProperty("framed_cycles_per_second", static_cast<int>(1000000000ULL * cycles / framed.link_time_ns));
+    RecordProperty("legacy_cycles_per_second", static_cast<int>(1000000000ULL * cycles / legacy.link_time_ns));
+    RecordProperty("framed_bytes_per_cycle", static_cast<int>(framed.bytes / cycles));
+    RecordProperty("legacy_bytes_per_cycle", static_cast<int>(legacy.bytes / cycles));
+    RecordProperty("host_ns_per_cycle", static_cast<int>(host_ns / cycles));
+}
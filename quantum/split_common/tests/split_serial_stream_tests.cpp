@@ -0,0 +1,260 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#define _Static_assert static_assert
+
+extern "C" {
+#include "serial.h"
+#include "serial_protocol.h"
+}
+
+/* A loopback wire: what is sent comes back to the same half. The driver
+ * queues hold SERIAL_BUFFERS_SIZE bytes, raised in halconf.h for streaming,
+ * and the wire moves bytes from one to the other at the configured speed. */
+#define MOCK_QUEUE_SIZE 128
+
+namespace {
+
+std::deque<uint8_t> tx_queue;
+std::deque<uint8_t> rx_queue;
+uint64_t            now_ns         = 0;
+uint64_t            wire_budget_ns = 0;
+uint32_t            overflows      = 0;
+size_t              corrupt_after  = SIZE_MAX;
+
+void advance_us(uint32_t us) {
+    // One start and one stop bit
+    const uint64_t byte_ns = 10ULL * 1000000000 / SERIAL_USART_SPEED;
+
+    now_ns += us * 1000ULL;
+    wire_budget_ns += us * 1000ULL;
+    while (wire_budget_ns >= byte_ns && !tx_queue.empty()) {
+        uint8_t byte = tx_queue.front();
+        tx_queue.pop_front();
+        wire_budget_ns -= byte_ns;
+
+        if (corrupt_after == 0) {
+            byte ^= 0x10;
+        }
+        corrupt_after--;
+
+        if (rx_queue.size() < MOCK_QUEUE_SIZE) {
+            rx_queue.push_back(byte);
+        } else {
+            overflows++;
+        }
+    }
+    if (tx_queue.empty()) {
+        // An idle wire doesn't save up time
+        wire_budget_ns = 0;
+    }
+}
+
+// Flips a bit in the byte with this index, counted from the next one on the wire
+void corrupt_byte(size_t index) {
+    corrupt_after = index;
+}
+
+const uint8_t *receive(size_t *length) {
+    return soft_serial_stream_receive(length);
+}
+
+serial_stream_stats_t operator-(const serial_stream_stats_t &a, const serial_stream_stats_t &b) {
+    return {a.frames - b.frames, a.errors - b.errors, a.lost - b.lost};
+}
+
+} // namespace
+
+extern "C" size_t serial_transport_send_nonblocking(const uint8_t *source, const size_t size) {
+    size_t count = std::min(size, MOCK_QUEUE_SIZE - tx_queue.size());
+    tx_queue.insert(tx_queue.end(), source, source + count);
+    return count;
+}
+
+extern "C" size_t serial_transport_receive_nonblocking(uint8_t *destination, const size_t size) {
+    size_t count = std::min(size, rx_queue.size());
+    std::copy_n(rx_queue.begin(), count, destination);
+    rx_queue.erase(rx_queue.begin(), rx_queue.begin() + count);
+    return count;
+}
+
+class SplitSerialStream : public ::testing::Test {
+   protected:
+    serial_stream_stats_t start;
+
+    void SetUp() override {
+        // The driver state carries over between tests, so finish what an earlier one left on the wire
+        const uint8_t none = 0;
+        do {
+            advance_us(1000);
+        } while (!soft_serial_stream_send(&none, 0));
+        advance_us(10000);
+        size_t length;
+        while (receive(&length)) {
+        }
+
+        corrupt_after = SIZE_MAX;
+        overflows     = 0;
+        start         = soft_serial_stream_stats();
+    }
+
+    serial_stream_stats_t stats() {
+        return soft_serial_stream_stats() - start;
+    }
+};
+
+TEST_F(SplitSerialStream, FrameArrivesInPieces) {
+    std::vector<uint8_t> payload(40);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = i * 3;
+    }
+
+    EXPECT_TRUE(soft_serial_stream_send(payload.data(), payload.size()));
+
+    size_t         length = 0;
+    const uint8_t *data   = nullptr;
+    int            polls  = 0;
+    while (!data && polls < 100) {
+        // A few bytes at a time
+        advance_us(100);
+        data = receive(&length);
+        polls++;
+    }
+
+    ASSERT_NE(data, nullptr);
+    EXPECT_GT(polls, 1);
+    EXPECT_EQ(std::vector<uint8_t>(data, data + length), payload);
+    EXPECT_EQ(receive(&length), nullptr);
+    EXPECT_EQ(stats().frames, 1);
+}
+
+TEST_F(SplitSerialStream, NewestFrameWins) {
+    const uint8_t first[]  = {1, 2, 3};
+    const uint8_t second[] = {4, 5, 6, 7};
+
+    EXPECT_TRUE(soft_serial_stream_send(first, sizeof(first)));
+    advance_us(5000);
+    EXPECT_TRUE(soft_serial_stream_send(second, sizeof(second)));
+    advance_us(5000);
+
+    size_t         length;
+    const uint8_t *data = receive(&length);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(data, data + length), std::vector<uint8_t>(second, second + sizeof(second)));
+
+    serial_stream_stats_t diff = stats();
+    EXPECT_EQ(diff.frames, 2);
+    EXPECT_EQ(diff.errors, 0);
+    EXPECT_EQ(diff.lost, 0);
+}
+
+TEST_F(SplitSerialStream, ResyncsAfterCorruption) {
+    const uint8_t first[]  = {0xA5, 0xA5, 0xA5, 0xA5};
+    const uint8_t second[] = {0x11, 0x22};
+    size_t        length;
+
+    // A payload byte, the frame is dropped at its crc
+    corrupt_byte(6);
+    EXPECT_TRUE(soft_serial_stream_send(first, sizeof(first)));
+    advance_us(5000);
+    EXPECT_EQ(receive(&length), nullptr);
+
+    EXPECT_TRUE(soft_serial_stream_send(second, sizeof(second)));
+    advance_us(5000);
+    const uint8_t *data = receive(&length);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(data, data + length), std::vector<uint8_t>(second, second + sizeof(second)));
+
+    serial_stream_stats_t diff = stats();
+    EXPECT_EQ(diff.frames, 1);
+    EXPECT_EQ(diff.errors, 1);
+    EXPECT_EQ(diff.lost, 1);
+}
+
+TEST_F(SplitSerialStream, RejectsOversizedLength) {
+    const uint8_t payload[] = {1};
+    size_t        length;
+
+    // The high byte of the length
+    corrupt_byte(3);
+    EXPECT_TRUE(soft_serial_stream_send(payload, sizeof(payload)));
+    advance_us(5000);
+    EXPECT_EQ(receive(&length), nullptr);
+
+    EXPECT_TRUE(soft_serial_stream_send(payload, sizeof(payload)));
+    advance_us(5000);
+    EXPECT_NE(receive(&length), nullptr);
+    EXPECT_EQ(stats().errors, 1);
+}
+
+TEST_F(SplitSerialStream, SendNeverWaitsForTheWire) {
+    std::vector<uint8_t> large(SERIAL_STREAM_BUFFER_SIZE, 0x42);
+    const uint8_t        small[] = {9};
+    size_t               length;
+    uint32_t             received = 0;
+
+    EXPECT_TRUE(soft_serial_stream_send(large.data(), large.size()));
+    EXPECT_EQ(tx_queue.size(), MOCK_QUEUE_SIZE);
+
+    // Still busy with the large frame, so the snapshot isn't taken, only more of the frame is queued
+    int calls = 0;
+    do {
+        advance_us(1000);
+        received += receive(&length) != nullptr;
+        calls++;
+    } while (!soft_serial_stream_send(small, sizeof(small)));
+    EXPECT_GT(calls, 2);
+    EXPECT_EQ(received, 0);
+    EXPECT_FALSE(soft_serial_stream_send(large.data(), SERIAL_STREAM_BUFFER_SIZE + 1));
+
+    advance_us(5000);
+    const uint8_t *data = receive(&length);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(length, sizeof(small));
+    EXPECT_EQ(stats().frames, 2);
+    EXPECT_EQ(overflows, 0);
+}
+
+TEST_F(SplitSerialStream, UpdateRate) {
+    // A scan loop at 1kHz that sends a 16 byte snapshot and polls every 100us
+    const uint32_t scans = 1000;
+    uint8_t        payload[16];
+    uint64_t       latency_total = 0;
+    uint64_t       latency_max   = 0;
+    uint32_t       delivered     = 0;
+
+    for (uint32_t scan = 0; scan < scans; scan++) {
+        memcpy(payload, &now_ns, sizeof(now_ns));
+        soft_serial_stream_send(payload, sizeof(payload));
+
+        for (int i = 0; i < 10; i++) {
+            advance_us(100);
+            size_t         length;
+            const uint8_t *data = receive(&length);
+            if (data) {
+                uint64_t sent;
+                memcpy(&sent, data, sizeof(sent));
+                latency_total += now_ns - sent;
+                latency_max = std::max(latency_max, now_ns - sent);
+                delivered++;
+            }
+        }
+    }
+
+    serial_stream_stats_t diff = stats();
+    EXPECT_EQ(diff.errors, 0);
+    EXPECT_EQ(diff.lost, 0);
+    EXPECT_EQ(overflows, 0);
+    EXPECT_GE(delivered, scans * 99 / 100);
+    EXPECT_LE(latency_max, 2000000);
+
+    RecordProperty("updates_per_second", static_cast<int>(delivered * 1000 / scans));
+    RecordProperty("mean_latency_us", static_cast<int>(latency_total / delivered / 1000));
+    RecordProperty("max_latency_us", static_cast<int>(latency_max / 1000));
+}
@@ -0,0 +1,3 @@
+TEST_LIST += \
+	split_serial_framed \
+	split_serial_stream
@@ -24,12 +24,14 @@
 #include "host.h"
 #include "action_util.h"
 #include "sync_timer.h"
+#include "util.h"
 #include "wait.h"
 #include "transactions.h"
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "split_util.h"
 #include "synchronization_util.h"
+#include "state_change.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -145,6 +147,17 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     } while (0)
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+#if !defined(USE_I2C) && defined(SERIAL_PROTOCOL_FRAMED)
+    // Another turnaround costs more than the data, so always fetch both in one frame
+    const int8_t ids[] = {trans_id_checksum, trans_id_retrieve};
+    bool         okay  = transport_execute_transactions(ids, ARRAY_SIZE(ids));
+    okay &= *(uint8_t *)split_trans_target2initiator_buffer(&split_transaction_table[trans_id_checksum]) == crc8(equiv_shmem, length);
+    if (okay) {
+        *last_update = timer_read32();
+        memcpy(destination, equiv_shmem, length);
+    }
+    return okay;
+#else
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
@@ -157,6 +170,7 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
         memcpy(destination, equiv_shmem, length);
     }
     return okay;
+#endif
 }
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
@@ -175,6 +189,16 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+inline static bool __attribute__((unused)) send_if_state_changed(int8_t trans_id, uint32_t *last_update, state_topic_t topic, uint16_t *last_version, void *source, const void *equiv_shmem, size_t length) {
+    // The state is only compared once its version moved, and changes that were undone since the last send aren't sent
+    uint16_t version = state_version(topic);
+    bool     okay    = send_if_condition(trans_id, last_update, version != *last_version && memcmp(source, equiv_shmem, length) != 0, source, length);
+    if (okay) {
+        *last_version = version;
+    }
+    return okay;
+}
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
@@ -243,6 +267,15 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
     static uint8_t   last_checksum = 0;
     encoder_events_t temp_events;
 
+#    if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+    // The drain completes on a later pass, until then the slave still sends the events that were already queued
+    static bool drain_pending = false;
+    if (drain_pending) {
+        drain_pending = !transport_exec(CMD_ENCODER_DRAIN);
+        return true;
+    }
+#    endif
+
     bool okay = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, &temp_events, &split_shmem->encoders.events, sizeof(temp_events));
     if (okay) {
         if (last_checksum != split_shmem->encoders.checksum) {
@@ -255,7 +288,11 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
             }
 
             if (actioned) {
+#    if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+                drain_pending = !transport_exec(CMD_ENCODER_DRAIN);
+#    else
                 okay &= transport_exec(CMD_ENCODER_DRAIN);
+#    endif
             }
             last_checksum = split_shmem->encoders.checksum;
         }
@@ -336,19 +373,27 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 #if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 
 static bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_layer_state_update         = 0;
-    static uint32_t last_default_layer_state_update = 0;
+    static uint32_t last_layer_state_update          = 0;
+    static uint32_t last_default_layer_state_update  = 0;
+    static uint16_t last_layer_state_version         = 0;
+    static uint16_t last_default_layer_state_version = 0;
 
-    bool okay = send_if_condition(PUT_LAYER_STATE, &last_layer_state_update, (layer_state != split_shmem->layers.layer_state), &layer_state, sizeof(layer_state));
+    bool okay = send_if_state_changed(PUT_LAYER_STATE, &last_layer_state_update, STATE_LAYER, &last_layer_state_version, &layer_state, &split_shmem->layers.layer_state, sizeof(layer_state));
     if (okay) {
-        okay &= send_if_condition(PUT_DEFAULT_LAYER_STATE, &last_default_layer_state_update, (default_layer_state != split_shmem->layers.default_layer_state), &default_layer_state, sizeof(default_layer_state));
+        okay &= send_if_state_changed(PUT_DEFAULT_LAYER_STATE, &last_default_layer_state_update, STATE_DEFAULT_LAYER, &last_default_layer_state_version, &default_layer_state, &split_shmem->layers.default_layer_state, sizeof(default_layer_state));
     }
     return okay;
 }
 
 static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    layer_state         = split_shmem->layers.layer_state;
-    default_layer_state = split_shmem->layers.default_layer_state;
+    if (layer_state != split_shmem->layers.layer_state) {
+        layer_state = split_shmem->layers.layer_state;
+        state_publish(STATE_LAYER);
+    }
+    if (default_layer_state != split_shmem->layers.default_layer_state) {
+        default_layer_state = split_shmem->layers.default_layer_state;
+        state_publish(STATE_DEFAULT_LAYER);
+    }
 }
 
 // clang-format off
@@ -373,9 +418,10 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 #ifdef SPLIT_LED_STATE_ENABLE
 
 static bool led_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_update = 0;
-    uint8_t         led_state   = host_keyboard_leds();
-    return send_if_data_mismatch(PUT_LED_STATE, &last_update, &led_state, &split_shmem->led_state, sizeof(led_state));
+    static uint32_t last_update  = 0;
+    static uint16_t last_version = 0;
+    uint8_t         led_state    = host_keyboard_leds();
+    return send_if_state_changed(PUT_LED_STATE, &last_update, STATE_HOST_LEDS, &last_version, &led_state, &split_shmem->led_state, sizeof(led_state));
 }
 
 static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -401,39 +447,18 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 #ifdef SPLIT_MODS_ENABLE
 
 static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t   last_update    = 0;
-    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
+    static uint32_t   last_update  = 0;
+    static uint16_t   last_version = 0;
     split_mods_sync_t new_mods;
     new_mods.real_mods = get_mods();
-    if (!mods_need_sync && new_mods.real_mods != split_shmem->mods.real_mods) {
-        mods_need_sync = true;
-    }
-
     new_mods.weak_mods = get_weak_mods();
-    if (!mods_need_sync && new_mods.weak_mods != split_shmem->mods.weak_mods) {
-        mods_need_sync = true;
-    }
-
 #    ifndef NO_ACTION_ONESHOT
-    new_mods.oneshot_mods = get_oneshot_mods();
-    if (!mods_need_sync && new_mods.oneshot_mods != split_shmem->mods.oneshot_mods) {
-        mods_need_sync = true;
-    }
+    new_mods.oneshot_mods        = get_oneshot_mods();
     new_mods.oneshot_locked_mods = get_oneshot_locked_mods();
-    if (!mods_need_sync && new_mods.oneshot_locked_mods != split_shmem->mods.oneshot_locked_mods) {
-        mods_need_sync = true;
-    }
 #    endif // NO_ACTION_ONESHOT
 
-    bool okay = true;
-    if (mods_need_sync) {
-        okay &= transport_write(PUT_MODS, &new_mods, sizeof(new_mods));
-        if (okay) {
-            last_update = timer_read32();
-        }
-    }
-
-    return okay;
+    // Weak mods come and go within a single report, so the version alone moves far more often than the mods do
+    return send_if_state_changed(PUT_MODS, &last_update, STATE_MODS, &last_version, &new_mods, &split_shmem->mods, sizeof(new_mods));
 }
 
 static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -947,7 +972,12 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#    if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+    // The stream always carries whole buffers, so the slave doesn't need the sizes before the data
+    [PUT_RPC_INFO]      = trans_initiator2target_initializer(rpc_info),
+#    else
         [PUT_RPC_INFO]  = trans_initiator2target_initializer_cb(rpc_info, slave_rpc_info_callback),
+#    endif
     [PUT_RPC_REQ_DATA]  = trans_initiator2target_initializer(rpc_m2s_buffer),
     [EXECUTE_RPC]       = trans_initiator2target_initializer_cb(rpc_info.payload.transaction_id, slave_rpc_exec_callback),
     [GET_RPC_RESP_DATA] = trans_target2initiator_initializer(rpc_s2m_buffer),
@@ -1026,6 +1056,20 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     rpc_sync_info_t info = {.payload = {.transaction_id = transaction_id, .m2s_length = initiator2target_buffer_size, .s2m_length = target2initiator_buffer_size}};
     info.checksum        = crc8(&info.payload, sizeof(info.payload));
 
+#    if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+    // The slave runs the request on a later pass, the same call has to be made again to collect the response
+    static bool    rpc_pending = false;
+    static uint8_t rpc_request = 0;
+    uint8_t        request     = info.checksum ^ crc8(initiator2target_buffer, initiator2target_buffer_size);
+    if (rpc_pending && request != rpc_request) {
+        // Let the earlier request finish, so that its response isn't taken for this one
+        if (!transport_exec(EXECUTE_RPC)) {
+            return false;
+        }
+        rpc_pending = false;
+    }
+#    endif
+
     // Make sure the local side knows that we're not sending the full block of data
     split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = initiator2target_buffer_size;
     split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = target2initiator_buffer_size;
@@ -1042,8 +1086,15 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
         return false;
     }
     if (!transport_write(EXECUTE_RPC, &transaction_id, sizeof(transaction_id))) {
+#    if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+        rpc_pending = true;
+        rpc_request = request;
+#    endif
         return false;
     }
+#    if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+    rpc_pending = false;
+#    endif
     if (!transport_read(GET_RPC_RESP_DATA, target2initiator_buffer, target2initiator_buffer_size)) {
         return false;
     }
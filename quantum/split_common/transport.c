@@ -86,13 +86,281 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#elif defined(SERIAL_USART_STREAMING) // USE_I2C
+
+#    include "serial.h"
+#    include "timer.h"
+#    include "util.h"
+#    include "synchronization_util.h"
+
+#    if defined(SERIAL_PROTOCOL_FRAMED)
+#        error "SERIAL_USART_STREAMING and SERIAL_PROTOCOL_FRAMED can't be used together"
+#    endif
+
+// Room for the shared memory and the header of either snapshot
+_Static_assert(sizeof(split_shared_memory_t) + 2 <= SERIAL_STREAM_BUFFER_SIZE, "split_shared_memory_t too large for SERIAL_STREAM_BUFFER_SIZE");
+
+static split_shared_memory_t shared_memory;
+split_shared_memory_t *const split_shmem = &shared_memory;
+
+/* Both halves stream snapshots of the parts of the shared memory they write:
+ * the master its initiator2target buffers, the slave its target2initiator
+ * buffers. Reads and writes only touch the shared memory, so they never wait.
+ *
+ * Transactions with a slave callback are commands: the master snapshot
+ * carries a sequence number and the id of the last one, the slave runs the
+ * callback once the sequence number changes and echoes it back in its own
+ * snapshot. The master doesn't wait for that echo. A command reports false
+ * until it arrived, and its caller makes it again on a later pass, after
+ * which a read sees what the callback did. Only one command is on its way at
+ * a time. */
+
+typedef struct {
+    uint16_t offset;
+    uint16_t size;
+} stream_region_t;
+
+#    define MASTER_HEADER_SIZE 2
+#    define SLAVE_HEADER_SIZE 1
+#    define NO_COMMAND 0xFF
+
+// Taken from the transaction table at startup, before RPC resizes its buffers
+static stream_region_t initiator_regions[NUM_TOTAL_TRANSACTIONS];
+static stream_region_t target_regions[NUM_TOTAL_TRANSACTIONS];
+static uint8_t         initiator_region_count = 0;
+static uint8_t         target_region_count    = 0;
+
+static uint8_t  snapshot[SERIAL_STREAM_BUFFER_SIZE];
+static uint8_t  command_sequence = 0;
+static uint8_t  command_id       = NO_COMMAND;
+static uint8_t  command_echo     = 0;
+static uint8_t  commands_done[(NUM_TOTAL_TRANSACTIONS + 7) / 8];
+static bool     command_synced   = false;
+static bool     received         = false;
+static uint32_t last_received    = 0;
+
+/**
+ * @brief Adds a buffer to the sorted regions, merging it with any it overlaps or touches.
+ *
+ * @return uint8_t The new number of regions.
+ */
+static uint8_t add_region(stream_region_t *regions, uint8_t count, uint16_t offset, uint16_t size) {
+    if (size == 0) {
+        return count;
+    }
+
+    uint8_t i = count++;
+    for (; i > 0 && regions[i - 1].offset > offset; i--) {
+        regions[i] = regions[i - 1];
+    }
+    regions[i] = (stream_region_t){offset, size};
+
+    uint8_t merged = 0;
+    for (uint8_t j = 1; j < count; j++) {
+        stream_region_t *last = &regions[merged];
+        if (regions[j].offset <= last->offset + last->size) {
+            last->size = MAX(last->offset + last->size, regions[j].offset + regions[j].size) - last->offset;
+        } else {
+            regions[++merged] = regions[j];
+        }
+    }
+    return merged + 1;
+}
+
+static void stream_layout_init(void) {
+    for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        initiator_region_count          = add_region(initiator_regions, initiator_region_count, trans->initiator2target_offset, trans->initiator2target_buffer_size);
+        target_region_count             = add_region(target_regions, target_region_count, trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    }
+}
+
+static size_t pack_regions(const stream_region_t *regions, uint8_t count, uint8_t *destination) {
+    size_t length = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        memcpy(&destination[length], split_shmem_offset_ptr(regions[i].offset), regions[i].size);
+        length += regions[i].size;
+    }
+    return length;
+}
+
+static size_t unpack_regions(const stream_region_t *regions, uint8_t count, const uint8_t *source) {
+    size_t length = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        memcpy(split_shmem_offset_ptr(regions[i].offset), &source[length], regions[i].size);
+        length += regions[i].size;
+    }
+    return length;
+}
+
+static size_t regions_size(const stream_region_t *regions, uint8_t count) {
+    size_t length = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        length += regions[i].size;
+    }
+    return length;
+}
+
+static void stream_send(bool is_master) {
+    split_shared_memory_lock_autounlock();
+
+    size_t length;
+    if (is_master) {
+        snapshot[0] = command_sequence;
+        snapshot[1] = command_id;
+        length      = MASTER_HEADER_SIZE + pack_regions(initiator_regions, initiator_region_count, &snapshot[MASTER_HEADER_SIZE]);
+    } else {
+        snapshot[0] = command_sequence;
+        length      = SLAVE_HEADER_SIZE + pack_regions(target_regions, target_region_count, &snapshot[SLAVE_HEADER_SIZE]);
+    }
+    soft_serial_stream_send(snapshot, length);
+}
+
+static void stream_receive(bool is_master) {
+    size_t         length;
+    const uint8_t *payload = soft_serial_stream_receive(&length);
+    if (!payload) {
+        return;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    if (is_master) {
+        // A half built with different features sends something else
+        if (length != SLAVE_HEADER_SIZE + regions_size(target_regions, target_region_count)) {
+            return;
+        }
+        unpack_regions(target_regions, target_region_count, &payload[SLAVE_HEADER_SIZE]);
+        command_echo = payload[0];
+        if (command_id != NO_COMMAND && command_echo == command_sequence) {
+            // Kept until the caller makes the command again
+            commands_done[command_id / 8] |= (1 << (command_id % 8));
+            command_id = NO_COMMAND;
+        }
+    } else {
+        if (length != MASTER_HEADER_SIZE + regions_size(initiator_regions, initiator_region_count)) {
+            return;
+        }
+        unpack_regions(initiator_regions, initiator_region_count, &payload[MASTER_HEADER_SIZE]);
+
+        // The master only sends the id while it waits, so a command from before this half came up isn't repeated
+        if ((!command_synced || payload[0] != command_sequence) && payload[1] < NUM_TOTAL_TRANSACTIONS) {
+            split_transaction_desc_t *trans = &split_transaction_table[payload[1]];
+            if (trans->slave_callback) {
+                trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+            }
+        }
+        command_sequence = payload[0];
+        command_synced   = true;
+    }
+
+    received      = true;
+    last_received = timer_read32();
+}
+
+static bool stream_connected(void) {
+    return received && timer_elapsed32(last_received) < SERIAL_STREAM_TIMEOUT;
+}
+
+/**
+ * @brief Sends a command, or checks on the one sent before.
+ *
+ * @return true once the slave ran it, false while it is pending.
+ */
+static bool stream_command(int8_t id) {
+    if (commands_done[id / 8] & (1 << (id % 8))) {
+        commands_done[id / 8] &= ~(1 << (id % 8));
+        return true;
+    }
+
+    if (command_id == NO_COMMAND) {
+        command_id = id;
+        command_sequence++;
+        // Don't wait for the end of the scan to get it on its way
+        stream_send(true);
+    }
+    return false;
+}
+
+void transport_master_init(void) {
+    stream_layout_init();
+    soft_serial_initiator_init();
+}
+
+void transport_slave_init(void) {
+    stream_layout_init();
+    soft_serial_target_init();
+}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    // Writes go out with the next snapshot, commands are pending until the slave ran them
+    if (trans->slave_callback && !stream_command(id)) {
+        return false;
+    }
+
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return stream_connected();
+}
+
 #else // USE_I2C
 
 #    include "serial.h"
 
+#    if defined(SERIAL_PROTOCOL_FRAMED) && defined(SERIAL_DRIVER_BITBANG)
+#        error "SERIAL_PROTOCOL_FRAMED is not supported by the bitbang serial driver"
+#    endif
+
 static split_shared_memory_t shared_memory;
 split_shared_memory_t *const split_shmem = &shared_memory;
 
+#    ifdef SERIAL_PROTOCOL_FRAMED
+// Write only transactions of a transport_master() cycle are held back, and go out in the same frame as the
+// next transaction that reads something, or at the end of the cycle. A read can't be held back, its handler
+// uses the answer in the same scan, so a cycle still costs one round trip per read plus one for the last writes.
+static uint8_t pending_transactions[NUM_TOTAL_TRANSACTIONS];
+static uint8_t pending_count = 0;
+static bool    batching      = false;
+
+static void add_pending_transaction(int8_t id) {
+    for (uint8_t i = 0; i < pending_count; i++) {
+        if (pending_transactions[i] == id) {
+            // Sent with the latest buffer contents anyway
+            return;
+        }
+    }
+    pending_transactions[pending_count++] = id;
+}
+
+static bool flush_pending_transactions(void) {
+    if (pending_count == 0) {
+        return true;
+    }
+    // Kept on failure, so that the retry of a handler sends them again
+    if (!soft_serial_transactions(pending_transactions, pending_count)) {
+        return false;
+    }
+    pending_count = 0;
+    return true;
+}
+
+bool transport_execute_transactions(const int8_t *ids, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        add_pending_transaction(ids[i]);
+    }
+    return flush_pending_transactions();
+}
+#    endif // SERIAL_PROTOCOL_FRAMED
+
 void transport_master_init(void) {
     soft_serial_initiator_init();
 }
@@ -107,9 +375,19 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
     }
 
+#    ifdef SERIAL_PROTOCOL_FRAMED
+    add_pending_transaction(id);
+    if (batching && trans->target2initiator_buffer_size == 0) {
+        return true;
+    }
+    if (!flush_pending_transactions()) {
+        return false;
+    }
+#    else
     if (!soft_serial_transaction(id)) {
         return false;
     }
+#    endif // SERIAL_PROTOCOL_FRAMED
 
     if (target2initiator_length > 0) {
         size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
@@ -122,9 +400,28 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+    // Apply the newest slave snapshot, run the handlers on it and send ours, nothing waits for the link
+    stream_receive(true);
+    bool okay = transactions_master(master_matrix, slave_matrix);
+    stream_send(true);
+    return okay;
+#elif !defined(USE_I2C) && defined(SERIAL_PROTOCOL_FRAMED)
+    batching  = true;
+    bool okay = transactions_master(master_matrix, slave_matrix);
+    batching  = false;
+    return okay && flush_pending_transactions();
+#else
     return transactions_master(master_matrix, slave_matrix);
+#endif
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#if !defined(USE_I2C) && defined(SERIAL_USART_STREAMING)
+    stream_receive(false);
+    transactions_slave(master_matrix, slave_matrix);
+    stream_send(false);
+#else
     transactions_slave(master_matrix, slave_matrix);
+#endif
 }
@@ -40,6 +40,11 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#if !defined(USE_I2C) && defined(SERIAL_PROTOCOL_FRAMED)
+// Runs several transactions in one frame, directly on the shared memory buffers
+bool transport_execute_transactions(const int8_t *ids, uint8_t count);
+#endif
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -0,0 +1,28 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "state_change.h"
+
+static uint16_t state_versions[STATE_COUNT] = {[0 ... STATE_COUNT - 1] = 1};
+
+void state_publish(state_topic_t topic) {
+    // Skip 0 when wrapping, it's what a fresh snapshot holds
+    if (++state_versions[topic] == 0) {
+        state_versions[topic] = 1;
+    }
+}
+
+uint16_t state_version(state_topic_t topic) {
+    return state_versions[topic];
+}
+
+state_mask_t state_changes(state_snapshot_t *snapshot, state_mask_t topics) {
+    state_mask_t changes = 0;
+    for (uint8_t topic = 0; topic < STATE_COUNT; topic++) {
+        if ((topics & STATE_BIT(topic)) && snapshot->versions[topic] != state_versions[topic]) {
+            snapshot->versions[topic] = state_versions[topic];
+            changes |= STATE_BIT(topic);
+        }
+    }
+    return changes;
+}
@@ -0,0 +1,75 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup state_change State change publication
+ *
+ * Every piece of keyboard state below has a version counter, bumped by the
+ * code that owns the state whenever its value actually changes. Consumers
+ * (split sync, lighting, displays, ...) keep a snapshot of the versions
+ * they last acted on, and compare it against the counters instead of
+ * polling and comparing the state itself every loop.
+ *
+ * Counters are only bumped from the main loop, and only by the setters:
+ * assigning `layer_state` or `default_layer_state` directly isn't published.
+ * \{
+ */
+
+typedef enum {
+    STATE_LAYER,
+    STATE_DEFAULT_LAYER,
+    STATE_MODS, // Real, weak, oneshot and locked oneshot mods
+    STATE_HOST_LEDS,
+    STATE_CAPS_WORD,
+    STATE_DETECTED_OS,
+    STATE_COUNT,
+} state_topic_t;
+
+/** \brief A set of topics, one bit each */
+typedef uint8_t state_mask_t;
+
+#define STATE_BIT(topic) ((state_mask_t)1 << (topic))
+#define STATE_ALL ((state_mask_t)(STATE_BIT(STATE_COUNT) - 1))
+
+_Static_assert(STATE_COUNT <= 8 * sizeof(state_mask_t), "state_mask_t is too small for the state topics");
+
+/**
+ * \brief The versions a consumer last saw.
+ *
+ * Versions start at 1, so a zero initialised snapshot sees every topic as
+ * changed on the first check.
+ */
+typedef struct {
+    uint16_t versions[STATE_COUNT];
+} state_snapshot_t;
+
+/**
+ * \brief Publishes a change of the topic, to be called by its owner after
+ * updating the state.
+ */
+void state_publish(state_topic_t topic);
+
+/**
+ * \brief The current version of the topic.
+ */
+uint16_t state_version(state_topic_t topic);
+
+/**
+ * \brief Which of the topics changed since the snapshot was last updated,
+ * and updates it.
+ *
+ * \param snapshot the consumer's snapshot
+ * \param topics the topics the consumer is interested in, e.g.
+ * `STATE_BIT(STATE_LAYER) | STATE_BIT(STATE_HOST_LEDS)`. The versions of
+ * the other topics in the snapshot are left alone.
+ * \return the changed topics, 0 if none
+ */
+state_mask_t state_changes(state_snapshot_t *snapshot, state_mask_t topics);
+
+/** \} */
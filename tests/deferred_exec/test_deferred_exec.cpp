@@ -0,0 +1,201 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+struct Execution {
+    uint32_t trigger_time;
+    uint32_t time;
+
+    bool operator==(const Execution &other) const {
+        return trigger_time == other.trigger_time && time == other.time;
+    }
+};
+
+struct Executor {
+    uint32_t               delay;
+    uint32_t               period;
+    std::vector<Execution> executions;
+};
+
+// The previous implementation: every slot of the table is checked on every pass, due ones run in slot order
+class LinearReference {
+   public:
+    void add(Executor *executor) {
+        slots.push_back({timer_read32() + executor->delay, executor});
+    }
+
+    void task() {
+        uint32_t now = timer_read32();
+        if (((int32_t)TIMER_DIFF_32(now, last_execution_time)) <= 0) {
+            return;
+        }
+        last_execution_time = now;
+        for (auto &slot : slots) {
+            if (slot.executor && ((int32_t)TIMER_DIFF_32(slot.trigger_time, now)) <= 0) {
+                slot.executor->executions.push_back({slot.trigger_time, now});
+                if (slot.executor->period) {
+                    slot.trigger_time += slot.executor->period;
+                } else {
+                    slot.executor = nullptr;
+                }
+            }
+        }
+    }
+
+   private:
+    struct Slot {
+        uint32_t  trigger_time;
+        Executor *executor;
+    };
+    std::vector<Slot> slots;
+    uint32_t          last_execution_time = 0;
+};
+
+std::vector<Execution> pass;
+
+uint32_t record_execution(uint32_t trigger_time, void *cb_arg) {
+    auto *executor = static_cast<Executor *>(cb_arg);
+    executor->executions.push_back({trigger_time, timer_read32()});
+    pass.push_back({trigger_time, timer_read32()});
+    return executor->period;
+}
+
+} // namespace
+
+class DeferredExec : public TestFixture {};
+
+TEST_F(DeferredExec, MatchesLinearReference) {
+    const size_t          executor_count        = 24;
+    deferred_executor_t   table[executor_count] = {};
+    uint32_t              last_execution_time   = 0;
+    std::vector<Executor> heap_executors, reference_executors;
+    LinearReference       reference;
+    std::mt19937          rng(1234);
+
+    for (size_t i = 0; i < executor_count; ++i) {
+        // Some one-shot, some repeating, with plenty of equal trigger times
+        Executor executor = {1 + rng() % 40, (i % 4 == 0) ? 0 : 1 + (uint32_t)(rng() % 25), {}};
+        heap_executors.push_back(executor);
+        reference_executors.push_back(executor);
+    }
+    for (size_t i = 0; i < executor_count; ++i) {
+        ASSERT_NE(defer_exec_advanced(table, executor_count, heap_executors[i].delay, record_execution, &heap_executors[i]), INVALID_DEFERRED_TOKEN);
+        reference.add(&reference_executors[i]);
+    }
+
+    for (uint32_t ms = 0; ms < 2000; ++ms) {
+        // Now and then the main loop stalls, and everything late has to catch up
+        advance_time((ms % 300 == 299) ? 60 : 1);
+
+        pass.clear();
+        deferred_exec_advanced_task(table, executor_count, &last_execution_time);
+        reference.task();
+
+        for (size_t i = 1; i < pass.size(); ++i) {
+            EXPECT_LE(pass[i - 1].trigger_time, pass[i].trigger_time) << "executors ran out of trigger order";
+        }
+    }
+
+    for (size_t i = 0; i < executor_count; ++i) {
+        EXPECT_EQ(heap_executors[i].executions, reference_executors[i].executions) << "executor " << i << " ran with a different schedule";
+    }
+}
+
+TEST_F(DeferredExec, IdleTaskRunsNothing) {
+    deferred_executor_t table[4]            = {};
+    uint32_t            last_execution_time = 0;
+    Executor            executor            = {100, 0, {}};
+
+    ASSERT_NE(defer_exec_advanced(table, 4, executor.delay, record_execution, &executor), INVALID_DEFERRED_TOKEN);
+    for (int i = 0; i < 99; ++i) {
+        advance_time(1);
+        deferred_exec_advanced_task(table, 4, &last_execution_time);
+    }
+    EXPECT_TRUE(executor.executions.empty());
+
+    advance_time(1);
+    deferred_exec_advanced_task(table, 4, &last_execution_time);
+    ASSERT_EQ(executor.executions.size(), 1);
+    EXPECT_EQ(executor.executions[0].trigger_time, executor.executions[0].time);
+}
+
+TEST_F(DeferredExec, ExtendAndCancel) {
+    deferred_executor_t table[4]            = {};
+    uint32_t            last_execution_time = 0;
+    Executor            early = {10, 0, {}}, late = {20, 0, {}}, cancelled = {15, 0, {}};
+
+    deferred_token early_token     = defer_exec_advanced(table, 4, early.delay, record_execution, &early);
+    deferred_token late_token      = defer_exec_advanced(table, 4, late.delay, record_execution, &late);
+    deferred_token cancelled_token = defer_exec_advanced(table, 4, cancelled.delay, record_execution, &cancelled);
+
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, 4, early_token, 30));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, 4, cancelled_token));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, 4, cancelled_token));
+
+    pass.clear();
+    for (int i = 0; i < 40; ++i) {
+        advance_time(1);
+        deferred_exec_advanced_task(table, 4, &last_execution_time);
+    }
+
+    ASSERT_EQ(pass.size(), 2);
+    EXPECT_EQ(pass[0].trigger_time, 20);
+    EXPECT_EQ(pass[1].trigger_time, 30);
+    EXPECT_TRUE(cancelled.executions.empty());
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, 4, late_token));
+}
+
+TEST_F(DeferredExec, TableFull) {
+    deferred_executor_t table[2] = {};
+    Executor            executor = {10, 0, {}};
+
+    EXPECT_NE(defer_exec_advanced(table, 2, 10, record_execution, &executor), INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(defer_exec_advanced(table, 2, 10, record_execution, &executor), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec_advanced(table, 2, 10, record_execution, &executor), INVALID_DEFERRED_TOKEN);
+}
+
+namespace {
+
+deferred_executor_t requeue_table[4];
+deferred_token      requeued_token;
+Executor            requeued = {5, 0, {}};
+
+uint32_t cancel_and_requeue(uint32_t trigger_time, void *cb_arg) {
+    deferred_token *token = static_cast<deferred_token *>(cb_arg);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(requeue_table, 4, *token));
+    requeued_token = defer_exec_advanced(requeue_table, 4, requeued.delay, record_execution, &requeued);
+    // Ignored, the executor was cancelled
+    return 10;
+}
+
+} // namespace
+
+TEST_F(DeferredExec, CallbackCancelsItselfAndRequeues) {
+    uint32_t       last_execution_time = 0;
+    deferred_token token;
+
+    memset(requeue_table, 0, sizeof(requeue_table));
+    token = defer_exec_advanced(requeue_table, 4, 10, cancel_and_requeue, &token);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    for (int i = 0; i < 30; ++i) {
+        advance_time(1);
+        deferred_exec_advanced_task(requeue_table, 4, &last_execution_time);
+    }
+
+    ASSERT_EQ(requeued.executions.size(), 1);
+    EXPECT_EQ(requeued.executions[0].trigger_time, 15);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(requeue_table, 4, token));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(requeue_table, 4, requeued_token));
+}
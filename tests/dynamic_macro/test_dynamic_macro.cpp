@@ -0,0 +1,139 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   protected:
+    KeymapKey key_rec1 = KeymapKey(0, 0, 0, QK_DYNAMIC_MACRO_RECORD_START_1);
+    KeymapKey key_rec2 = KeymapKey(0, 1, 0, QK_DYNAMIC_MACRO_RECORD_START_2);
+    KeymapKey key_ply1 = KeymapKey(0, 2, 0, QK_DYNAMIC_MACRO_PLAY_1);
+    KeymapKey key_ply2 = KeymapKey(0, 3, 0, QK_DYNAMIC_MACRO_PLAY_2);
+    KeymapKey key_stop = KeymapKey(0, 4, 0, QK_DYNAMIC_MACRO_RECORD_STOP);
+    KeymapKey key_a    = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 6, 0, KC_B);
+
+    void SetUp() override {
+        TestFixture::SetUp();
+        set_keymap({key_rec1, key_rec2, key_ply1, key_ply2, key_stop, key_a, key_b});
+    }
+
+    // Records the given keys into a macro, ignoring the reports sent meanwhile.
+    template <typename... Ts>
+    void record(TestDriver &driver, KeymapKey rec, Ts... keys) {
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        for (KeymapKey key : std::initializer_list<KeymapKey>{rec, keys..., key_stop}) {
+            tap_key(key);
+        }
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(DynamicMacro, RecordAndPlay) {
+    TestDriver driver;
+
+    record(driver, key_rec2);
+    record(driver, key_rec1, key_a, key_b);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, PlaybackIsNonBlocking) {
+    TestDriver driver;
+
+    record(driver, key_rec2);
+    record(driver, key_rec1, key_a, key_b);
+
+    EXPECT_NO_REPORT(driver);
+    key_ply1.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Releasing the play key queues the macro, which is then replayed one event per scan
+    EXPECT_REPORT(driver, (KC_A));
+    key_ply1.release();
+    run_one_scan_loop();
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    run_one_scan_loop();
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, NestedPlayback) {
+    TestDriver driver;
+
+    record(driver, key_rec2, key_b);
+    record(driver, key_rec1, key_a, key_ply2, key_ply1);
+
+    // Macro 1 replays macro 2, but not itself
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    idle_for(20);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, FullBufferStopsRecording) {
+    TestDriver driver;
+
+    // Four keystrokes fill the eight byte buffer
+    record(driver, key_rec2);
+    record(driver, key_rec1, key_a, key_a, key_a, key_b, key_b);
+
+    {
+        InSequence s;
+        for (int i = 0; i < 3; i++) {
+            EXPECT_REPORT(driver, (KC_A));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    // The second macro has no room left
+    record(driver, key_rec2, key_b);
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_ply2);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,6 @@
+ENCODER_ENABLE = yes
+ENCODER_MAP_ENABLE = yes
+ENCODER_DRIVER = custom
+MOUSEKEY_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = encoder_map.c
@@ -0,0 +1,84 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+static bool     intercept_wheel = false;
+static uint16_t processed       = 0;
+
+extern "C" {
+void encoder_driver_init(void) {}
+
+void encoder_driver_task(void) {}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed) processed++;
+    return !(intercept_wheel && IS_MOUSEKEY_WHEEL(keycode));
+}
+}
+
+class EncoderMapWheel : public TestFixture {
+   public:
+    void SetUp() override {
+        intercept_wheel = false;
+        processed       = 0;
+    }
+
+    void turn(uint8_t index, bool clockwise, int detents) {
+        for (int i = 0; i < detents; i++) {
+            encoder_queue_event(index, clockwise);
+        }
+    }
+};
+
+TEST_F(EncoderMapWheel, BatchScrollsInOneReport) {
+    TestDriver driver;
+
+    // MOUSEKEY_WHEEL_DELTA per detent
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 6, 0));
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    turn(0, true, 3);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(processed, 1);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -4, 0));
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    turn(0, false, 2);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EncoderMapWheel, BatchGoesThroughKeycodeProcessing) {
+    TestDriver driver;
+
+    intercept_wheel = true;
+    EXPECT_NO_MOUSE_REPORT(driver);
+    turn(0, true, 3);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(processed, 1);
+
+    // A batch handled by the keymap doesn't scale the next wheel press
+    intercept_wheel = false;
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 2, 0));
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    turn(0, true, 1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EncoderMapWheel, OtherKeycodesAreTappedPerDetent) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A)).Times(3);
+    EXPECT_EMPTY_REPORT(driver).Times(3);
+    turn(1, true, 3);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(processed, 3);
+}
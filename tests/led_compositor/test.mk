@@ -0,0 +1,3 @@
+LED_COMPOSITOR_ENABLE = yes
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
@@ -0,0 +1,204 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+#include <array>
+#include <vector>
+
+static std::array<rgb_t, RGB_MATRIX_LED_COUNT> leds;
+
+static void mock_init(void) {}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index] = {r, g, b};
+}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    leds.fill({r, g, b});
+}
+
+static void mock_flush(void) {}
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+    .flush_changed = NULL,
+};
+
+// The effect only draws the first LED, the second keeps whatever it was set to
+led_config_t g_led_config = {{{0}}, {{0, 0}, {224, 0}}, {LED_FLAG_KEYLIGHT, LED_FLAG_NONE}};
+}
+
+static int flush_a_count = 0;
+static int flush_b_count = 0;
+
+static void flush_a(void) {
+    flush_a_count++;
+}
+
+static void flush_b(void) {
+    flush_b_count++;
+}
+
+static std::vector<std::pair<int, uint8_t>> rendered;
+
+static void render_low(uint8_t led_min, uint8_t led_max) {
+    rendered.push_back({1, led_compositor_alpha()});
+}
+
+static void render_high(uint8_t led_min, uint8_t led_max) {
+    rendered.push_back({2, led_compositor_alpha()});
+}
+
+class LedCompositor : public TestFixture {
+   public:
+    void SetUp() override {
+        led_compositor_flush();
+        flush_a_count = 0;
+        flush_b_count = 0;
+        rendered.clear();
+    }
+};
+
+TEST_F(LedCompositor, FrameClockAdvances) {
+    TestDriver driver;
+    uint16_t   frame = led_compositor_frame();
+
+    // Line up with the start of a frame
+    while (led_compositor_frame() == frame) {
+        run_one_scan_loop();
+    }
+    frame = led_compositor_frame();
+
+    idle_for(LED_COMPOSITOR_FRAME_TIME * 4);
+    EXPECT_EQ(led_compositor_frame(), frame + 4);
+}
+
+TEST_F(LedCompositor, FlushesRunOncePerFrame) {
+    TestDriver driver;
+
+    led_compositor_request_flush(flush_a);
+    led_compositor_request_flush(flush_b);
+    led_compositor_request_flush(flush_a);
+    EXPECT_EQ(flush_a_count, 0);
+    EXPECT_EQ(flush_b_count, 0);
+
+    idle_for(LED_COMPOSITOR_FRAME_TIME);
+    EXPECT_EQ(flush_a_count, 1);
+    EXPECT_EQ(flush_b_count, 1);
+
+    idle_for(LED_COMPOSITOR_FRAME_TIME * 2);
+    EXPECT_EQ(flush_a_count, 1);
+    EXPECT_EQ(flush_b_count, 1);
+}
+
+TEST_F(LedCompositor, FlushNowEmptiesQueue) {
+    TestDriver driver;
+
+    led_compositor_request_flush(flush_a);
+    led_compositor_flush();
+    EXPECT_EQ(flush_a_count, 1);
+
+    idle_for(LED_COMPOSITOR_FRAME_TIME);
+    EXPECT_EQ(flush_a_count, 1);
+}
+
+TEST_F(LedCompositor, LayersRenderInPriorityOrder) {
+    TestDriver             driver;
+    led_compositor_layer_t high = {.priority = 20, .alpha = 255, .render = render_high};
+    led_compositor_layer_t low  = {.priority = 10, .alpha = 64, .render = render_low};
+
+    EXPECT_TRUE(led_compositor_add_layer(&high));
+    EXPECT_TRUE(led_compositor_add_layer(&low));
+
+    led_compositor_render_layers(0, 1);
+    ASSERT_EQ(rendered.size(), 2u);
+    EXPECT_EQ(rendered[0], std::make_pair(1, (uint8_t)64));
+    EXPECT_EQ(rendered[1], std::make_pair(2, (uint8_t)255));
+    EXPECT_EQ(led_compositor_alpha(), 255);
+
+    // Transparent layers are skipped
+    rendered.clear();
+    low.alpha = 0;
+    led_compositor_render_layers(0, 1);
+    ASSERT_EQ(rendered.size(), 1u);
+    EXPECT_EQ(rendered[0].first, 2);
+
+    led_compositor_remove_layer(&high);
+    led_compositor_remove_layer(&low);
+    rendered.clear();
+    led_compositor_render_layers(0, 1);
+    EXPECT_TRUE(rendered.empty());
+}
+
+TEST_F(LedCompositor, LayerSlotsAreLimited) {
+    TestDriver             driver;
+    led_compositor_layer_t layers[LED_COMPOSITOR_MAX_LAYERS + 1] = {};
+
+    for (uint8_t i = 0; i < LED_COMPOSITOR_MAX_LAYERS; i++) {
+        layers[i].render = render_low;
+        EXPECT_TRUE(led_compositor_add_layer(&layers[i]));
+    }
+    layers[LED_COMPOSITOR_MAX_LAYERS].render = render_low;
+    EXPECT_FALSE(led_compositor_add_layer(&layers[LED_COMPOSITOR_MAX_LAYERS]));
+
+    for (uint8_t i = 0; i < LED_COMPOSITOR_MAX_LAYERS; i++) {
+        led_compositor_remove_layer(&layers[i]);
+    }
+}
+
+TEST_F(LedCompositor, AddingLayerTwiceRegistersItOnce) {
+    TestDriver             driver;
+    led_compositor_layer_t layer = {.priority = 10, .alpha = 255, .render = render_low};
+
+    EXPECT_TRUE(led_compositor_add_layer(&layer));
+    EXPECT_TRUE(led_compositor_add_layer(&layer));
+    led_compositor_render_layers(0, 1);
+    EXPECT_EQ(rendered.size(), 1u);
+
+    led_compositor_remove_layer(&layer);
+    rendered.clear();
+    led_compositor_render_layers(0, 1);
+    EXPECT_TRUE(rendered.empty());
+}
+
+static void render_red(uint8_t led_min, uint8_t led_max) {
+    for (uint8_t i = led_min; i < led_max; i++) {
+        rgb_matrix_set_color(i, 255, 0, 0);
+    }
+}
+
+TEST_F(LedCompositor, LayersBlendOverBaseColors) {
+    TestDriver             driver;
+    led_compositor_layer_t layer = {.priority = 10, .alpha = 128, .render = render_red};
+
+    rgb_matrix_set_color(1, 0, 0, 0);
+    idle_for(LED_COMPOSITOR_FRAME_TIME * 2);
+    rgb_t effect = leds[0];
+    EXPECT_EQ(effect.r, 0);
+    EXPECT_GT(effect.b, 0);
+
+    EXPECT_TRUE(led_compositor_add_layer(&layer));
+    idle_for(LED_COMPOSITOR_FRAME_TIME * 2);
+    rgb_t blended[2] = {leds[0], leds[1]};
+    // Half way between both colors
+    EXPECT_NEAR(blended[0].r, 128, 1);
+    EXPECT_NEAR(blended[0].b, effect.b / 2, 1);
+    EXPECT_NEAR(blended[1].r, 128, 1);
+
+    // The second LED isn't redrawn by the effect, yet isn't blended again on every frame
+    idle_for(LED_COMPOSITOR_FRAME_TIME * 8);
+    EXPECT_EQ(leds[0].r, blended[0].r);
+    EXPECT_EQ(leds[1].r, blended[1].r);
+
+    led_compositor_remove_layer(&layer);
+    idle_for(LED_COMPOSITOR_FRAME_TIME * 2);
+    EXPECT_EQ(leds[0].r, effect.r);
+    EXPECT_EQ(leds[0].b, effect.b);
+    EXPECT_EQ(leds[1].r, 0);
+}
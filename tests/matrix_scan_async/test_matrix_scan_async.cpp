@@ -0,0 +1,136 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+bool matrix_scan_async_task(void);
+void advance_time(uint32_t ms);
+
+static uint16_t last_event_time = 0;
+static int      kb_scans        = 0;
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    last_event_time = record->event.time;
+    return true;
+}
+
+void matrix_scan_kb(void) {
+    kb_scans++;
+}
+}
+
+class MatrixScanAsync : public TestFixture {};
+
+TEST_F(MatrixScanAsync, KeyPressedAndReleased) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScanAsync, FullQueueDefersChanges) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e});
+
+    // The queue holds three events, the other two presses wait for the next scan
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_A, KC_B));
+        EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    }
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    key_d.press();
+    key_e.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+        EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(5);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    key_e.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScanAsync, EventsKeepTheirScanTime) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    // Scanned in the background, processed 50ms later
+    key.press();
+    matrix_scan_async_task();
+    const uint16_t scan_time = timer_read();
+    advance_time(50);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    EXPECT_EQ(last_event_time, scan_time);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScanAsync, ScanHooksRunInTheMainLoop) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    // Background scans only read the matrix
+    kb_scans = 0;
+    key.press();
+    matrix_scan_async_task();
+    matrix_scan_async_task();
+    EXPECT_EQ(kb_scans, 0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    EXPECT_EQ(kb_scans, 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
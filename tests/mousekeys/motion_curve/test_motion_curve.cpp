@@ -0,0 +1,68 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class MousekeyMotionCurve : public TestFixture {};
+
+TEST_F(MousekeyMotionCurve, PressAndHoldCursorUpCarriesSubPixelMotion) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_UP};
+
+    set_keymap({mouse_key});
+
+    EXPECT_MOUSE_REPORT(driver, (0, -8, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 8 * 10 * (1 / 30) = 2.5 pixels, half a pixel carried
+    EXPECT_MOUSE_REPORT(driver, (0, -2, 0, 0, 0));
+    idle_for(MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    // 8 * 10 * (2 / 30) = 5.3 pixels, plus the carried half
+    EXPECT_MOUSE_REPORT(driver, (0, -5, 0, 0, 0));
+    idle_for(MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    mouse_key.release();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyMotionCurve, DiagonalMotionIsScaledInFixedPoint) {
+    TestDriver driver;
+    KeymapKey  key_up    = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_UP};
+    KeymapKey  key_right = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_RIGHT};
+
+    set_keymap({key_up, key_right});
+
+    EXPECT_MOUSE_REPORT(driver, (0, -8, 0, 0, 0));
+    key_up.press();
+    run_one_scan_loop();
+    EXPECT_MOUSE_REPORT(driver, (8, -8, 0, 0, 0));
+    key_right.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 2.5 pixels * 181 / 256 = 1.76 pixels per axis
+    EXPECT_MOUSE_REPORT(driver, (1, -1, 0, 0, 0));
+    idle_for(MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (8, 0, 0, 0, 0));
+    key_up.release();
+    run_one_scan_loop();
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    key_right.release();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_ACCEL_ENABLE
+#define POINTING_DEVICE_ACCEL_MIN_GAIN MOUSE_MOTION_ONE
+#define POINTING_DEVICE_ACCEL_MAX_GAIN (3 * MOUSE_MOTION_ONE)
+#define POINTING_DEVICE_ACCEL_EXPONENT 1
+#define POINTING_DEVICE_ACCEL_SPEED_MAX 64
@@ -0,0 +1,53 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+class PointingAccel : public TestFixture {
+   public:
+    void SetUp() override {
+        pointing_device_reset_motion();
+    }
+};
+
+struct SimpleReport {
+    int16_t x;
+    int16_t y;
+};
+
+class PointingAccelParametrized : public ::testing::WithParamInterface<std::pair<SimpleReport, SimpleReport>>, public PointingAccel {};
+
+TEST_P(PointingAccelParametrized, AccelerationFollowsCurve) {
+    TestDriver   driver;
+    SimpleReport input        = GetParam().first;
+    SimpleReport expectations = GetParam().second;
+
+    pd_set_x(input.x);
+    pd_set_y(input.y);
+
+    EXPECT_MOUSE_REPORT(driver, (expectations.x, expectations.y, 0, 0, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    LinearCurve,
+    PointingAccelParametrized,
+    ::testing::Values(
+        //                      Input                     Expected
+        std::make_pair(SimpleReport{   2,   0}, SimpleReport{   2,   0}), // gain 1.0625
+        std::make_pair(SimpleReport{  32,   0}, SimpleReport{  64,   0}), // gain 2.0
+        std::make_pair(SimpleReport{   0, -32}, SimpleReport{   0, -64}), // gain 2.0
+        std::make_pair(SimpleReport{  32,  32}, SimpleReport{  80,  80}), // speed 48, gain 2.5
+        std::make_pair(SimpleReport{  64,   0}, SimpleReport{ 127,   0})  // gain 3.0, clamped
+        ));
+// clang-format on
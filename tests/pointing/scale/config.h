@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_MOTION_SCALE_X MOUSE_MOTION_RATIO(1, 4)
+#define POINTING_DEVICE_MOTION_SCALE_Y MOUSE_MOTION_RATIO(3, 2)
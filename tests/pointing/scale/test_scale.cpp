@@ -0,0 +1,90 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+class PointingScale : public TestFixture {
+   public:
+    void SetUp() override {
+        pointing_device_set_motion_scale(POINTING_DEVICE_MOTION_SCALE_X, POINTING_DEVICE_MOTION_SCALE_Y);
+    }
+};
+
+TEST_F(PointingScale, FractionalMotionIsCarried) {
+    TestDriver driver;
+
+    pd_set_x(1);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingScale, NegativeFractionalMotionIsCarried) {
+    TestDriver driver;
+
+    pd_set_x(-2);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (-1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+}
+
+TEST_F(PointingScale, AxesAreScaledIndependently) {
+    TestDriver driver;
+
+    pd_set_y(1);
+    EXPECT_MOUSE_REPORT(driver, (0, 1, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 2, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+}
+
+TEST_F(PointingScale, ScaleCanBeChangedAtRuntime) {
+    TestDriver driver;
+
+    pointing_device_set_motion_scale(MOUSE_MOTION_ONE, MOUSE_MOTION_RATIO(1, 2));
+    pd_set_x(5);
+    pd_set_y(5);
+    EXPECT_MOUSE_REPORT(driver, (5, 2, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (5, 3, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+}
@@ -0,0 +1,96 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+#include <array>
+#include <cstring>
+
+static int                                       set_color_count = 0;
+static int                                       flush_count     = 0;
+static std::array<uint8_t, RGB_MATRIX_LED_COUNT> flushed_mask;
+
+static void mock_init(void) {}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    set_color_count++;
+}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    set_color_count++;
+}
+
+static void mock_flush(void) {
+    flush_count++;
+}
+
+static void mock_flush_changed(const uint8_t *changed) {
+    flush_count++;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        flushed_mask[i] = (changed[i / 8] >> (i % 8)) & 1;
+    }
+}
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+    .flush_changed = mock_flush_changed,
+};
+
+led_config_t g_led_config = {};
+}
+
+class RgbMatrixShadowBuffer : public TestFixture {
+   public:
+    void SetUp() override {
+        // Start from a known frame that has been flushed
+        rgb_matrix_set_color_all(0, 0, 0);
+        rgb_matrix_update_pwm_buffers();
+        set_color_count = 0;
+        flush_count     = 0;
+        flushed_mask.fill(0);
+    }
+};
+
+TEST_F(RgbMatrixShadowBuffer, UnchangedFrameIsNotFlushed) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_set_color(i, 10, 20, 30);
+    }
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_EQ(set_color_count, RGB_MATRIX_LED_COUNT);
+    EXPECT_EQ(flush_count, 1);
+
+    // Same colors again
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_set_color(i, 10, 20, 30);
+    }
+    rgb_matrix_set_color_all(10, 20, 30);
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_EQ(set_color_count, RGB_MATRIX_LED_COUNT);
+    EXPECT_EQ(flush_count, 1);
+}
+
+TEST_F(RgbMatrixShadowBuffer, SingleChangedLedIsFlushed) {
+    rgb_matrix_set_color(2, 255, 0, 0);
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_EQ(set_color_count, 1);
+    EXPECT_EQ(flush_count, 1);
+    EXPECT_EQ(flushed_mask, (std::array<uint8_t, RGB_MATRIX_LED_COUNT>{0, 0, 1, 0}));
+
+    // The mask is cleared once flushed
+    rgb_matrix_set_color(0, 0, 255, 0);
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_EQ(flush_count, 2);
+    EXPECT_EQ(flushed_mask, (std::array<uint8_t, RGB_MATRIX_LED_COUNT>{1, 0, 0, 0}));
+}
+
+TEST_F(RgbMatrixShadowBuffer, ChangeUndoneBeforeFlushIsSkipped) {
+    rgb_matrix_set_color(1, 0, 0, 255);
+    rgb_matrix_set_color(1, 0, 0, 0);
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_EQ(flush_count, 0);
+}
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+const uint16_t arrows_combo[] = {KC_LEFT, KC_RIGHT, COMBO_END};
+
+combo_t key_combos[] = {
+    COMBO(arrows_combo, KC_ESC),
+};
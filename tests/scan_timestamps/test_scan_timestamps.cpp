@@ -0,0 +1,113 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+// Key events are decided by the time they were scanned at, not by how late they get processed
+class ScanTimestamps : public TestFixture {};
+
+TEST_F(ScanTimestamps, ModTapReleasedInTimeIsATapWhenProcessedLate) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    inject_key_event(mod_tap_key, true, 100);
+    inject_key_event(mod_tap_key, false, 100 + TAPPING_TERM - 1);
+    advance_time(TAPPING_TERM);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanTimestamps, ModTapReleasedLateIsAHoldWhenProcessedTogether) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    inject_key_event(mod_tap_key, true, 100);
+    inject_key_event(mod_tap_key, false, 100 + TAPPING_TERM + 1);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanTimestamps, ComboCompletedInTimeFiresWhenProcessedLate) {
+    TestDriver driver;
+    InSequence s;
+    auto       left_key  = KeymapKey(0, 1, 0, KC_LEFT);
+    auto       right_key = KeymapKey(0, 2, 0, KC_RIGHT);
+
+    set_keymap({left_key, right_key});
+
+    EXPECT_NO_REPORT(driver);
+    inject_key_event(left_key, true, 100);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    inject_key_event(right_key, true, 100 + COMBO_TERM - 1);
+    advance_time(COMBO_TERM);
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    left_key.release();
+    right_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanTimestamps, AutoShiftReleasedInTimeIsNotShiftedWhenProcessedLate) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    inject_key_event(regular_key, true, 100);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    inject_key_event(regular_key, false, 100 + AUTO_SHIFT_TIMEOUT - 1);
+    advance_time(AUTO_SHIFT_TIMEOUT);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanTimestamps, AutoShiftReleasedLateIsShiftedWhenProcessedTogether) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({regular_key});
+
+    inject_key_event(regular_key, true, 100);
+    inject_key_event(regular_key, false, 100 + AUTO_SHIFT_TIMEOUT + 1);
+
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
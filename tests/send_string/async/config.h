@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SENDSTRING_ASYNC
+#define SEND_STRING_ASYNC_QUEUE_SIZE 2
+// Only one character is prepared ahead
+#define SEND_STRING_ASYNC_BUFFER_SIZE 8
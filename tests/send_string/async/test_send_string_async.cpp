@@ -0,0 +1,149 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {
+   public:
+    void TearDown() override {
+        send_string_async_cancel();
+    }
+};
+
+TEST_F(SendStringAsync, TypesInBackground) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay("aB", 0));
+    EXPECT_TRUE(send_string_async_busy());
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, DelayDoesNotBlockScanning) {
+    TestDriver driver;
+    auto       key_c = KeymapKey(0, 0, 0, KC_C);
+
+    set_keymap({key_c});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(send_string_async_with_delay("a" SS_DELAY(100) "b", 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // A key pressed during the delay is reported right away
+    EXPECT_REPORT(driver, (KC_C));
+    key_c.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(90);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, IntervalBetweenKeystrokes) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_TRUE(send_string_async_with_delay("ab", 10));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(9);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, QueueLimit) {
+    TestDriver driver;
+
+    EXPECT_TRUE(send_string_async("a"));
+    EXPECT_TRUE(send_string_async("b"));
+    EXPECT_FALSE(send_string_async("c"));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver).Times(2);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesHeldKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_TRUE(send_string_async_with_delay("A", 50));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_busy());
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesKeysHeldDown) {
+    TestDriver driver;
+    InSequence s;
+
+    // The release of Ctrl is too far behind the delay to be prepared yet
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_TRUE(send_string_async(SS_DOWN(X_LCTL) SS_DELAY(100) "abc" SS_UP(X_LCTL)));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, PlaysWithoutHostDriver) {
+    host_set_driver(NULL);
+
+    EXPECT_TRUE(send_string_async("ab"));
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_async_busy());
+}
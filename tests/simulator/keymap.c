@@ -0,0 +1,60 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum {
+    TD_E_ESC,
+};
+
+enum {
+    // Toggles a deferred executor tapping KC_Z once a minute
+    SIM_TICK = SAFE_RANGE,
+};
+
+// clang-format off
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_A,    KC_B,    LSFT_T(KC_C), LT(1, KC_D), TD(TD_E_ESC), SIM_TICK, KC_NO,   KC_NO,   KC_NO,   KC_NO},
+        {KC_NO,   KC_NO,   KC_NO,        KC_NO,       KC_NO,        KC_NO,    KC_NO,   KC_NO,   KC_NO,   KC_NO},
+        {KC_NO,   KC_NO,   KC_NO,        KC_NO,       KC_NO,        KC_NO,    KC_NO,   KC_NO,   KC_NO,   KC_NO},
+        {KC_NO,   KC_NO,   KC_NO,        KC_NO,       KC_NO,        KC_NO,    KC_NO,   KC_NO,   KC_NO,   KC_NO},
+    },
+    [1] = {
+        {KC_1,    KC_2,    KC_TRNS,      KC_TRNS,     KC_TRNS,      KC_TRNS,  KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS,      KC_TRNS,     KC_TRNS,      KC_TRNS,  KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS,      KC_TRNS,     KC_TRNS,      KC_TRNS,  KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS,      KC_TRNS,     KC_TRNS,      KC_TRNS,  KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+    },
+};
+// clang-format on
+
+const uint16_t ab_combo[] = {KC_A, KC_B, COMBO_END};
+
+combo_t key_combos[] = {
+    COMBO(ab_combo, KC_TAB),
+};
+
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_E_ESC] = ACTION_TAP_DANCE_DOUBLE(KC_E, KC_ESC),
+};
+
+static deferred_token tick_token = INVALID_DEFERRED_TOKEN;
+
+static uint32_t tick_callback(uint32_t trigger_time, void *cb_arg) {
+    tap_code(KC_Z);
+    return 60000;
+}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == SIM_TICK && record->event.pressed) {
+        if (tick_token == INVALID_DEFERRED_TOKEN) {
+            tick_token = defer_exec(60000, tick_callback, NULL);
+        } else {
+            cancel_deferred_exec(tick_token);
+            tick_token = INVALID_DEFERRED_TOKEN;
+        }
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,363 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Deterministic host side simulator.
+ *
+ * Runs the firmware core against the keymap in this folder, driven by a trace of timed matrix changes,
+ * and prints every HID report it sends. Instead of ticking the main loop once per millisecond, virtual
+ * time jumps straight to the next event or internal deadline, see keyboard_next_timeout().
+ *
+ * Trace format, one change per line, '#' starts a comment:
+ *
+ *     <time>  down|up <row> <col>    absolute time in ms
+ *     +<ms>   down|up <row> <col>    relative to the previous line
+ *     <time>  end                    keep running until then, defaults to one second after the last change
+ *
+ * Usage: simulator [--step] [--repeat N] [--quiet] [trace|-]
+ *
+ * Without a trace a built-in script is run once per millisecond and once with jumps, and the two report
+ * streams have to match, that is what `make test:simulator` checks.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "keyboard_report_util.hpp"
+
+extern "C" {
+#include "debug.h"
+#include "eeconfig.h"
+#include "host.h"
+#include "keyboard.h"
+#include "test_matrix.h"
+#include "timer.h"
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+
+void set_time(uint32_t t);
+
+int8_t sendchar(uint8_t c) {
+    return 0;
+}
+
+__attribute__((weak)) debug_config_t debug_config = {0};
+}
+
+#ifndef SIMULATOR_MAX_JUMP
+// Bounds how late a timeout that keyboard_next_timeout() doesn't know about can fire, and keeps the 16-bit timers from wrapping between two loops
+#    define SIMULATOR_MAX_JUMP 1000
+#endif
+
+#ifndef SIMULATOR_SETTLE_TIME
+#    define SIMULATOR_SETTLE_TIME 1000
+#endif
+
+namespace {
+
+struct MatrixChange {
+    uint32_t time;
+    bool     pressed;
+    uint8_t  row;
+    uint8_t  col;
+};
+
+struct Trace {
+    std::vector<MatrixChange> changes;
+    uint32_t                  length = 0;
+};
+
+struct Stats {
+    uint64_t changes = 0;
+    uint64_t loops   = 0;
+    uint64_t reports = 0;
+};
+
+std::ostream *report_stream = &std::cout;
+uint32_t      report_base   = 0;
+Stats         stats;
+
+void report_prefix(const char *type) {
+    stats.reports++;
+    *report_stream << std::setw(10) << std::right << timer_read32() - report_base << " " << std::setw(9) << std::left << type;
+}
+
+uint8_t sim_keyboard_leds(void) {
+    return 0;
+}
+
+void sim_send_keyboard(report_keyboard_t *report) {
+    report_prefix("keyboard");
+    *report_stream << *report;
+}
+
+void sim_send_nkro(report_nkro_t *report) {
+    report_prefix("nkro");
+    *report_stream << std::hex << "mods 0x" << +report->mods << " bits";
+    for (size_t i = 0; i < sizeof(report->bits); i++) {
+        *report_stream << " " << std::setw(2) << std::setfill('0') << std::right << +report->bits[i] << std::setfill(' ');
+    }
+    *report_stream << std::dec << std::endl;
+}
+
+void sim_send_mouse(report_mouse_t *report) {
+    report_prefix("mouse");
+    *report_stream << "buttons " << +report->buttons << " x " << +report->x << " y " << +report->y << " v " << +report->v << " h " << +report->h << std::endl;
+}
+
+void sim_send_extra(report_extra_t *report) {
+    report_prefix("extra");
+    *report_stream << "id " << +report->report_id << " usage 0x" << std::hex << report->usage << std::dec << std::endl;
+}
+
+host_driver_t sim_driver = {sim_keyboard_leds, sim_send_keyboard, sim_send_nkro, sim_send_mouse, sim_send_extra};
+
+// The same order as the main loop in quantum/main.c
+void run_loop(void) {
+    keyboard_task();
+#ifdef DEFERRED_EXEC_ENABLE
+    deferred_exec_task();
+#endif
+    housekeeping_task();
+    stats.loops++;
+}
+
+// Runs the main loop up to, but not at `until`, only stopping where something can happen unless stepping every millisecond
+void run_until(uint32_t until, bool step) {
+    while (true) {
+        uint32_t jump = 1;
+        if (!step) {
+            uint32_t timeout = keyboard_next_timeout();
+            jump             = timeout == 0 ? 1 : (timeout < SIMULATOR_MAX_JUMP ? timeout : SIMULATOR_MAX_JUMP);
+        }
+        if (until - timer_read32() <= jump) {
+            break;
+        }
+        set_time(timer_read32() + jump);
+        run_loop();
+    }
+    set_time(until);
+}
+
+void run_trace(const Trace &trace, unsigned repeat, bool step) {
+    for (unsigned i = 0; i < repeat; i++) {
+        const uint32_t base = timer_read32();
+        report_base         = base;
+
+        for (size_t j = 0; j < trace.changes.size();) {
+            const uint32_t time = base + trace.changes[j].time;
+            if (time != timer_read32()) {
+                run_until(time, step);
+            }
+
+            // Everything happening in the same millisecond is seen by the same scan
+            for (; j < trace.changes.size() && base + trace.changes[j].time == time; j++) {
+                const MatrixChange &change = trace.changes[j];
+                if (change.pressed) {
+                    press_key(change.col, change.row);
+                } else {
+                    release_key(change.col, change.row);
+                }
+                stats.changes++;
+            }
+            run_loop();
+        }
+        run_until(base + trace.length, step);
+        run_loop();
+    }
+}
+
+bool parse_trace(std::istream &input, Trace &trace) {
+    std::string line;
+    uint32_t    time   = 0;
+    unsigned    number = 0;
+    bool        ended  = false;
+
+    while (std::getline(input, line)) {
+        number++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream fields(line);
+        std::string        when, what;
+        if (!(fields >> when)) {
+            continue;
+        }
+        char    *end;
+        uint32_t value = strtoul(when.c_str() + (when[0] == '+'), &end, 10);
+        if (*end != '\0' || !(fields >> what)) {
+            std::cerr << "line " << number << ": expected <time> down|up <row> <col> or <time> end" << std::endl;
+            return false;
+        }
+        uint32_t next = when[0] == '+' ? time + value : value;
+        if (next < time) {
+            std::cerr << "line " << number << ": time goes backwards" << std::endl;
+            return false;
+        }
+        time = next;
+
+        if (what == "end") {
+            trace.length = time;
+            ended        = true;
+            continue;
+        }
+
+        unsigned row, col;
+        if ((what != "down" && what != "up") || !(fields >> row >> col) || row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+            std::cerr << "line " << number << ": expected <time> down|up <row> <col> within the " << MATRIX_ROWS << "x" << MATRIX_COLS << " matrix" << std::endl;
+            return false;
+        }
+        trace.changes.push_back({time, what == "down", (uint8_t)row, (uint8_t)col});
+    }
+
+    if (!ended) {
+        trace.length = time + SIMULATOR_SETTLE_TIME;
+    }
+    // Keep repetitions apart, the last change has to be scanned before the next one starts
+    if (!trace.changes.empty() && trace.length <= trace.changes.back().time) {
+        trace.length = trace.changes.back().time + 1;
+    }
+    return true;
+}
+
+void print_stats(const char *name, uint32_t simulated, std::chrono::nanoseconds wall) {
+    std::cerr << name << ": " << stats.changes << " matrix changes, " << stats.reports << " reports, " << stats.loops << " loops, " << simulated << " ms simulated in " << wall.count() / 1000000.0 << " ms";
+    if (stats.changes) {
+        std::cerr << ", " << wall.count() / stats.changes << " ns per change";
+    }
+    std::cerr << std::endl;
+}
+
+// Runs a trace and returns its report stream, with the cost of doing so on stderr
+std::string simulate(const Trace &trace, unsigned repeat, bool step, bool quiet, const char *name) {
+    std::ostringstream reports;
+    report_stream = quiet ? &reports : &std::cout;
+    stats         = {};
+
+    const uint32_t start       = timer_read32();
+    const auto     start_clock = std::chrono::steady_clock::now();
+    run_trace(trace, repeat, step);
+    print_stats(name, timer_read32() - start, std::chrono::steady_clock::now() - start_clock);
+
+    report_stream = &std::cout;
+    return reports.str();
+}
+
+const char *builtin_script = R"(
+# tap A
+0     down 0 0
++30   up   0 0
+# hold the Shift mod-tap past the tapping term, tap A
++100  down 0 2
++250  down 0 0
++20   up   0 0
++20   up   0 2
+# tap the mod-tap quickly
++100  down 0 2
++50   up   0 2
+# hold the layer-tap, tap A on layer 1
++100  down 0 3
++300  down 0 0
++10   up   0 0
++10   up   0 3
+# the A+B combo
++100  down 0 0
++10   down 0 1
++40   up   0 0
++5    up   0 1
+# single and double tap dance
++100  down 0 4
++20   up   0 4
++500  down 0 4
++20   up   0 4
++50   down 0 4
++20   up   0 4
+# a deferred executor tapping Z once a minute, for an hour
++500  down 0 5
++10   up   0 5
++3600000 down 0 5
++10   up   0 5
+)";
+
+int self_test(void) {
+    Trace              trace;
+    std::istringstream script(builtin_script);
+    if (!parse_trace(script, trace)) {
+        return 1;
+    }
+
+    const std::string stepped       = simulate(trace, 1, true, true, "step");
+    const uint64_t    stepped_loops = stats.loops;
+    const std::string jumped        = simulate(trace, 1, false, true, "jump");
+
+    if (stepped != jumped) {
+        std::cerr << "report streams differ" << std::endl << "--- step" << std::endl << stepped << "--- jump" << std::endl << jumped;
+        return 1;
+    }
+    if (stats.reports < 60 * 2 || stats.loops * 100 > stepped_loops) {
+        std::cerr << "unexpected report or loop count" << std::endl << jumped;
+        return 1;
+    }
+    std::cerr << "report streams match" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool        step   = false;
+    bool        quiet  = false;
+    unsigned    repeat = 1;
+    const char *path   = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--step")) {
+            step = true;
+        } else if (!strcmp(argv[i], "--quiet")) {
+            quiet = true;
+        } else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            repeat = strtoul(argv[++i], nullptr, 10);
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            std::cerr << "usage: " << argv[0] << " [--step] [--repeat N] [--quiet] [trace|-]" << std::endl;
+            return 2;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    // The same bootstrapping as the unit tests
+    timer_clear();
+    eeconfig_init_quantum();
+    eeconfig_update_debug(debug_config.raw);
+    host_set_driver(&sim_driver);
+    keyboard_init();
+
+    if (!path) {
+        return self_test();
+    }
+
+    Trace trace;
+    if (!strcmp(path, "-")) {
+        if (!parse_trace(std::cin, trace)) {
+            return 1;
+        }
+    } else {
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "can't open " << path << std::endl;
+            return 1;
+        }
+        if (!parse_trace(file, trace)) {
+            return 1;
+        }
+    }
+
+    simulate(trace, repeat, step, quiet, step ? "step" : "jump");
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+
+class StateChange : public TestFixture {
+   protected:
+    state_snapshot_t snapshot = {};
+
+    void SetUp() override {
+        // Catch up with whatever the previous tests left behind
+        state_changes(&snapshot, STATE_ALL);
+    }
+};
+
+TEST_F(StateChange, FreshSnapshotSeesEverything) {
+    state_snapshot_t fresh = {};
+    EXPECT_EQ(state_changes(&fresh, STATE_ALL), STATE_ALL);
+    EXPECT_EQ(state_changes(&fresh, STATE_ALL), 0);
+}
+
+TEST_F(StateChange, LayersOnlyOnActualChanges) {
+    TestDriver driver;
+
+    layer_on(1);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_LAYER));
+    layer_on(1);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), 0);
+    layer_off(1);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_LAYER));
+
+    default_layer_set(1 << 2);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_DEFAULT_LAYER));
+    default_layer_set(1 << 2);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), 0);
+    default_layer_set(1 << 0);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_DEFAULT_LAYER));
+}
+
+TEST_F(StateChange, ModsFromKeys) {
+    TestDriver driver;
+    KeymapKey  key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    set_keymap({key_shift});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_MODS));
+    VERIFY_AND_CLEAR(driver);
+
+    // Holding the key changes nothing
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), 0);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_MODS));
+    VERIFY_AND_CLEAR(driver);
+
+    // Setting the same mods again isn't a change
+    clear_mods();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), 0);
+}
+
+TEST_F(StateChange, HostLeds) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    driver.set_leds(0x02); // Caps Lock
+    run_one_scan_loop();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_HOST_LEDS));
+    run_one_scan_loop();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), 0);
+
+    driver.set_leds(0);
+    run_one_scan_loop();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_HOST_LEDS));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(StateChange, CapsWord) {
+    TestDriver driver;
+
+    caps_word_on();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_CAPS_WORD));
+    caps_word_on();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), 0);
+    caps_word_off();
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_CAPS_WORD));
+}
+
+TEST_F(StateChange, UnrequestedTopicsStayPending) {
+    TestDriver driver;
+
+    layer_on(1);
+    caps_word_on();
+    EXPECT_EQ(state_changes(&snapshot, STATE_BIT(STATE_CAPS_WORD)), STATE_BIT(STATE_CAPS_WORD));
+    EXPECT_EQ(state_changes(&snapshot, STATE_BIT(STATE_MODS) | STATE_BIT(STATE_CAPS_WORD)), 0);
+    EXPECT_EQ(state_changes(&snapshot, STATE_ALL), STATE_BIT(STATE_LAYER));
+
+    uint16_t version = state_version(STATE_LAYER);
+    layer_off(1);
+    EXPECT_EQ(state_version(STATE_LAYER), uint16_t(version + 1));
+    caps_word_off();
+}
@@ -0,0 +1,19 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "tap_dance_defs.h"
+
+uint32_t tapping_term_lookups = 0;
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    tapping_term_lookups++;
+    return keycode == TD(0) ? SLOW_DANCE_TERM : TAPPING_TERM;
+}
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[TAP_DANCE_TABLE_SIZE] = {
+    [0 ... TAP_DANCE_TABLE_SIZE - 2] = ACTION_TAP_DANCE_DOUBLE(KC_A, KC_B),
+    [TAP_DANCE_TABLE_SIZE - 1]       = ACTION_TAP_DANCE_DOUBLE(KC_1, KC_2),
+};
+// clang-format on
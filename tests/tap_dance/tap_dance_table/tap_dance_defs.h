@@ -0,0 +1,20 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+#define TAP_DANCE_TABLE_SIZE 128
+// Term of the first dance, long enough to keep it pending for a whole benchmark run
+#define SLOW_DANCE_TERM 20000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t tapping_term_lookups;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+#include "tap_dance_defs.h"
+
+using testing::_;
+using testing::InSequence;
+
+class TapDanceTable : public TestFixture {};
+
+TEST_F(TapDanceTable, LastDanceOfLargeTable) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_td = KeymapKey(0, 1, 0, TD(TAP_DANCE_TABLE_SIZE - 1));
+
+    set_keymap({key_td});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_td);
+    idle_for(TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_td);
+    tap_key(key_td);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceTable, DancesInterruptEachOther) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_first = KeymapKey(0, 1, 0, TD(0));
+    auto       key_last  = KeymapKey(0, 2, 0, TD(TAP_DANCE_TABLE_SIZE - 1));
+
+    set_keymap({key_first, key_last});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_first);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_last);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceTable, TermIsResolvedOncePerTap) {
+    TestDriver driver;
+    auto       key_td = KeymapKey(0, 1, 0, TD(TAP_DANCE_TABLE_SIZE - 1));
+
+    set_keymap({key_td});
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tapping_term_lookups = 0;
+    tap_key(key_td);
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(tapping_term_lookups, 1);
+}
+
+// Not a pass/fail check on timing: reports the scan loop cost with and without
+// a pending dance, both are recorded as test properties for comparison.
+TEST_F(TapDanceTable, ScanLoopBenchmark) {
+    TestDriver driver;
+    auto       key_td = KeymapKey(0, 1, 0, TD(0));
+
+    set_keymap({key_td});
+
+    const unsigned loops   = SLOW_DANCE_TERM / 2;
+    auto           measure = [&]() {
+        auto start = std::chrono::steady_clock::now();
+        idle_for(loops);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / loops;
+    };
+
+    EXPECT_NO_REPORT(driver);
+    const auto idle_ns = measure();
+
+    tapping_term_lookups = 0;
+    tap_key(key_td);
+    const auto pending_ns = measure();
+    VERIFY_AND_CLEAR(driver);
+
+    RecordProperty("dances", TAP_DANCE_TABLE_SIZE);
+    RecordProperty("idle_ns_per_scan", static_cast<int>(idle_ns));
+    RecordProperty("pending_dance_ns_per_scan", static_cast<int>(pending_ns));
+    EXPECT_EQ(tapping_term_lookups, 1);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(SLOW_DANCE_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -23,6 +23,8 @@ extern "C" {
 #include "debug.h"
 #include "eeconfig.h"
 #include "keyboard.h"
+#include "keymap_introspection.h"
+#include "matrix.h"
 
 void set_time(uint32_t t);
 void advance_time(uint32_t ms);
@@ -34,8 +36,18 @@ using testing::_;
 TestFixture* TestFixture::m_this = nullptr;
 
 /* Override weak QMK function to allow the usage of isolated per-test keymaps in unit-tests.
- * The actual call is dynamicaly dispatched to the current active test fixture, which in turn has it's own keymap. */
+ * The actual call is dynamicaly dispatched to the current active test fixture, which in turn has it's own keymap.
+ * Without an active fixture, e.g. in the simulator, the compiled in keymap is used instead. */
 extern "C" uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t position) {
+#if defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE)
+    // Encoders are looked up in the encoder_map of the test
+    if (position.row == KEYLOC_ENCODER_CW || position.row == KEYLOC_ENCODER_CCW) {
+        return keycode_at_encodermap_location(layer, position.col, position.row == KEYLOC_ENCODER_CW);
+    }
+#endif
+    if (!TestFixture::m_this) {
+        return keycode_at_keymap_location(layer, position.row, position.col);
+    }
     uint16_t keycode;
     TestFixture::m_this->get_keycode(layer, position, &keycode);
     return keycode;
@@ -176,6 +188,19 @@ void TestFixture::run_one_scan_loop() {
     this->idle_for(1);
 }
 
+#ifdef MATRIX_SCAN_ASYNC
+void TestFixture::inject_key_event(KeymapKey key, bool pressed, uint32_t time_ms) {
+    ASSERT_GE(time_ms, timer_read32()) << "injected key events can't go back in time";
+    set_time(time_ms);
+    if (pressed) {
+        key.press();
+    } else {
+        key.release();
+    }
+    matrix_scan_async_task();
+}
+#endif
+
 void TestFixture::idle_for(unsigned time) {
     test_logger.trace() << +time << " keyboard task " << (time > 1 ? "loops" : "loop") << std::endl;
     for (unsigned i = 0; i < time; i++) {
@@ -63,6 +63,16 @@ class TestFixture : public testing::Test {
     void run_one_scan_loop();
     void idle_for(unsigned ms);
 
+#ifdef MATRIX_SCAN_ASYNC
+    /**
+     * @brief Has the scanner see `key` pressed or released at exactly `time_ms`, without processing it.
+     *
+     * The clock is moved forward to `time_ms` and the change queued like a background scanner would,
+     * it is processed by the next scan loop however late that runs. Times must not go backwards.
+     */
+    void inject_key_event(KeymapKey key, bool pressed, uint32_t time_ms);
+#endif
+
     void expect_layer_state(layer_t layer) const;
 
    protected:
@@ -0,0 +1,9 @@
+THREADED_TASKS = yes
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+OLED_ENABLE = yes
+OLED_DRIVER = custom
+OLED_TRANSPORT = custom
+
+# The lock is mocked by the test
+OPT_DEFS += -DPLATFORM_SUPPORTS_SYNCHRONIZATION
@@ -0,0 +1,150 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+static int lock_depth      = 0;
+static int flushes         = 0;
+static int flushes_locked  = 0;
+static int displays        = 0;
+static int displays_locked = 0;
+static int display_wakeups = 0;
+static int renders         = 0;
+static int renders_locked  = 0;
+
+static void mock_init(void) {}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void mock_flush(void) {
+    flushes++;
+    if (lock_depth > 0) flushes_locked++;
+}
+
+extern "C" {
+void advance_time(uint32_t ms);
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+    .flush_changed = NULL,
+};
+
+led_config_t g_led_config = {};
+
+// Stands in for the ChibiOS mutex
+void keyboard_state_lock(void) {
+    lock_depth++;
+}
+
+void keyboard_state_unlock(void) {
+    lock_depth--;
+}
+
+// Custom OLED driver, records which thread context draws
+bool oled_init(oled_rotation_t rotation) {
+    return true;
+}
+
+void oled_task(void) {
+    displays++;
+    if (lock_depth > 0) displays_locked++;
+}
+
+void oled_render_dirty(bool all) {
+    renders++;
+    if (lock_depth > 0) renders_locked++;
+}
+
+bool oled_on(void) {
+    display_wakeups++;
+    return true;
+}
+
+bool oled_off(void) {
+    return false;
+}
+}
+
+class ThreadedTasks : public TestFixture {
+   public:
+    void SetUp() override {
+        lock_depth      = 0;
+        flushes         = 0;
+        flushes_locked  = 0;
+        displays        = 0;
+        displays_locked = 0;
+        display_wakeups = 0;
+        renders         = 0;
+        renders_locked  = 0;
+    }
+};
+
+TEST_F(ThreadedTasks, InputThreadDoesNotRender) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(flushes, 0);
+    EXPECT_EQ(displays, 0);
+    EXPECT_EQ(renders, 0);
+    EXPECT_EQ(display_wakeups, 0);
+}
+
+TEST_F(ThreadedTasks, FramesAreDrawnUnderStateLockAndSentWithoutIt) {
+    for (int i = 0; i < 50; i++) {
+        advance_time(1);
+        keyboard_lighting_task();
+    }
+
+    EXPECT_EQ(displays, 50);
+    EXPECT_EQ(displays_locked, displays);
+    EXPECT_GT(flushes, 0);
+    EXPECT_EQ(flushes_locked, 0);
+    EXPECT_EQ(renders, 50);
+    EXPECT_EQ(renders_locked, 0);
+    EXPECT_EQ(lock_depth, 0);
+}
+
+TEST_F(ThreadedTasks, FlushOutsideLightingThreadIsImmediate) {
+    // E.g. the keymap changing the LEDs, or suspend turning them off
+    keyboard_lighting_request_flush(mock_flush);
+    EXPECT_EQ(flushes, 1);
+}
+
+TEST_F(ThreadedTasks, InputActivityWakesDisplayFromLightingThread) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(display_wakeups, 0);
+
+    keyboard_lighting_task();
+    EXPECT_EQ(display_wakeups, OLED_TIMEOUT > 0 ? 1 : 0);
+
+    // Woken up once per activity
+    keyboard_lighting_task();
+    EXPECT_EQ(display_wakeups, OLED_TIMEOUT > 0 ? 1 : 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
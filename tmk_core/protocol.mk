@@ -66,6 +66,14 @@ ifeq ($(strip $(USB_WAIT_FOR_ENUMERATION)), yes)
     OPT_DEFS += -DUSB_WAIT_FOR_ENUMERATION
 endif
 
+ifeq ($(strip $(THREADED_TASKS)), yes)
+    OPT_DEFS += -DTHREADED_TASKS
+endif
+
+ifeq ($(strip $(USB_REPORT_COALESCING)), yes)
+    OPT_DEFS += -DUSB_REPORT_COALESCING
+endif
+
 ifeq ($(strip $(JOYSTICK_SHARED_EP)), yes)
     OPT_DEFS += -DJOYSTICK_SHARED_EP
     SHARED_EP_ENABLE = yes
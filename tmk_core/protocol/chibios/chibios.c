@@ -49,6 +49,10 @@
 #include "suspend.h"
 #include "wait.h"
 
+#ifdef THREADED_TASKS
+#    include "threaded_tasks.h"
+#endif
+
 #define USB_GETSTATUS_REMOTE_WAKEUP_ENABLED (2U)
 
 #ifdef WAIT_FOR_USB
@@ -171,6 +175,10 @@ void protocol_pre_init(void) {
 
 void protocol_post_init(void) {
     host_set_driver(driver);
+
+#ifdef THREADED_TASKS
+    threaded_tasks_init();
+#endif
 }
 
 void protocol_pre_task(void) {
@@ -205,5 +213,11 @@ void protocol_post_task(void) {
 #ifdef VIRTSER_ENABLE
     virtser_task();
 #endif
+#ifndef THREADED_TASKS
+    // Otherwise run by the USB thread
+#    ifdef USB_REPORT_COALESCING
+    usb_report_coalescing_task();
+#    endif
     usb_idle_task();
+#endif
 }
@@ -11,6 +11,14 @@ SRC += $(CHIBIOS_DIR)/usb_report_handling.c
 SRC += $(CHIBIOS_DIR)/usb_util.c
 SRC += $(LIBSRC)
 
+ifeq ($(strip $(THREADED_TASKS)), yes)
+    SRC += $(CHIBIOS_DIR)/threaded_tasks.c
+endif
+
+ifeq ($(strip $(USB_REPORT_COALESCING)), yes)
+    SRC += $(PROTOCOL_DIR)/report_coalescing.c
+endif
+
 VPATH += $(TMK_PATH)/$(PROTOCOL_DIR)
 VPATH += $(TMK_PATH)/$(CHIBIOS_DIR)
 VPATH += $(TMK_PATH)/$(CHIBIOS_DIR)/lufa_utils
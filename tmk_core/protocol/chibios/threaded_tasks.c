@@ -0,0 +1,135 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <string.h>
+
+#include "threaded_tasks.h"
+#include "keyboard.h"
+#include "report.h"
+#include "host_driver.h"
+#include "usb_main.h"
+#include "usb_report_handling.h"
+
+#ifdef THREADED_TASKS
+
+void send_keyboard(report_keyboard_t *report);
+void send_nkro(report_nkro_t *report);
+void send_mouse(report_mouse_t *report);
+void send_extra(report_extra_t *report);
+
+typedef struct {
+    threaded_report_type_t type;
+    union {
+        report_keyboard_t            keyboard;
+        report_nkro_t                nkro;
+        report_mouse_t               mouse;
+        report_extra_t               extra;
+        report_programmable_button_t programmable_button;
+        report_joystick_t            joystick;
+        report_digitizer_t           digitizer;
+    };
+} threaded_report_t;
+
+// Single producer (input thread), single consumer (USB thread)
+static threaded_report_t report_queue[THREADED_TASKS_REPORT_QUEUE_SIZE];
+static uint8_t           report_head = 0;
+static uint8_t           report_tail = 0;
+static SEMAPHORE_DECL(report_free, THREADED_TASKS_REPORT_QUEUE_SIZE);
+static SEMAPHORE_DECL(report_used, 0);
+
+static thread_t *usb_thread = NULL;
+static systime_t input_period;
+
+static THD_WORKING_AREA(usb_thread_wa, THREADED_TASKS_USB_STACK_SIZE);
+static THD_WORKING_AREA(lighting_thread_wa, THREADED_TASKS_LIGHTING_STACK_SIZE);
+
+bool threaded_tasks_post_report(threaded_report_type_t type, const void *report, size_t size) {
+    if (usb_thread == NULL || chThdGetSelfX() == usb_thread) {
+        return false;
+    }
+
+    chSemWait(&report_free);
+    threaded_report_t *entry = &report_queue[report_head];
+    entry->type              = type;
+    memcpy(&entry->keyboard, report, size);
+    report_head = (report_head + 1) % THREADED_TASKS_REPORT_QUEUE_SIZE;
+    chSemSignal(&report_used);
+    return true;
+}
+
+bool threaded_tasks_report_queue_ready(void) {
+    chSysLock();
+    bool ready = chSemGetCounterI(&report_free) > 0;
+    chSysUnlock();
+    return ready;
+}
+
+static void send_queued_report(threaded_report_t *entry) {
+    switch (entry->type) {
+        case THREADED_REPORT_KEYBOARD:
+            send_keyboard(&entry->keyboard);
+            break;
+        case THREADED_REPORT_NKRO:
+            send_nkro(&entry->nkro);
+            break;
+        case THREADED_REPORT_MOUSE:
+            send_mouse(&entry->mouse);
+            break;
+        case THREADED_REPORT_EXTRA:
+            send_extra(&entry->extra);
+            break;
+        case THREADED_REPORT_PROGRAMMABLE_BUTTON:
+            send_programmable_button(&entry->programmable_button);
+            break;
+        case THREADED_REPORT_JOYSTICK:
+            send_joystick(&entry->joystick);
+            break;
+        case THREADED_REPORT_DIGITIZER:
+            send_digitizer(&entry->digitizer);
+            break;
+    }
+}
+
+static THD_FUNCTION(usb_thread_func, arg) {
+    (void)arg;
+    chRegSetThreadName("usb_reports");
+
+    while (true) {
+        // Wake up at least every millisecond for the idle rate and coalescing tasks
+        if (chSemWaitTimeout(&report_used, TIME_MS2I(1)) == MSG_OK) {
+            send_queued_report(&report_queue[report_tail]);
+            report_tail = (report_tail + 1) % THREADED_TASKS_REPORT_QUEUE_SIZE;
+            chSemSignal(&report_free);
+        }
+
+#    ifdef USB_REPORT_COALESCING
+        usb_report_coalescing_task();
+#    endif
+        usb_idle_task();
+    }
+}
+
+static THD_FUNCTION(lighting_thread_func, arg) {
+    (void)arg;
+    chRegSetThreadName("lighting");
+
+    while (true) {
+        keyboard_lighting_task();
+        chThdSleepMilliseconds(THREADED_TASKS_LIGHTING_INTERVAL_MS);
+    }
+}
+
+void threaded_tasks_init(void) {
+    input_period = chVTGetSystemTime();
+    chThdSetPriority(THREADED_TASKS_INPUT_PRIORITY);
+
+    usb_thread = chThdCreateStatic(usb_thread_wa, sizeof(usb_thread_wa), THREADED_TASKS_USB_PRIORITY, usb_thread_func, NULL);
+    chThdCreateStatic(lighting_thread_wa, sizeof(lighting_thread_wa), THREADED_TASKS_LIGHTING_PRIORITY, lighting_thread_func, NULL);
+}
+
+void threaded_tasks_wait(void) {
+    input_period = chThdSleepUntilWindowed(input_period, chTimeAddX(input_period, TIME_US2I(THREADED_TASKS_INPUT_INTERVAL_US)));
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * With THREADED_TASKS the main loop becomes the high priority input thread:
+ * it scans, processes keys and builds the reports at a fixed rate. HID
+ * reports are handed to a USB thread that owns all report endpoints, and
+ * lighting and display tasks run from a low priority thread. Keyboard state
+ * is guarded by keyboard_state_lock(), which the input thread holds for a
+ * whole main loop iteration and the lighting thread while it draws the LED
+ * and display frames into RAM. The frames are sent to the hardware after
+ * the lock is released, and the I2C and SPI drivers serialise the two
+ * threads with their own bus mutex.
+ */
+
+#ifndef THREADED_TASKS_INPUT_INTERVAL_US
+#    define THREADED_TASKS_INPUT_INTERVAL_US 500
+#endif
+
+#ifndef THREADED_TASKS_LIGHTING_INTERVAL_MS
+#    define THREADED_TASKS_LIGHTING_INTERVAL_MS 1
+#endif
+
+#ifndef THREADED_TASKS_REPORT_QUEUE_SIZE
+#    define THREADED_TASKS_REPORT_QUEUE_SIZE 8
+#endif
+
+#ifndef THREADED_TASKS_INPUT_PRIORITY
+#    define THREADED_TASKS_INPUT_PRIORITY (NORMALPRIO + 2)
+#endif
+
+#ifndef THREADED_TASKS_USB_PRIORITY
+#    define THREADED_TASKS_USB_PRIORITY (NORMALPRIO + 1)
+#endif
+
+#ifndef THREADED_TASKS_LIGHTING_PRIORITY
+#    define THREADED_TASKS_LIGHTING_PRIORITY (NORMALPRIO - 1)
+#endif
+
+#ifndef THREADED_TASKS_USB_STACK_SIZE
+#    define THREADED_TASKS_USB_STACK_SIZE 512
+#endif
+
+#ifndef THREADED_TASKS_LIGHTING_STACK_SIZE
+#    define THREADED_TASKS_LIGHTING_STACK_SIZE 1024
+#endif
+
+typedef enum {
+    THREADED_REPORT_KEYBOARD,
+    THREADED_REPORT_NKRO,
+    THREADED_REPORT_MOUSE,
+    THREADED_REPORT_EXTRA,
+    THREADED_REPORT_PROGRAMMABLE_BUTTON,
+    THREADED_REPORT_JOYSTICK,
+    THREADED_REPORT_DIGITIZER,
+} threaded_report_type_t;
+
+/**
+ * \brief Starts the USB and lighting threads and raises the priority of the calling (main) thread.
+ */
+void threaded_tasks_init(void);
+
+/**
+ * \brief Sleeps until the next input period, leaving the CPU to the other threads.
+ */
+void threaded_tasks_wait(void);
+
+/**
+ * \brief Hands a report over to the USB thread, blocking while the queue is full.
+ *
+ * \return false when called from the USB thread itself, which sends reports directly
+ */
+bool threaded_tasks_post_report(threaded_report_type_t type, const void *report, size_t size);
+
+/**
+ * \brief Whether another report can be posted without blocking.
+ */
+bool threaded_tasks_report_queue_ready(void);
@@ -32,6 +32,14 @@
 #include "usb_driver.h"
 #include "usb_types.h"
 
+#ifdef THREADED_TASKS
+#    include "threaded_tasks.h"
+#endif
+
+#ifdef USB_REPORT_COALESCING
+#    include "report_coalescing.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 
@@ -450,18 +458,135 @@ static bool receive_report(usb_endpoint_out_lut_t endpoint, void *report, size_t
     return usb_endpoint_out_receive(&usb_endpoints_out[endpoint], (uint8_t *)report, size, TIME_IMMEDIATE);
 }
 
-void send_keyboard(report_keyboard_t *report) {
+/* ---------------------------------------------------------
+ *                   Report coalescing
+ * ---------------------------------------------------------
+ *
+ * A report is submitted right away if its endpoint is idle. Otherwise it is
+ * held back until the host has polled the previous one, see
+ * report_coalescing.h for when newer reports replace it. As held reports are
+ * only submitted to idle endpoints, sending them never waits for the host.
+ */
+
+#ifdef USB_REPORT_COALESCING
+static usb_report_stats_t usb_report_stats = {0};
+
+static bool submit_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size) {
+    if (!send_report(endpoint, report, size)) {
+        usb_report_stats.dropped++;
+        return false;
+    }
+    usb_report_stats.sent++;
+    return true;
+}
+
+static inline bool endpoint_is_idle(usb_endpoint_in_lut_t endpoint) {
+    return usb_endpoint_in_is_inactive(&usb_endpoints_in[endpoint]);
+}
+
+static void hold_report(report_coalescer_t *coalescer, const void *report) {
+    switch (report_coalescer_push(coalescer, report)) {
+        case REPORT_COALESCING_MERGED:
+            usb_report_stats.merged++;
+            break;
+        case REPORT_COALESCING_DROPPED:
+            usb_report_stats.dropped++;
+            break;
+        default:
+            break;
+    }
+}
+
+usb_report_stats_t usb_get_report_stats(void) {
+    return usb_report_stats;
+}
+#else
+#    define submit_report send_report
+#endif
+
+static void submit_keyboard(report_keyboard_t *report) {
     /* If we're in Boot Protocol, don't send any report ID or other funky fields */
     if (usb_device_state_get_protocol() == USB_PROTOCOL_BOOT) {
-        send_report(USB_ENDPOINT_IN_KEYBOARD, &report->mods, 8);
+        submit_report(USB_ENDPOINT_IN_KEYBOARD, &report->mods, 8);
     } else {
-        send_report(USB_ENDPOINT_IN_KEYBOARD, report, KEYBOARD_REPORT_SIZE);
+        submit_report(USB_ENDPOINT_IN_KEYBOARD, report, KEYBOARD_REPORT_SIZE);
+    }
+}
+
+#ifdef USB_REPORT_COALESCING
+REPORT_COALESCER(keyboard_coalescer, report_keyboard_t, keyboard_report_merge);
+
+static void flush_keyboard(void) {
+    report_keyboard_t *report = report_coalescer_peek(&keyboard_coalescer);
+    if (report != NULL && endpoint_is_idle(USB_ENDPOINT_IN_KEYBOARD)) {
+        submit_keyboard(report);
+        report_coalescer_pop(&keyboard_coalescer);
+    }
+}
+#endif
+
+void send_keyboard(report_keyboard_t *report) {
+#ifdef THREADED_TASKS
+    if (threaded_tasks_post_report(THREADED_REPORT_KEYBOARD, report, sizeof(report_keyboard_t))) {
+        return;
+    }
+#endif
+#ifdef USB_REPORT_COALESCING
+    hold_report(&keyboard_coalescer, report);
+    flush_keyboard();
+#else
+    submit_keyboard(report);
+#endif
+}
+
+#if defined(NKRO_ENABLE) && defined(USB_REPORT_COALESCING)
+REPORT_COALESCER(nkro_coalescer, report_nkro_t, nkro_report_merge);
+
+static void flush_nkro(void) {
+    report_nkro_t *report = report_coalescer_peek(&nkro_coalescer);
+    if (report != NULL && endpoint_is_idle(USB_ENDPOINT_IN_SHARED)) {
+        submit_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
+        report_coalescer_pop(&nkro_coalescer);
+    }
+}
+#endif
+
+bool keyboard_report_ready(void) {
+#ifdef THREADED_TASKS
+    // Reports are only queued here, the USB thread waits for the endpoints
+    return threaded_tasks_report_queue_ready();
+#endif
+#ifdef NKRO_ENABLE
+    if (usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro) {
+#    ifdef USB_REPORT_COALESCING
+        if (!report_coalescer_is_empty(&nkro_coalescer)) {
+            return false;
+        }
+#    endif
+        return !usb_endpoint_in_is_full(&usb_endpoints_in[USB_ENDPOINT_IN_SHARED]);
+    }
+#endif
+#ifdef USB_REPORT_COALESCING
+    if (!report_coalescer_is_empty(&keyboard_coalescer)) {
+        return false;
     }
+#endif
+    return !usb_endpoint_in_is_full(&usb_endpoints_in[USB_ENDPOINT_IN_KEYBOARD]);
 }
 
 void send_nkro(report_nkro_t *report) {
+#ifdef THREADED_TASKS
+    if (threaded_tasks_post_report(THREADED_REPORT_NKRO, report, sizeof(report_nkro_t))) {
+        return;
+    }
+#endif
 #ifdef NKRO_ENABLE
-    send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
+#    ifdef USB_REPORT_COALESCING
+    hold_report(&nkro_coalescer, report);
+    flush_nkro();
+#    else
+    submit_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
+#    endif
 #endif
 }
 
@@ -470,36 +595,90 @@ void send_nkro(report_nkro_t *report) {
  * ---------------------------------------------------------
  */
 
+#if defined(MOUSE_ENABLE) && defined(USB_REPORT_COALESCING)
+REPORT_COALESCER(mouse_coalescer, report_mouse_t, mouse_report_merge);
+
+static void flush_mouse(void) {
+    report_mouse_t *report = report_coalescer_peek(&mouse_coalescer);
+    if (report != NULL && endpoint_is_idle(USB_ENDPOINT_IN_MOUSE)) {
+        submit_report(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+        report_coalescer_pop(&mouse_coalescer);
+    }
+}
+#endif
+
 void send_mouse(report_mouse_t *report) {
+#ifdef THREADED_TASKS
+    if (threaded_tasks_post_report(THREADED_REPORT_MOUSE, report, sizeof(report_mouse_t))) {
+        return;
+    }
+#endif
 #ifdef MOUSE_ENABLE
-    send_report(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+#    ifdef USB_REPORT_COALESCING
+    hold_report(&mouse_coalescer, report);
+    flush_mouse();
+#    else
+    submit_report(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+#    endif
 #endif
 }
 
+#ifdef USB_REPORT_COALESCING
+void usb_report_coalescing_task(void) {
+    flush_keyboard();
+#    ifdef NKRO_ENABLE
+    flush_nkro();
+#    endif
+#    ifdef MOUSE_ENABLE
+    flush_mouse();
+#    endif
+}
+#endif
+
 /* ---------------------------------------------------------
  *                   Extrakey functions
  * ---------------------------------------------------------
  */
 
 void send_extra(report_extra_t *report) {
+#ifdef THREADED_TASKS
+    if (threaded_tasks_post_report(THREADED_REPORT_EXTRA, report, sizeof(report_extra_t))) {
+        return;
+    }
+#endif
 #ifdef EXTRAKEY_ENABLE
     send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_extra_t));
 #endif
 }
 
 void send_programmable_button(report_programmable_button_t *report) {
+#ifdef THREADED_TASKS
+    if (threaded_tasks_post_report(THREADED_REPORT_PROGRAMMABLE_BUTTON, report, sizeof(report_programmable_button_t))) {
+        return;
+    }
+#endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
     send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_programmable_button_t));
 #endif
 }
 
 void send_joystick(report_joystick_t *report) {
+#ifdef THREADED_TASKS
+    if (threaded_tasks_post_report(THREADED_REPORT_JOYSTICK, report, sizeof(report_joystick_t))) {
+        return;
+    }
+#endif
 #ifdef JOYSTICK_ENABLE
     send_report(USB_ENDPOINT_IN_JOYSTICK, report, sizeof(report_joystick_t));
 #endif
 }
 
 void send_digitizer(report_digitizer_t *report) {
+#ifdef THREADED_TASKS
+    if (threaded_tasks_post_report(THREADED_REPORT_DIGITIZER, report, sizeof(report_digitizer_t))) {
+        return;
+    }
+#endif
 #ifdef DIGITIZER_ENABLE
     send_report(USB_ENDPOINT_IN_DIGITIZER, report, sizeof(report_digitizer_t));
 #endif
@@ -34,6 +34,26 @@ void restart_usb_driver(USBDriver *usbp);
 
 bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size);
 
+/* -----------------
+ * Report coalescing
+ * -----------------
+ */
+
+#ifdef USB_REPORT_COALESCING
+
+typedef struct {
+    uint32_t sent;    // reports handed to the endpoints
+    uint32_t merged;  // reports replaced by a newer one before the host polled them
+    uint32_t dropped; // reports the endpoints didn't accept, e.g. while disconnected, or that had no room to be held
+} usb_report_stats_t;
+
+/* Submit the held back reports whose endpoints have become idle */
+void usb_report_coalescing_task(void);
+
+usb_report_stats_t usb_get_report_stats(void);
+
+#endif
+
 /* ---------------
  * USB Event queue
  * ---------------
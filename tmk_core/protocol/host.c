@@ -95,6 +95,22 @@ void host_keyboard_send(report_keyboard_t *report) {
     }
 }
 
+/* whether another keyboard report can be sent without waiting */
+bool host_keyboard_ready(void) {
+#ifdef BLUETOOTH_ENABLE
+    if (where_to_send() == OUTPUT_BLUETOOTH) {
+        return true;
+    }
+#endif
+
+    if (!driver) return false;
+    return keyboard_report_ready();
+}
+
+__attribute__((weak)) bool keyboard_report_ready(void) {
+    return true;
+}
+
 void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
@@ -0,0 +1,168 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "report_coalescing.h"
+
+static inline uint8_t *held_report(report_coalescer_t *coalescer, uint8_t index) {
+    return &coalescer->held[((coalescer->head + index) % coalescer->depth) * coalescer->size];
+}
+
+report_coalescing_result_t report_coalescer_push(report_coalescer_t *coalescer, const void *report) {
+    if (coalescer->count > 0) {
+        const uint8_t *previous = coalescer->count > 1 ? held_report(coalescer, coalescer->count - 2) : coalescer->previous;
+        if (coalescer->merge(previous, held_report(coalescer, coalescer->count - 1), report)) {
+            return REPORT_COALESCING_MERGED;
+        }
+    }
+
+    report_coalescing_result_t result = REPORT_COALESCING_HELD;
+    if (coalescer->count == coalescer->depth) {
+        // The host isn't polling, keep the latest state
+        report_coalescer_pop(coalescer);
+        result = REPORT_COALESCING_DROPPED;
+    }
+    memcpy(held_report(coalescer, coalescer->count), report, coalescer->size);
+    coalescer->count++;
+    return result;
+}
+
+void *report_coalescer_peek(report_coalescer_t *coalescer) {
+    return coalescer->count > 0 ? held_report(coalescer, 0) : NULL;
+}
+
+void report_coalescer_pop(report_coalescer_t *coalescer) {
+    if (coalescer->count == 0) {
+        return;
+    }
+    memcpy(coalescer->previous, held_report(coalescer, 0), coalescer->size);
+    coalescer->head = (coalescer->head + 1) % coalescer->depth;
+    coalescer->count--;
+}
+
+/* Whether any bit changed from `previous` to `held` and changes back in `next` */
+static bool bits_would_be_lost(const uint8_t *previous, const uint8_t *held, const uint8_t *next, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if ((previous[i] ^ held[i]) & (held[i] ^ next[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool keyboard_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool keyboard_report_merge(const void *previous_report, void *held_report, const void *next_report) {
+    const report_keyboard_t *previous = previous_report;
+    report_keyboard_t       *held     = held_report;
+    const report_keyboard_t *next     = next_report;
+
+    if (bits_would_be_lost(&previous->mods, &held->mods, &next->mods, 1)) {
+        return false;
+    }
+
+    bool held_presses = false, next_presses = false;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = held->keys[i];
+        if (key != KC_NO && !keyboard_has_key(previous, key)) {
+            held_presses = true;
+            // Pressed while held back, released again
+            if (!keyboard_has_key(next, key)) {
+                return false;
+            }
+            // Pressed while held back, and the modifiers change under it
+            if (held->mods != next->mods) {
+                return false;
+            }
+        }
+        if (next->keys[i] != KC_NO && !keyboard_has_key(held, next->keys[i])) {
+            next_presses = true;
+        }
+        // Released while held back, pressed again
+        key = previous->keys[i];
+        if (key != KC_NO && !keyboard_has_key(held, key) && keyboard_has_key(next, key)) {
+            return false;
+        }
+    }
+    // Two presses in one report, the host can't tell which came first
+    if (held_presses && next_presses) {
+        return false;
+    }
+
+    memcpy(held, next, sizeof(report_keyboard_t));
+    return true;
+}
+
+bool nkro_report_merge(const void *previous_report, void *held_report, const void *next_report) {
+    const report_nkro_t *previous = previous_report;
+    report_nkro_t       *held     = held_report;
+    const report_nkro_t *next     = next_report;
+
+    if (bits_would_be_lost(&previous->mods, &held->mods, &next->mods, 1) || bits_would_be_lost(previous->bits, held->bits, next->bits, sizeof(next->bits))) {
+        return false;
+    }
+
+    bool held_presses = false, next_presses = false;
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        held_presses |= (held->bits[i] & ~previous->bits[i]) != 0;
+        next_presses |= (next->bits[i] & ~held->bits[i]) != 0;
+    }
+    // Pressed while held back, and the modifiers change under it or another key is pressed,
+    // which the host would order by usage instead of by time
+    if (held_presses && (held->mods != next->mods || next_presses)) {
+        return false;
+    }
+
+    memcpy(held, next, sizeof(report_nkro_t));
+    return true;
+}
+
+#ifdef MOUSE_EXTENDED_REPORT
+#    define MOUSE_XY_MIN INT16_MIN
+#    define MOUSE_XY_MAX INT16_MAX
+#else
+#    define MOUSE_XY_MIN INT8_MIN
+#    define MOUSE_XY_MAX INT8_MAX
+#endif
+#ifdef WHEEL_EXTENDED_REPORT
+#    define MOUSE_HV_MIN INT16_MIN
+#    define MOUSE_HV_MAX INT16_MAX
+#else
+#    define MOUSE_HV_MIN INT8_MIN
+#    define MOUSE_HV_MAX INT8_MAX
+#endif
+
+static inline bool mouse_sum_fits(int32_t a, int32_t b, int32_t min, int32_t max) {
+    return a + b >= min && a + b <= max;
+}
+
+/* Motion is relative, so merging means adding up the deltas. Button changes can't be merged. */
+bool mouse_report_merge(const void *previous_report, void *held_report, const void *next_report) {
+    report_mouse_t       *held = held_report;
+    const report_mouse_t *next = next_report;
+
+    if (held->buttons != next->buttons) {
+        return false;
+    }
+    if (!mouse_sum_fits(held->x, next->x, MOUSE_XY_MIN, MOUSE_XY_MAX) || !mouse_sum_fits(held->y, next->y, MOUSE_XY_MIN, MOUSE_XY_MAX) || !mouse_sum_fits(held->v, next->v, MOUSE_HV_MIN, MOUSE_HV_MAX) || !mouse_sum_fits(held->h, next->h, MOUSE_HV_MIN, MOUSE_HV_MAX)) {
+        return false;
+    }
+
+    held->x += next->x;
+    held->y += next->y;
+    held->v += next->v;
+    held->h += next->h;
+#ifdef MOUSE_EXTENDED_REPORT
+    // clip and copy to Boot protocol XY
+    held->boot_x = (held->x > 127) ? 127 : ((held->x < -127) ? -127 : held->x);
+    held->boot_y = (held->y > 127) ? 127 : ((held->y < -127) ? -127 : held->y);
+#endif
+    return true;
+}
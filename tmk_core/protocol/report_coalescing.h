@@ -0,0 +1,71 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "report.h"
+
+/**
+ * \file
+ *
+ * Holds reports back while their endpoint is busy. Reports are kept in
+ * order, and a new report only replaces the newest held one when the host
+ * wouldn't be able to tell: no key or modifier may change and change back,
+ * the modifiers may not change while a key press is still held back, as
+ * that would apply them to the key, and no other key may be pressed, as the
+ * order of two presses in one report is lost. Reports that can't be merged are
+ * queued behind it, so the protocol never has to wait for the endpoint.
+ */
+
+#ifndef USB_REPORT_COALESCING_DEPTH
+#    define USB_REPORT_COALESCING_DEPTH 4
+#endif
+
+/* Merges `next` into `held`, which the host will see right after `previous`. Returns false if it can't. */
+typedef bool (*report_merge_t)(const void *previous, void *held, const void *next);
+
+typedef struct {
+    uint8_t       *held;     // `depth` reports of `size` bytes
+    uint8_t       *previous; // the last report taken out
+    size_t         size;
+    uint8_t        depth;
+    uint8_t        head;
+    uint8_t        count;
+    report_merge_t merge;
+} report_coalescer_t;
+
+typedef enum {
+    REPORT_COALESCING_HELD,    // queued behind the held reports
+    REPORT_COALESCING_MERGED,  // replaced the newest held report
+    REPORT_COALESCING_DROPPED, // queued, but the oldest held report had to make room
+} report_coalescing_result_t;
+
+#define REPORT_COALESCER(name, type, merge_fn)                       \
+    static type               name##_held[USB_REPORT_COALESCING_DEPTH]; \
+    static type               name##_previous;                        \
+    static report_coalescer_t name = {                                \
+        .held     = (uint8_t *)name##_held,                           \
+        .previous = (uint8_t *)&name##_previous,                      \
+        .size     = sizeof(type),                                     \
+        .depth    = USB_REPORT_COALESCING_DEPTH,                      \
+        .merge    = merge_fn,                                         \
+    }
+
+report_coalescing_result_t report_coalescer_push(report_coalescer_t *coalescer, const void *report);
+
+/* The oldest held report, or NULL */
+void *report_coalescer_peek(report_coalescer_t *coalescer);
+
+/* Takes out the oldest held report once it has been submitted */
+void report_coalescer_pop(report_coalescer_t *coalescer);
+
+static inline bool report_coalescer_is_empty(const report_coalescer_t *coalescer) {
+    return coalescer->count == 0;
+}
+
+bool keyboard_report_merge(const void *previous, void *held, const void *next);
+bool nkro_report_merge(const void *previous, void *held, const void *next);
+bool mouse_report_merge(const void *previous, void *held, const void *next);
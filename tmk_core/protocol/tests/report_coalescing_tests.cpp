@@ -0,0 +1,225 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <initializer_list>
+#include <vector>
+
+extern "C" {
+#include "report_coalescing.h"
+}
+
+namespace {
+
+report_keyboard_t keyboard(uint8_t mods, std::initializer_list<uint8_t> keys) {
+    report_keyboard_t report = {};
+    report.mods              = mods;
+    uint8_t i                = 0;
+    for (uint8_t key : keys) {
+        report.keys[i++] = key;
+    }
+    return report;
+}
+
+report_nkro_t nkro(uint8_t mods, std::initializer_list<uint8_t> keys) {
+    report_nkro_t report = {};
+    report.mods          = mods;
+    for (uint8_t key : keys) {
+        report.bits[key / 8] |= 1 << (key % 8);
+    }
+    return report;
+}
+
+report_mouse_t mouse(uint8_t buttons, int x, int y) {
+    report_mouse_t report = {};
+    report.buttons        = buttons;
+    report.x              = x;
+    report.y              = y;
+    return report;
+}
+
+template <typename T>
+bool operator==(const T &a, const T &b) {
+    return memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+} // namespace
+
+class ReportCoalescing : public ::testing::Test {
+   protected:
+    report_keyboard_t  keyboard_held[USB_REPORT_COALESCING_DEPTH];
+    report_keyboard_t  keyboard_previous;
+    report_coalescer_t keyboard_coalescer;
+    report_nkro_t      nkro_held[USB_REPORT_COALESCING_DEPTH];
+    report_nkro_t      nkro_previous;
+    report_coalescer_t nkro_coalescer;
+    report_mouse_t     mouse_held[USB_REPORT_COALESCING_DEPTH];
+    report_mouse_t     mouse_previous;
+    report_coalescer_t mouse_coalescer;
+
+    void SetUp() override {
+        keyboard_previous  = {};
+        keyboard_coalescer = {(uint8_t *)keyboard_held, (uint8_t *)&keyboard_previous, sizeof(report_keyboard_t), USB_REPORT_COALESCING_DEPTH, 0, 0, keyboard_report_merge};
+        nkro_previous      = {};
+        nkro_coalescer     = {(uint8_t *)nkro_held, (uint8_t *)&nkro_previous, sizeof(report_nkro_t), USB_REPORT_COALESCING_DEPTH, 0, 0, nkro_report_merge};
+        mouse_previous     = {};
+        mouse_coalescer    = {(uint8_t *)mouse_held, (uint8_t *)&mouse_previous, sizeof(report_mouse_t), USB_REPORT_COALESCING_DEPTH, 0, 0, mouse_report_merge};
+    }
+
+    // What the host would receive, one report per poll
+    template <typename T>
+    std::vector<T> drain(report_coalescer_t &coalescer) {
+        std::vector<T> polled;
+        while (T *report = (T *)report_coalescer_peek(&coalescer)) {
+            polled.push_back(*report);
+            report_coalescer_pop(&coalescer);
+        }
+        return polled;
+    }
+};
+
+TEST_F(ReportCoalescing, KeyboardReportsMergeWhenNoTransitionIsLost) {
+    report_keyboard_t a = keyboard(0, {KC_A}), ab = keyboard(0, {KC_A, KC_B}), b = keyboard(0, {KC_B});
+    report_coalescer_push(&keyboard_coalescer, &a);
+    report_coalescer_pop(&keyboard_coalescer);
+
+    // B pressed while held back, then A released
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &ab), REPORT_COALESCING_HELD);
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &b), REPORT_COALESCING_MERGED);
+
+    auto polled = drain<report_keyboard_t>(keyboard_coalescer);
+    ASSERT_EQ(polled.size(), 1u);
+    EXPECT_TRUE(polled[0] == b);
+}
+
+TEST_F(ReportCoalescing, KeyboardPressOrderIsKept) {
+    report_keyboard_t a = keyboard(0, {KC_A}), ab = keyboard(0, {KC_A, KC_B});
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &a), REPORT_COALESCING_HELD);
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &ab), REPORT_COALESCING_HELD);
+
+    auto polled = drain<report_keyboard_t>(keyboard_coalescer);
+    ASSERT_EQ(polled.size(), 2u);
+    EXPECT_TRUE(polled[0] == a);
+    EXPECT_TRUE(polled[1] == ab);
+}
+
+TEST_F(ReportCoalescing, KeyboardTapIsNotMergedAway) {
+    report_keyboard_t a = keyboard(0, {KC_A}), none = keyboard(0, {});
+    report_coalescer_push(&keyboard_coalescer, &a);
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &none), REPORT_COALESCING_HELD);
+
+    auto polled = drain<report_keyboard_t>(keyboard_coalescer);
+    ASSERT_EQ(polled.size(), 2u);
+    EXPECT_TRUE(polled[0] == a);
+    EXPECT_TRUE(polled[1] == none);
+}
+
+TEST_F(ReportCoalescing, KeyboardModifierPressedAfterHeldKeyIsNotMerged) {
+    // A then shift must not turn into a shifted A
+    report_keyboard_t a = keyboard(0, {KC_A}), shift_a = keyboard(MOD_BIT(KC_LEFT_SHIFT), {KC_A});
+    report_coalescer_push(&keyboard_coalescer, &a);
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &shift_a), REPORT_COALESCING_HELD);
+
+    auto polled = drain<report_keyboard_t>(keyboard_coalescer);
+    ASSERT_EQ(polled.size(), 2u);
+    EXPECT_TRUE(polled[0] == a);
+    EXPECT_TRUE(polled[1] == shift_a);
+}
+
+TEST_F(ReportCoalescing, KeyboardModifierReleasedAfterHeldKeyIsNotMerged) {
+    report_keyboard_t shift = keyboard(MOD_BIT(KC_LEFT_SHIFT), {}), shift_a = keyboard(MOD_BIT(KC_LEFT_SHIFT), {KC_A}), a = keyboard(0, {KC_A});
+    report_coalescer_push(&keyboard_coalescer, &shift);
+    report_coalescer_pop(&keyboard_coalescer);
+
+    report_coalescer_push(&keyboard_coalescer, &shift_a);
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &a), REPORT_COALESCING_HELD);
+}
+
+TEST_F(ReportCoalescing, KeyboardModifierChangeWithoutHeldPressIsMerged) {
+    // Shift then A is a shifted A either way
+    report_keyboard_t shift = keyboard(MOD_BIT(KC_LEFT_SHIFT), {}), shift_a = keyboard(MOD_BIT(KC_LEFT_SHIFT), {KC_A});
+    report_keyboard_t a = keyboard(0, {KC_A}), ctrl_a = keyboard(MOD_BIT(KC_LEFT_CTRL), {KC_A});
+    report_coalescer_push(&keyboard_coalescer, &shift);
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &shift_a), REPORT_COALESCING_MERGED);
+
+    // A already sent, only the modifiers change
+    drain<report_keyboard_t>(keyboard_coalescer);
+    report_coalescer_push(&keyboard_coalescer, &a);
+    report_coalescer_pop(&keyboard_coalescer);
+    report_coalescer_push(&keyboard_coalescer, &ctrl_a);
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &ctrl_a), REPORT_COALESCING_MERGED);
+}
+
+TEST_F(ReportCoalescing, MergesOnlyIntoNewestHeldReport) {
+    report_keyboard_t a = keyboard(0, {KC_A}), none = keyboard(0, {}), b = keyboard(0, {KC_B});
+    report_coalescer_push(&keyboard_coalescer, &a);
+    report_coalescer_push(&keyboard_coalescer, &none);
+    // Releasing A and pressing B can go together
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &b), REPORT_COALESCING_MERGED);
+    // Compared against the held report before it, B was pressed while held back
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &none), REPORT_COALESCING_HELD);
+
+    auto polled = drain<report_keyboard_t>(keyboard_coalescer);
+    ASSERT_EQ(polled.size(), 3u);
+    EXPECT_TRUE(polled[0] == a);
+    EXPECT_TRUE(polled[1] == b);
+    EXPECT_TRUE(polled[2] == none);
+}
+
+TEST_F(ReportCoalescing, FullQueueDropsOldestAndKeepsLatestState) {
+    report_keyboard_t a = keyboard(0, {KC_A}), none = keyboard(0, {});
+    for (int i = 0; i < USB_REPORT_COALESCING_DEPTH; i++) {
+        EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, i % 2 ? &none : &a), REPORT_COALESCING_HELD);
+    }
+    EXPECT_EQ(report_coalescer_push(&keyboard_coalescer, &a), REPORT_COALESCING_DROPPED);
+
+    auto polled = drain<report_keyboard_t>(keyboard_coalescer);
+    ASSERT_EQ(polled.size(), (size_t)USB_REPORT_COALESCING_DEPTH);
+    EXPECT_TRUE(polled.back() == a);
+}
+
+TEST_F(ReportCoalescing, NkroModifierChangeAfterHeldKeyIsNotMerged) {
+    report_nkro_t a = nkro(0, {KC_A}), shift_a = nkro(MOD_BIT(KC_LEFT_SHIFT), {KC_A}), none = nkro(0, {});
+    report_coalescer_push(&nkro_coalescer, &a);
+    EXPECT_EQ(report_coalescer_push(&nkro_coalescer, &a), REPORT_COALESCING_MERGED);
+    EXPECT_EQ(report_coalescer_push(&nkro_coalescer, &shift_a), REPORT_COALESCING_HELD);
+    EXPECT_EQ(report_coalescer_push(&nkro_coalescer, &none), REPORT_COALESCING_HELD);
+
+    auto polled = drain<report_nkro_t>(nkro_coalescer);
+    ASSERT_EQ(polled.size(), 3u);
+    EXPECT_TRUE(polled[0] == a);
+    EXPECT_TRUE(polled[1] == shift_a);
+    EXPECT_TRUE(polled[2] == none);
+}
+
+TEST_F(ReportCoalescing, NkroPressOrderIsKept) {
+    // In one bitmap the host would see A before B, as it orders them by usage
+    report_nkro_t b = nkro(0, {KC_B}), ab = nkro(0, {KC_A, KC_B});
+    report_coalescer_push(&nkro_coalescer, &b);
+    EXPECT_EQ(report_coalescer_push(&nkro_coalescer, &ab), REPORT_COALESCING_HELD);
+
+    auto polled = drain<report_nkro_t>(nkro_coalescer);
+    ASSERT_EQ(polled.size(), 2u);
+    EXPECT_TRUE(polled[0] == b);
+    EXPECT_TRUE(polled[1] == ab);
+}
+
+TEST_F(ReportCoalescing, MouseMotionIsAddedUp) {
+    report_mouse_t first = mouse(0, 10, -5), second = mouse(0, 20, -5), click = mouse(1, 1, 0);
+    report_coalescer_push(&mouse_coalescer, &first);
+    EXPECT_EQ(report_coalescer_push(&mouse_coalescer, &second), REPORT_COALESCING_MERGED);
+    EXPECT_EQ(report_coalescer_push(&mouse_coalescer, &click), REPORT_COALESCING_HELD);
+
+    auto polled = drain<report_mouse_t>(mouse_coalescer);
+    ASSERT_EQ(polled.size(), 2u);
+    EXPECT_EQ(polled[0].x, 30);
+    EXPECT_EQ(polled[0].y, -10);
+    EXPECT_EQ(polled[1].buttons, 1);
+}
+
+TEST_F(ReportCoalescing, MouseMotionThatDoesNotFitIsQueued) {
+    report_mouse_t fast = mouse(0, 100, 0);
+    report_coalescer_push(&mouse_coalescer, &fast);
+    EXPECT_EQ(report_coalescer_push(&mouse_coalescer, &fast), REPORT_COALESCING_HELD);
+    EXPECT_EQ(drain<report_mouse_t>(mouse_coalescer).size(), 2u);
+}
@@ -0,0 +1,5 @@
+report_coalescing_DEFS := -DUSB_REPORT_COALESCING_DEPTH=4
+
+report_coalescing_SRC := \
+	$(TMK_PATH)/protocol/report_coalescing.c \
+	$(TMK_PATH)/protocol/tests/report_coalescing_tests.cpp